@@ -53,9 +53,13 @@ bool FDotNetNativeBinderModule::ShouldExportClassesForModule(const FString& Modu
                                                              EBuildModuleType::Type ModuleType,
                                                              const FString& ModuleGeneratedIncludeDirectory) const
 {
-	if (!IsGame(ModuleType) && ModuleName != "Engine" && ModuleName != "CoreUObject")
+	if (!Settings.ShouldExportModule(ModuleName, IsGame(ModuleType)))
+	{
+		Stats.SkippedModules++;
 		return false;
-	
+	}
+
+	Stats.ExportedModules++;
 	Collector.SetPackageType(ModuleName, ModuleType);
 	return true;
 }
@@ -64,12 +68,24 @@ bool FDotNetNativeBinderModule::ShouldExportClassesForModule(const FString& Modu
 void FDotNetNativeBinderModule::ExportClass(UClass* Class, const FString& SourceHeaderFilename,
                                             const FString& GeneratedHeaderFilename, bool bHasChanged)
 {
-	Collector.TouchClass(Class);
+	if (!Settings.ShouldExportType(FPackageName::GetShortName(Class->GetOutermost()), Class->GetName()))
+	{
+		Stats.SkippedClasses++;
+		return;
+	}
+
+	Stats.ExportedClasses++;
+	Collector.ExportClass(Class);
 }
 
 void FDotNetNativeBinderModule::FinishExport()
 {
-	Collector.ExportAllTypes(OutputPath);
+	UE_LOG(LogDotNetGenerator, Display,
+	       TEXT("Exporting %d of %d modules and %d of %d classes, the rest were excluded by the generation settings."),
+	       Stats.ExportedModules, Stats.ExportedModules + Stats.SkippedModules, Stats.ExportedClasses,
+	       Stats.ExportedClasses + Stats.SkippedClasses);
+
+	Collector.ExportAllTypes(OutputPath, Settings.MetadataFormat);
 }
 
 FString FDotNetNativeBinderModule::GetGeneratorName() const
@@ -0,0 +1,111 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "ExportManifest.h"
+
+#include "DotNetNativeBinder.h"
+#include "Json.h"
+#include "Misc/SecureHash.h"
+
+//==============================================================================
+//= Manifest
+
+static FString GetManifestPath(const FString& Destination, const FString& Module)
+{
+	return FPaths::Combine(Destination, Module + FExportManifest::Extension);
+}
+
+void FExportManifest::Load(const FString& Destination, const FString& Module)
+{
+	Files.Reset();
+
+	FString Contents;
+	if (!FFileHelper::LoadFileToString(Contents, *GetManifestPath(Destination, Module)))
+		return;
+
+	TSharedPtr<FJsonObject> Object;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Contents), Object) || !Object)
+		return;
+
+	int32 FileVersion = 0;
+	if (!Object->TryGetNumberField(TEXT("Version"), FileVersion) || FileVersion != Version)
+		return;
+
+	const TSharedPtr<FJsonObject>* FilesObject;
+	if (!Object->TryGetObjectField(TEXT("Files"), FilesObject))
+		return;
+
+	for (const auto& Pair : (*FilesObject)->Values)
+		Files.Add(Pair.Key, Pair.Value->AsString());
+}
+
+void FExportManifest::Save(const FString& Destination, const FString& Module) const
+{
+	auto FilesObject = MakeShared<FJsonObject>();
+	for (const auto& Pair : Files)
+		FilesObject->SetStringField(Pair.Key, Pair.Value);
+
+	auto Object = MakeShared<FJsonObject>();
+	Object->SetNumberField(TEXT("Version"), Version);
+	Object->SetObjectField(TEXT("Files"), FilesObject);
+
+	FString Contents;
+	const auto Writer = TJsonWriterFactory<>::Create(&Contents);
+	FJsonSerializer::Serialize(Object, Writer);
+	Writer->Close();
+
+	const auto Path = GetManifestPath(Destination, Module);
+	if (!FFileHelper::SaveStringToFile(Contents, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogDotNetGenerator, Error, TEXT("Could not write manifest %s"), *Path);
+	}
+}
+
+FString FExportManifest::HashContents(const TArray<uint8>& Contents)
+{
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Contents.GetData(), Contents.Num(), Hash.Hash);
+	return Hash.ToString();
+}
+
+//==============================================================================
+//= Incremental Export
+
+FIncrementalExport::FIncrementalExport(FString Destination, FString Module)
+	: Destination(MoveTemp(Destination)), Module(MoveTemp(Module))
+{
+	Previous.Load(this->Destination, this->Module);
+}
+
+bool FIncrementalExport::IsUnchanged(const FString& RelativePath, const FString& Hash) const
+{
+	const auto PreviousHash = Previous.Files.Find(RelativePath);
+	return PreviousHash && *PreviousHash == Hash && FPaths::FileExists(FPaths::Combine(Destination, RelativePath));
+}
+
+void FIncrementalExport::Record(const FString& RelativePath, FString Hash, const bool bWritten)
+{
+	if (bWritten)
+		Written++;
+	else
+		Unchanged++;
+
+	Current.Files.Add(RelativePath, MoveTemp(Hash));
+}
+
+void FIncrementalExport::Finish()
+{
+	auto& File = IPlatformFile::GetPlatformPhysical();
+
+	for (const auto& Pair : Previous.Files)
+	{
+		if (Current.Files.Contains(Pair.Key))
+			continue;
+
+		File.DeleteFile(*FPaths::Combine(Destination, Pair.Key));
+		Removed++;
+	}
+
+	if (Removed > 0 || Written > 0 || Previous.Files.Num() != Current.Files.Num())
+		Current.Save(Destination, Module);
+}
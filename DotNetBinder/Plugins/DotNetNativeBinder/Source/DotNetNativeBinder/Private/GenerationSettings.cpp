@@ -8,22 +8,199 @@
 
 typedef CSimpleIniTempl<TCHAR, SI_Case<TCHAR>, SI_ConvertW<TCHAR>> CSimpleIniTChar;
 
+static const TCHAR* GenerationSection = TEXT("Generation");
+static const TCHAR* ModuleSectionPrefix = TEXT("Generation.Module.");
+
+// Engine modules exported when no rules are configured.
+static const TCHAR* DefaultEngineModules = TEXT("CoreUObject, Engine");
+
+//==============================================================================
+//= Name Patterns
+
+static FString GlobToRegex(const FString& Glob)
+{
+	FString Regex = TEXT("^");
+
+	for (const auto Char : Glob)
+	{
+		switch (Char)
+		{
+		case TEXT('*'):
+			Regex += TEXT(".*");
+			break;
+		case TEXT('?'):
+			Regex += TEXT(".");
+			break;
+		case TEXT('.'):
+		case TEXT('^'):
+		case TEXT('$'):
+		case TEXT('+'):
+		case TEXT('('):
+		case TEXT(')'):
+		case TEXT('['):
+		case TEXT(']'):
+		case TEXT('{'):
+		case TEXT('}'):
+		case TEXT('|'):
+		case TEXT('\\'):
+			Regex += TEXT('\\');
+			// Fall through.
+		default:
+			Regex += Char;
+		}
+	}
+
+	return Regex + TEXT("$");
+}
+
+/**
+ * Find the comma that ends the rule starting at an index, or the end of the line. Regular expressions may contain
+ * commas, they only end at a slash followed by a comma or the end of the line.
+ */
+static int32 FindRuleEnd(const FString& Line, const int32 Start)
+{
+	int32 Index = Start;
+	while (Index < Line.Len()
+		&& (FChar::IsWhitespace(Line[Index]) || Line[Index] == TEXT('-') || Line[Index] == TEXT('+')))
+		++Index;
+
+	if (Index < Line.Len() && Line[Index] == TEXT('/'))
+	{
+		for (int32 Slash = Index + 1; Slash < Line.Len(); ++Slash)
+		{
+			if (Line[Slash] != TEXT('/'))
+				continue;
+
+			int32 Next = Slash + 1;
+			while (Next < Line.Len() && FChar::IsWhitespace(Line[Next]))
+				++Next;
+
+			if (Next == Line.Len() || Line[Next] == TEXT(','))
+				return Next;
+		}
+	}
+
+	const int32 Comma = Line.Find(TEXT(","), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+	return Comma == INDEX_NONE ? Line.Len() : Comma;
+}
+
+FNamePattern::FNamePattern(const FString& Regex, const EPatternType Type)
+	: Pattern(Regex), Type(Type)
+{
+}
+
+void FNamePattern::Parse(const FString& Rules, TArray<FNamePattern>& Patterns)
+{
+	TArray<FString> Lines;
+	Rules.ParseIntoArrayLines(Lines);
+
+	// Split lines on commas, keeping the ones inside regular expressions.
+	TArray<FString> Split;
+	for (auto& Line : Lines)
+	{
+		Line.TrimStartAndEndInline();
+		if (Line.StartsWith(TEXT(";")) || Line.StartsWith(TEXT("#")))
+			continue;
+
+		for (int32 Start = 0; Start < Line.Len();)
+		{
+			const int32 End = FindRuleEnd(Line, Start);
+			Split.Add(Line.Mid(Start, End - Start).TrimStartAndEnd());
+			Start = End + 1;
+		}
+	}
+
+	for (auto Line : Split)
+	{
+		if (Line.IsEmpty())
+			continue;
+
+		auto Type = EPatternType::Include;
+		if (Line[0] == TEXT('-') || Line[0] == TEXT('+'))
+		{
+			Type = Line[0] == TEXT('-') ? EPatternType::Exclude : EPatternType::Include;
+			Line.RightChopInline(1);
+			Line.TrimStartInline();
+		}
+
+		if (Line.Len() > 1 && Line.StartsWith(TEXT("/")) && Line.EndsWith(TEXT("/")))
+			Patterns.Emplace(Line.Mid(1, Line.Len() - 2), Type);
+		else
+			Patterns.Emplace(GlobToRegex(Line), Type);
+	}
+}
+
+bool FNamePattern::IsMatch(const TArray<FNamePattern>& Patterns, const FString& Name, const bool bDefault)
+{
+	for (int i = Patterns.Num() - 1; i >= 0; --i)
+	{
+		if (FRegexMatcher(Patterns[i].Pattern, Name).FindNext())
+			return Patterns[i].Type == EPatternType::Include;
+	}
+
+	return bDefault;
+}
+
+//==============================================================================
+//= Settings
+
+bool FSettings::ShouldExportModule(const FString& Module, const bool bIsGame) const
+{
+	return bIsGame ? GameModules.IncludesModule(Module) : EngineModules.IncludesModule(Module);
+}
+
+bool FSettings::ShouldExportType(const FString& Module, const FString& Type) const
+{
+	const auto Detailed = DetailedModules.Find(Module);
+	if (!Detailed)
+		return true;
+
+	return FNamePattern::IsMatch(Detailed->Types, Type);
+}
+
 FSettings FSettings::Load(const TCHAR* Path)
 {
 	auto& PlatformFile = IPlatformFile::GetPlatformPhysical();
 
 	FSettings Settings;
 
+	FString EngineModules = DefaultEngineModules;
+	FString GameModules = TEXT("*");
+
 	if (PlatformFile.FileExists(Path))
 	{
 		CSimpleIniTChar Archive(true, false, true);
 		Archive.LoadFile(Path);
 
-		FString RequestedModules = Archive.GetValue(TEXT("Settings"), TEXT("Modules"));
-
 		Settings.MainModuleName = Archive.GetValue(TEXT("Settings"), TEXT("MainModule"));
 		Settings.OutputPath = Archive.GetValue(TEXT("Settings"), TEXT("OutputPath"));
+
+		const FString Format = Archive.GetValue(TEXT("Settings"), TEXT("MetadataFormat"), TEXT("Binary"));
+		if (Format == TEXT("Json"))
+			Settings.MetadataFormat = EMetadataFormat::Json;
+
+		EngineModules = Archive.GetValue(GenerationSection, TEXT("Modules"), DefaultEngineModules);
+		GameModules = Archive.GetValue(GenerationSection, TEXT("GameModules"), TEXT("*"));
+
+		CSimpleIniTChar::TNamesDepend Sections;
+		Archive.GetAllSections(Sections);
+
+		for (const auto& Section : Sections)
+		{
+			const FString SectionName = Section.pItem;
+			if (!SectionName.StartsWith(ModuleSectionPrefix))
+				continue;
+
+			FModuleGeneration Module;
+			Module.Name = SectionName.RightChop(FCString::Strlen(ModuleSectionPrefix));
+			FNamePattern::Parse(Archive.GetValue(Section.pItem, TEXT("Generate"), TEXT("*")), Module.Types);
+
+			Settings.DetailedModules.Add(Module.Name, MoveTemp(Module));
+		}
 	}
 
+	FNamePattern::Parse(EngineModules, Settings.EngineModules.ModulePatterns);
+	FNamePattern::Parse(GameModules, Settings.GameModules.ModulePatterns);
+
 	return Settings;
 }
@@ -0,0 +1,342 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "MetadataDatabase.h"
+
+#include "TypeInformation.h"
+
+using namespace MetadataDatabase;
+
+//==============================================================================
+//= Helper Declaration
+
+static FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key);
+static int64 GetInt64(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key);
+static bool GetBool(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key);
+static const TArray<TSharedPtr<FJsonValue>>& GetArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key);
+static TSharedPtr<FJsonObject> GetObject(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key);
+static uint8 ParseEnumForm(const FString& Form);
+
+//==============================================================================
+//= Implementation
+
+FMetadataDatabaseWriter::FMetadataDatabaseWriter(FPackageInfo* Package)
+{
+	// Index 0 is always the empty string.
+	AddString(FString());
+
+	const auto& Serialized = Package->Serialized;
+
+	Module.Name = AddString(Package->GetName());
+	Module.LongName = AddString(GetString(Serialized, TEXT("LongName")));
+	Module.Folder = AddString(GetString(Serialized, TEXT("Folder")));
+	Module.File = AddString(GetString(Serialized, TEXT("File")));
+	Module.PackageType = static_cast<uint32>(Package->ModuleType);
+	Module.Padding = 0;
+}
+
+void FMetadataDatabaseWriter::AddType(FTypeInfo* Type)
+{
+	const auto& Serialized = Type->Serialized;
+
+	const auto Index = Types.AddZeroed();
+
+	// Fill in records that may grow the tables before taking a reference to this one.
+	const auto Name = AddString(GetString(Serialized, TEXT("Name")));
+	const auto CppName = AddString(GetString(Serialized, TEXT("CppName")));
+	const auto ModuleName = AddString(GetString(Serialized, TEXT("Module")));
+	const auto TypeMeta = AddMeta(GetObject(Serialized, TEXT("Meta")));
+
+	auto Parent = InvalidIndex;
+	if (const auto ParentObject = GetObject(Serialized, TEXT("Parent")))
+		Parent = AddTypeName(ParentObject);
+
+	FRange PropertyRange;
+	const auto& PropertyValues = GetArray(Serialized, TEXT("Properties"));
+	PropertyRange.Start = Properties.AddZeroed(PropertyValues.Num());
+	PropertyRange.Count = PropertyValues.Num();
+	for (int32 i = 0; i < PropertyValues.Num(); ++i)
+		WriteProperty(PropertyRange.Start + i, PropertyValues[i]->AsObject());
+
+	FRange FunctionRange;
+	const auto& FunctionValues = GetArray(Serialized, TEXT("Functions"));
+	FunctionRange.Start = Functions.AddZeroed(FunctionValues.Num());
+	FunctionRange.Count = FunctionValues.Num();
+	for (int32 i = 0; i < FunctionValues.Num(); ++i)
+		WriteFunction(FunctionRange.Start + i, FunctionValues[i]->AsObject());
+
+	FRange InterfaceRange;
+	const auto& InterfaceValues = GetArray(Serialized, TEXT("Interfaces"));
+	InterfaceRange.Start = Indices.Num();
+	InterfaceRange.Count = InterfaceValues.Num();
+	for (const auto& Interface : InterfaceValues)
+		Indices.Add(AddString(Interface->AsString()));
+
+	FRange EnumValueRange;
+	const auto& EnumValueValues = GetArray(Serialized, TEXT("Values"));
+	EnumValueRange.Start = EnumValues.Num();
+	EnumValueRange.Count = EnumValueValues.Num();
+	for (const auto& Value : EnumValueValues)
+	{
+		const auto ValueObject = Value->AsObject();
+
+		FEnumValueRecord Record;
+		Record.Value = GetInt64(ValueObject, TEXT("Value"));
+		Record.Name = AddString(GetString(ValueObject, TEXT("Name")));
+		Record.Padding = 0;
+		EnumValues.Add(Record);
+	}
+
+	auto& Record = Types[Index];
+	Record.Flags = GetInt64(Serialized, TEXT("Flags"));
+	Record.MaxValue = GetInt64(Serialized, TEXT("MaximumValue"));
+	Record.Name = Name;
+	Record.CppName = CppName;
+	Record.Module = ModuleName;
+	Record.Meta = TypeMeta;
+	Record.Parent = Parent;
+	Record.Size = GetInt64(Serialized, TEXT("Size"));
+	Record.Properties = PropertyRange;
+	Record.Functions = FunctionRange;
+	Record.Interfaces = InterfaceRange;
+	Record.EnumValues = EnumValueRange;
+	Record.Kind = static_cast<uint8>(Type->GetKind());
+	Record.EnumForm = ParseEnumForm(GetString(Serialized, TEXT("EnumKind")));
+	Record.IsFlags = GetBool(Serialized, TEXT("IsFlags"));
+}
+
+template <typename T>
+static void AppendTable(TArray<uint8>& Output, FTableRef& Ref, const TArray<T>& Table)
+{
+	// Keep every table 8 byte aligned so records can be read in place.
+	Output.AddZeroed(Align(Output.Num(), 8) - Output.Num());
+
+	Ref.Offset = Output.Num();
+	Ref.Count = Table.Num();
+
+	Output.Append(reinterpret_cast<const uint8*>(Table.GetData()), Table.Num() * sizeof(T));
+}
+
+void FMetadataDatabaseWriter::Serialize(TArray<uint8>& Output) const
+{
+	FHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.Module = Module;
+
+	Output.Reset();
+	Output.AddZeroed(sizeof(FHeader));
+
+	AppendTable(Output, Header.Strings, Strings);
+	AppendTable(Output, Header.Types, Types);
+	AppendTable(Output, Header.Functions, Functions);
+	AppendTable(Output, Header.Properties, Properties);
+	AppendTable(Output, Header.TypeRefs, TypeRefs);
+	AppendTable(Output, Header.Meta, Meta);
+	AppendTable(Output, Header.EnumValues, EnumValues);
+	AppendTable(Output, Header.Indices, Indices);
+	AppendTable(Output, Header.StringData, StringData);
+
+	FMemory::Memcpy(Output.GetData(), &Header, sizeof(FHeader));
+}
+
+uint32 FMetadataDatabaseWriter::AddString(const FString& String)
+{
+	if (const auto Existing = StringIndex.Find(String))
+		return *Existing;
+
+	const FTCHARToUTF8 Utf8(*String);
+
+	FStringRecord Record;
+	Record.Offset = StringData.Num();
+	Record.Length = Utf8.Length();
+	StringData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	const uint32 Index = Strings.Add(Record);
+	StringIndex.Add(String, Index);
+	return Index;
+}
+
+FRange FMetadataDatabaseWriter::AddMeta(const TSharedPtr<FJsonObject>& Object)
+{
+	FRange Range;
+	Range.Start = Meta.Num();
+
+	if (!Object)
+		return Range;
+
+	for (const auto& Pair : Object->Values)
+	{
+		FMetaRecord Record;
+		Record.Key = AddString(Pair.Key);
+		Record.Value = AddString(Pair.Value->AsString());
+		Meta.Add(Record);
+	}
+
+	Range.Count = Meta.Num() - Range.Start;
+	return Range;
+}
+
+uint32 FMetadataDatabaseWriter::AddTypeName(const TSharedPtr<FJsonObject>& Object)
+{
+	FTypeRefRecord Record;
+	Record.Kind = ETypeRefKind::TypeName;
+	Record.Property = InvalidIndex;
+	Record.Module = AddString(GetString(Object, TEXT("Module")));
+	Record.Name = AddString(GetString(Object, TEXT("Name")));
+	Record.CppName = AddString(GetString(Object, TEXT("CppName")));
+
+	return TypeRefs.Add(Record);
+}
+
+uint32 FMetadataDatabaseWriter::AddProperty(const TSharedPtr<FJsonObject>& Object)
+{
+	const auto Index = Properties.AddZeroed();
+	WriteProperty(Index, Object);
+	return Index;
+}
+
+void FMetadataDatabaseWriter::WriteProperty(const uint32 Index, const TSharedPtr<FJsonObject>& Object)
+{
+	const auto Name = AddString(GetString(Object, TEXT("Name")));
+	const auto RawType = AddString(GetString(Object, TEXT("RawType")));
+	const auto PropertyType = AddString(GetString(Object, TEXT("PropertyType")));
+	const auto PropertyMeta = AddMeta(GetObject(Object, TEXT("Meta")));
+
+	auto Type = InvalidIndex;
+	if (const auto TypeObject = GetObject(Object, TEXT("Type")))
+		Type = AddTypeName(TypeObject);
+
+	// Reserve the argument range first so it stays contiguous when arguments contain generic arguments themselves.
+	FRange GenericRange;
+	const auto& GenericValues = GetArray(Object, TEXT("GenericTypeParameters"));
+	GenericRange.Start = TypeRefs.AddZeroed(GenericValues.Num());
+	GenericRange.Count = GenericValues.Num();
+	for (int32 i = 0; i < GenericValues.Num(); ++i)
+	{
+		const auto Argument = GenericValues[i]->AsObject();
+
+		FTypeRefRecord Record;
+		if (GetString(Argument, TEXT("FieldType")) == TEXT("Property"))
+		{
+			Record.Kind = ETypeRefKind::Property;
+			Record.Property = AddProperty(GetObject(Argument, TEXT("Property")));
+			Record.Module = Record.Name = Record.CppName = 0;
+		}
+		else
+		{
+			Record.Kind = ETypeRefKind::TypeName;
+			Record.Property = InvalidIndex;
+			Record.Module = AddString(GetString(Argument, TEXT("Module")));
+			Record.Name = AddString(GetString(Argument, TEXT("Name")));
+			Record.CppName = AddString(GetString(Argument, TEXT("CppName")));
+		}
+
+		TypeRefs[GenericRange.Start + i] = Record;
+	}
+
+	auto& Record = Properties[Index];
+	Record.Flags = GetInt64(Object, TEXT("Flags"));
+	Record.Name = Name;
+	Record.RawType = RawType;
+	Record.PropertyType = PropertyType;
+	Record.Meta = PropertyMeta;
+	Record.Offset = GetInt64(Object, TEXT("Offset"));
+	Record.ArrayDim = GetInt64(Object, TEXT("ArrayDim"));
+	Record.Type = Type;
+	Record.GenericArguments = GenericRange;
+	Record.IsUnknown = GetBool(Object, TEXT("IsUnknown"));
+	Record.Padding = 0;
+}
+
+void FMetadataDatabaseWriter::WriteFunction(const uint32 Index, const TSharedPtr<FJsonObject>& Object)
+{
+	const auto Name = AddString(GetString(Object, TEXT("Name")));
+	const auto FunctionMeta = AddMeta(GetObject(Object, TEXT("Meta")));
+
+	FRange ParameterRange;
+	const auto& ParameterValues = GetArray(Object, TEXT("Parameters"));
+	ParameterRange.Start = Properties.AddZeroed(ParameterValues.Num());
+	ParameterRange.Count = ParameterValues.Num();
+	for (int32 i = 0; i < ParameterValues.Num(); ++i)
+		WriteProperty(ParameterRange.Start + i, ParameterValues[i]->AsObject());
+
+	auto Return = InvalidIndex;
+	if (const auto ReturnObject = GetObject(Object, TEXT("Return")))
+		Return = AddProperty(ReturnObject);
+
+	auto& Record = Functions[Index];
+	Record.Flags = GetInt64(Object, TEXT("Flags"));
+	Record.Name = Name;
+	Record.Meta = FunctionMeta;
+	Record.Parameters = ParameterRange;
+	Record.Return = Return;
+	Record.ParmsSize = GetInt64(Object, TEXT("ParmsSize"));
+	Record.ReturnValueOffset = Object->HasField(TEXT("ReturnValueOffset")) ? GetInt64(Object, TEXT("ReturnValueOffset")) : -1;
+}
+
+//==============================================================================
+//= Helpers
+
+static FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key)
+{
+	FString Value;
+	Object->TryGetStringField(Key, Value);
+	return Value;
+}
+
+static int64 GetInt64(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key)
+{
+	const auto Field = Object->TryGetField(Key);
+	if (!Field)
+		return 0;
+
+	// Values are written as number strings, which report EJson::Number, read them from their text so 64-bit flags and
+	// enum values do not go through a double.
+	FString String;
+	if (Field->TryGetString(String) && !String.IsEmpty() && !String.Contains(TEXT(".")) && !String.Contains(TEXT("e")))
+		return FCString::Atoi64(*String);
+
+	double Number;
+	if (Field->TryGetNumber(Number))
+		return static_cast<int64>(Number);
+
+	return 0;
+}
+
+static bool GetBool(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key)
+{
+	bool Value = false;
+	Object->TryGetBoolField(Key, Value);
+	return Value;
+}
+
+static const TArray<TSharedPtr<FJsonValue>>& GetArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key)
+{
+	static const TArray<TSharedPtr<FJsonValue>> Empty;
+
+	const TArray<TSharedPtr<FJsonValue>>* Array;
+	if (Object->TryGetArrayField(Key, Array))
+		return *Array;
+
+	return Empty;
+}
+
+static TSharedPtr<FJsonObject> GetObject(const TSharedPtr<FJsonObject>& Object, const TCHAR* Key)
+{
+	const TSharedPtr<FJsonObject>* Value;
+	if (Object->TryGetObjectField(Key, Value))
+		return *Value;
+
+	return TSharedPtr<FJsonObject>();
+}
+
+static uint8 ParseEnumForm(const FString& Form)
+{
+	if (Form == TEXT("Namespaced"))
+		return static_cast<uint8>(UEnum::ECppForm::Namespaced);
+	if (Form == TEXT("EnumClass"))
+		return static_cast<uint8>(UEnum::ECppForm::EnumClass);
+	return static_cast<uint8>(UEnum::ECppForm::Regular);
+}
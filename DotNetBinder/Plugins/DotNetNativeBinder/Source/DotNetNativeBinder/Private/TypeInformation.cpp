@@ -3,7 +3,10 @@
 
 #include "TypeInformation.h"
 
+#include "Async/ParallelFor.h"
 #include "DotNetNativeBinder.h"
+#include "ExportManifest.h"
+#include "MetadataDatabase.h"
 
 //==============================================================================
 //= Helper Declaration
@@ -30,21 +33,33 @@ void FMetaInfo::CollectInfo(FTypeCollector* Collector)
 		Serialized->SetStringField("Kind", ToString(Kind));
 }
 
-void FMetaInfo::WriteTo(FString Destination, FString NameOverride)
+bool FMetaInfo::SerializeJson(TArray<uint8>& Output) const
 {
 	// TODO: This can be done better by creating an archive directly.
 	FString FileContents;
 	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
 
+	if (!FJsonSerializer::Serialize(Serialized.ToSharedRef(), JsonWriter))
+		return false;
+
+	JsonWriter->Close();
+
+	const FTCHARToUTF8 Utf8(*FileContents);
+	Output.Reset(Utf8.Length());
+	Output.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	return true;
+}
+
+void FMetaInfo::WriteTo(FString Destination, FString NameOverride)
+{
 	const auto Name = NameOverride.Len() > 0 ? NameOverride : GetName();
 
 	const auto Path = FPaths::Combine(Destination, Name + ".umeta");
 
-	if (FJsonSerializer::Serialize(Serialized.ToSharedRef(), JsonWriter))
+	TArray<uint8> FileContents;
+	if (SerializeJson(FileContents))
 	{
-		JsonWriter->Close();
-		const auto Result =
-			FFileHelper::SaveStringToFile(FileContents, *Path, FFileHelper::EEncodingOptions::ForceUTF8);
+		const auto Result = FFileHelper::SaveArrayToFile(FileContents, *Path);
 		if (!Result)
 		{
 			UE_LOG(LogDotNetGenerator, Error, TEXT("Could not serialize file %s"), *Path);
@@ -351,6 +366,10 @@ void FFunctionInfo::CollectInfo(FTypeCollector* Collector)
 
 	Serialized->SetArrayField("Parameters", SerializedParameters);
 
+	// Layout of the parameter frame, lets the generator invoke functions that are not exported from their module.
+	Serialized->SetNumberField("ParmsSize", Function->ParmsSize);
+	Serialized->SetNumberField("ReturnValueOffset", Return ? Function->ReturnValueOffset : -1);
+
 	if (Return)
 		Serialized->SetObjectField("Return", Return->Serialized);
 	else
@@ -575,6 +594,15 @@ FClassInfo* FTypeCollector::TouchClass(UClass* Class)
 	return Info;
 }
 
+void FTypeCollector::ExportClass(UClass* Class)
+{
+	const auto StartTime = FPlatformTime::Seconds();
+
+	TouchClass(Class);
+
+	CollectionTime += FPlatformTime::Seconds() - StartTime;
+}
+
 FScriptStructInfo* FTypeCollector::TouchStruct(UScriptStruct* Struct)
 {
 	auto info = Structs.FindOrAdd(Struct);
@@ -615,26 +643,164 @@ inline FFunctionInfo* FTypeCollector::TouchFunction(UFunction* Function)
 	return info;
 }
 
-void FTypeCollector::ExportAllTypes(FString DestinationPath)
+/**
+ * A single file produced by the export.
+ */
+struct FExportItem
+{
+	FIncrementalExport* Export;
+
+	// Package for binary databases, type or package for json files.
+	FMetaInfo* Info;
+
+	FString RelativePath;
+
+	TArray<uint8> Contents;
+
+	FString Hash;
+
+	bool bWrite = false;
+};
+
+/**
+ * Remove the output a module may have left in the other metadata format. The generator reads every metadata file it
+ * finds, so a stale database or json export would otherwise be collected next to the current one.
+ */
+static void RemoveOtherFormat(IPlatformFile& File, const FString& DestinationPath, const FString& ModuleName,
+                              EMetadataFormat Format)
 {
-	// TODO: We should be able to use a parallel for here.
+	if (Format == EMetadataFormat::Binary)
+	{
+		File.DeleteFile(*FPaths::Combine(DestinationPath, ModuleName + TEXT(".umeta")));
+		File.DeleteDirectoryRecursively(*FPaths::Combine(DestinationPath, ModuleName));
+	}
+	else
+	{
+		File.DeleteFile(*FPaths::Combine(DestinationPath, ModuleName + MetadataDatabase::Extension));
+	}
+}
 
+void FTypeCollector::ExportAllTypes(FString DestinationPath, EMetadataFormat Format)
+{
 	// TODO: In the haxe wrapper they also collect types that are loaded but not reported, we'll probably want to avoid
 	// those for now since we can't use them anyway, 
 
+	const auto StartTime = FPlatformTime::Seconds();
+
 	auto& File = IPlatformFile::GetPlatformPhysical();
 
+	// Plan the export on this thread, this is where previous manifests are loaded.
+	// ============================================================================
+	TArray<TUniquePtr<FIncrementalExport>> Exports;
+	TArray<FExportItem> Items;
+
 	for (const auto Package : Packages)
 	{
 		auto Info = Package.Value;
-		Info->WriteTo(*DestinationPath);
 
-		auto PackageDir = FPaths::Combine(*DestinationPath, Info->GetName());
-		File.CreateDirectoryTree(*PackageDir);
+		const auto ModuleName = Info->GetName();
+
+		auto& Export = *Exports.Emplace_GetRef(MakeUnique<FIncrementalExport>(DestinationPath, ModuleName));
+
+		RemoveOtherFormat(File, DestinationPath, ModuleName, Format);
+
+		if (Format == EMetadataFormat::Binary)
+		{
+			Items.Add({&Export, Info, ModuleName + MetadataDatabase::Extension});
+			continue;
+		}
+
+		Items.Add({&Export, Info, ModuleName + TEXT(".umeta")});
+
+		File.CreateDirectoryTree(*FPaths::Combine(*DestinationPath, ModuleName));
 
 		for (auto Type : Info->Types)
-			Type->WriteTo(PackageDir);
+		{
+			// Every type is serialized and compared by hash, a type's json also changes with its parents and the structs
+			// it references, which UHT does not report.
+			Items.Add({&Export, Type, FPaths::Combine(ModuleName, Type->GetName() + TEXT(".umeta"))});
+		}
 	}
+
+	// Serialize.
+	// ==========
+	// The collected data is not modified anymore and each item only touches the json objects of its own type, so
+	// items can be processed in any order.
+	const auto SerializeStartTime = FPlatformTime::Seconds();
+
+	ParallelFor(Items.Num(), [&](const int32 Index)
+	{
+		auto& Item = Items[Index];
+
+		if (Format == EMetadataFormat::Binary)
+		{
+			const auto Package = static_cast<FPackageInfo*>(Item.Info);
+
+			FMetadataDatabaseWriter Writer(Package);
+			for (auto Type : Package->Types)
+				Writer.AddType(Type);
+
+			Writer.Serialize(Item.Contents);
+		}
+		else if (!Item.Info->SerializeJson(Item.Contents))
+		{
+			return;
+		}
+
+		Item.Hash = FExportManifest::HashContents(Item.Contents);
+		Item.bWrite = !Item.Export->IsUnchanged(Item.RelativePath, Item.Hash);
+	}, EParallelForFlags::Unbalanced);
+
+	// Write changed files.
+	// ====================
+	const auto WriteStartTime = FPlatformTime::Seconds();
+
+	ParallelFor(Items.Num(), [&](const int32 Index)
+	{
+		auto& Item = Items[Index];
+		if (!Item.bWrite)
+			return;
+
+		const auto Path = FPaths::Combine(Item.Export->GetDestination(), Item.RelativePath);
+		if (!FFileHelper::SaveArrayToFile(Item.Contents, *Path))
+		{
+			UE_LOG(LogDotNetGenerator, Error, TEXT("Could not serialize file %s"), *Path);
+
+			// Leave the file out of the manifest so the next run tries again.
+			Item.Hash.Reset();
+		}
+
+		// Release the memory as we go.
+		Item.Contents.Empty();
+	}, EParallelForFlags::Unbalanced);
+
+	// Update manifests and remove stale files.
+	// ========================================
+	for (auto& Item : Items)
+	{
+		if (!Item.Hash.IsEmpty())
+			Item.Export->Record(Item.RelativePath, MoveTemp(Item.Hash), Item.bWrite);
+	}
+
+	int32 Written = 0, Unchanged = 0, Removed = 0;
+	for (const auto& Export : Exports)
+	{
+		Export->Finish();
+
+		Written += Export->Written;
+		Unchanged += Export->Unchanged;
+		Removed += Export->Removed;
+	}
+
+	const auto EndTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogDotNetGenerator, Display,
+	       TEXT("Exported metadata for %d modules in %.2fms, %d files written, %d unchanged, %d removed."),
+	       Packages.Num(), (EndTime - StartTime) * 1000, Written, Unchanged, Removed);
+	UE_LOG(LogDotNetGenerator, Display,
+	       TEXT("Binder timing: collection %.2fms, planning %.2fms, serialization %.2fms, io %.2fms."),
+	       CollectionTime * 1000, (SerializeStartTime - StartTime) * 1000, (WriteStartTime - SerializeStartTime) * 1000,
+	       (EndTime - WriteStartTime) * 1000);
 }
 
 //==============================================================================
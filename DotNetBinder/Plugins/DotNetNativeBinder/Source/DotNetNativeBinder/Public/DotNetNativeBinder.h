@@ -22,6 +22,15 @@ class FDotNetNativeBinderModule : public FDotNetModuleBase
 
 	mutable FTypeCollector Collector;
 
+	// Counts of what was pruned by the generation settings.
+	mutable struct
+	{
+		int32 ExportedModules = 0;
+		int32 SkippedModules = 0;
+		int32 ExportedClasses = 0;
+		int32 SkippedClasses = 0;
+	} Stats;
+
 public:
 	virtual ~FDotNetNativeBinderModule() = default;
 
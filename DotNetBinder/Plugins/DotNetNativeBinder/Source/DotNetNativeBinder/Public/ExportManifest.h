@@ -0,0 +1,81 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * Record of the metadata files written for a module on the previous run.
+ *
+ * Files are keyed by their path relative to the output directory, the value is the hash of their contents. This lets
+ * the exporter skip files that would not change, so their timestamps stay untouched and the managed side does not
+ * regenerate, and delete files for types that no longer exist.
+ */
+struct FExportManifest
+{
+	static constexpr int32 Version = 1;
+
+	static constexpr TCHAR Extension[] = TEXT(".umanifest");
+
+	TMap<FString, FString> Files;
+
+	/**
+	 * @brief Load the manifest of a module, leaves the manifest empty if the file is missing or outdated.
+	 * @param Destination Metadata output directory.
+	 * @param Module Module name.
+	 */
+	void Load(const FString& Destination, const FString& Module);
+
+	void Save(const FString& Destination, const FString& Module) const;
+
+	static FString HashContents(const TArray<uint8>& Contents);
+};
+
+/**
+ * Tracks the changes of an incremental export.
+ */
+struct FIncrementalExport
+{
+	int32 Written = 0;
+
+	int32 Unchanged = 0;
+
+	int32 Removed = 0;
+
+	FIncrementalExport(FString Destination, FString Module);
+
+	/**
+	 * @brief Check whether a file would have the same contents as in the previous export.
+	 * @param RelativePath Path of the file relative to the output directory.
+	 * @param Hash Hash of the new contents.
+	 */
+	bool IsUnchanged(const FString& RelativePath, const FString& Hash) const;
+
+	/**
+	 * @brief Record a file produced by this export.
+	 * @param RelativePath Path of the file relative to the output directory.
+	 * @param Hash Hash of the file contents, empty if the file could not be written.
+	 * @param bWritten Whether the file was written, or kept because it did not change.
+	 */
+	void Record(const FString& RelativePath, FString Hash, bool bWritten);
+
+	/**
+	 * @brief Delete files that were not written or kept during this export and save the new manifest.
+	 */
+	void Finish();
+
+	const FString& GetDestination() const
+	{
+		return Destination;
+	}
+
+private:
+	FString Destination;
+
+	FString Module;
+
+	FExportManifest Previous;
+
+	FExportManifest Current;
+};
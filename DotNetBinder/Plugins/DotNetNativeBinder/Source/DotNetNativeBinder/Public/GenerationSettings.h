@@ -7,28 +7,40 @@
 
 #include "Internationalization/Regex.h"
 
-// TODO: Finish later in appropriate task.
-
 enum class EPatternType : uint8
 {
 	Include,
 	Exclude
 };
 
+/**
+ * Include or exclude rule for module and type names.
+ *
+ * Rules are written one per line or separated by commas. A rule is a glob pattern (`*` and `?` wildcards) or a
+ * regular expression when surrounded by slashes (`/^U.*Component$/`). Rules prefixed with `-` exclude matching names,
+ * an optional `+` prefix marks an include rule.
+ */
 struct FNamePattern
 {
 	FRegexPattern Pattern;
 	EPatternType Type;
 
-	static inline bool IsMatch(TArray<FNamePattern> Patterns, FString Name)
-	{
-		// TODO: Implement matching correctly.
-		for (int i = Patterns.Num() - 1; i >= 0; --i)
-		{
-			bool IsMatch = FRegexMatcher(Patterns[i].Pattern, Name).FindNext();
-		}
-		return false;
-	}
+	FNamePattern(const FString& Regex, EPatternType Type);
+
+	/**
+	 * @brief Parse a list of rules.
+	 * @param Rules Rules separated by new lines or commas, regular expressions may contain commas.
+	 * @param Patterns Array that receives the parsed patterns.
+	 */
+	static void Parse(const FString& Rules, TArray<FNamePattern>& Patterns);
+
+	/**
+	 * @brief Match a name against a list of patterns, the last matching pattern wins.
+	 * @param Patterns Patterns in the order they were declared.
+	 * @param Name Name to match.
+	 * @param bDefault Result when no pattern matches.
+	 */
+	static bool IsMatch(const TArray<FNamePattern>& Patterns, const FString& Name, bool bDefault = false);
 };
 
 /**
@@ -47,11 +59,22 @@ struct FModuleGenerationSet
 	// Patterns to match modules to be included in generation.
 	TArray<FNamePattern> ModulePatterns;
 
-	/**
-	 * Modules with class specific rules.
-	 * These are only considered if the module matches a pattern in @ref ModulePatterns
-	 */
-	TArray<FModuleGeneration> DetailedModules;
+	bool IncludesModule(const FString& Name) const
+	{
+		return FNamePattern::IsMatch(ModulePatterns, Name);
+	}
+};
+
+/**
+ * On disk format of the exported metadata.
+ */
+enum class EMetadataFormat : uint8
+{
+	// One binary database per module.
+	Binary,
+
+	// One json file per type, slower but human readable.
+	Json
 };
 
 /**
@@ -67,5 +90,17 @@ struct FSettings
 
 	FString MainModuleName;
 
+	EMetadataFormat MetadataFormat = EMetadataFormat::Binary;
+
+	/**
+	 * Modules with type specific rules, from the [Generation.Module.<Name>] sections.
+	 * These are only considered if the module is included by @ref EngineModules or @ref GameModules.
+	 */
+	TMap<FString, FModuleGeneration> DetailedModules;
+
+	bool ShouldExportModule(const FString& Module, bool bIsGame) const;
+
+	bool ShouldExportType(const FString& Module, const FString& Type) const;
+
 	static FSettings Load(const TCHAR* Path);
 };
@@ -0,0 +1,197 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "Json.h"
+
+struct FTypeInfo;
+struct FPackageInfo;
+
+/**
+ * Binary metadata database, one file per module.
+ *
+ * The file is a fixed header followed by flat tables of fixed size records. Records reference each other and
+ * the string table by index, so the whole file can be mapped into memory and read in place.
+ *
+ * The layout must be kept in sync with Unreal.HeaderTool/MetadataDatabase.cs.
+ */
+namespace MetadataDatabase
+{
+	static constexpr uint32 Magic = 0x42444D55; // UMDB
+	static constexpr uint32 Version = 2;
+	static constexpr uint32 InvalidIndex = 0xFFFFFFFF;
+
+	static constexpr TCHAR Extension[] = TEXT(".umdb");
+
+	enum class ETypeRefKind : uint32
+	{
+		TypeName,
+		Property
+	};
+
+	struct FRange
+	{
+		uint32 Start = 0;
+		uint32 Count = 0;
+	};
+
+	struct FTableRef
+	{
+		uint32 Offset = 0;
+		uint32 Count = 0;
+	};
+
+	struct FStringRecord
+	{
+		uint32 Offset;
+		uint32 Length;
+	};
+
+	struct FMetaRecord
+	{
+		uint32 Key;
+		uint32 Value;
+	};
+
+	struct FTypeRefRecord
+	{
+		ETypeRefKind Kind;
+		uint32 Property;
+		uint32 Module;
+		uint32 Name;
+		uint32 CppName;
+	};
+
+	struct FEnumValueRecord
+	{
+		int64 Value;
+		uint32 Name;
+		uint32 Padding;
+	};
+
+	struct FPropertyRecord
+	{
+		uint64 Flags;
+		uint32 Name;
+		uint32 RawType;
+		uint32 PropertyType;
+		FRange Meta;
+		int32 Offset;
+		int32 ArrayDim;
+		uint32 Type;
+		FRange GenericArguments;
+		uint32 IsUnknown;
+		uint32 Padding;
+	};
+
+	struct FFunctionRecord
+	{
+		uint64 Flags;
+		uint32 Name;
+		FRange Meta;
+		FRange Parameters;
+		uint32 Return;
+		int32 ParmsSize;
+		int32 ReturnValueOffset;
+	};
+
+	struct FTypeRecord
+	{
+		uint64 Flags;
+		int64 MaxValue;
+		uint32 Name;
+		uint32 CppName;
+		uint32 Module;
+		FRange Meta;
+		uint32 Parent;
+		int32 Size;
+		FRange Properties;
+		FRange Functions;
+		FRange Interfaces;
+		FRange EnumValues;
+		uint8 Kind;
+		uint8 EnumForm;
+		uint8 IsFlags;
+		uint8 Padding[9];
+	};
+
+	struct FModuleRecord
+	{
+		uint32 Name;
+		uint32 LongName;
+		uint32 Folder;
+		uint32 File;
+		uint32 PackageType;
+		uint32 Padding;
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		FTableRef Strings;
+		FTableRef StringData;
+		FTableRef Types;
+		FTableRef Functions;
+		FTableRef Properties;
+		FTableRef TypeRefs;
+		FTableRef Meta;
+		FTableRef EnumValues;
+		FTableRef Indices;
+		FModuleRecord Module;
+	};
+
+	static_assert(sizeof(FTypeRefRecord) == 20, "Record layout changed.");
+	static_assert(sizeof(FEnumValueRecord) == 16, "Record layout changed.");
+	static_assert(sizeof(FPropertyRecord) == 56, "Record layout changed.");
+	static_assert(sizeof(FFunctionRecord) == 40, "Record layout changed.");
+	static_assert(sizeof(FTypeRecord) == 88, "Record layout changed.");
+	static_assert(sizeof(FHeader) == 104, "Record layout changed.");
+}
+
+/**
+ * Builds the binary metadata database for a single module from the collected type information.
+ */
+class FMetadataDatabaseWriter
+{
+public:
+	explicit FMetadataDatabaseWriter(FPackageInfo* Package);
+
+	void AddType(FTypeInfo* Type);
+
+	/**
+	 * @brief Write the database to a memory buffer.
+	 * @param Output Buffer that receives the file contents.
+	 */
+	void Serialize(TArray<uint8>& Output) const;
+
+private:
+	uint32 AddString(const FString& String);
+
+	MetadataDatabase::FRange AddMeta(const TSharedPtr<FJsonObject>& Object);
+
+	uint32 AddTypeName(const TSharedPtr<FJsonObject>& Object);
+
+	uint32 AddProperty(const TSharedPtr<FJsonObject>& Object);
+
+	void WriteProperty(uint32 Index, const TSharedPtr<FJsonObject>& Object);
+
+	void WriteFunction(uint32 Index, const TSharedPtr<FJsonObject>& Object);
+
+	MetadataDatabase::FModuleRecord Module;
+
+	TArray<MetadataDatabase::FStringRecord> Strings;
+	TArray<uint8> StringData;
+	TMap<FString, uint32> StringIndex;
+
+	TArray<MetadataDatabase::FTypeRecord> Types;
+	TArray<MetadataDatabase::FFunctionRecord> Functions;
+	TArray<MetadataDatabase::FPropertyRecord> Properties;
+	TArray<MetadataDatabase::FTypeRefRecord> TypeRefs;
+	TArray<MetadataDatabase::FMetaRecord> Meta;
+	TArray<MetadataDatabase::FEnumValueRecord> EnumValues;
+	TArray<uint32> Indices;
+};
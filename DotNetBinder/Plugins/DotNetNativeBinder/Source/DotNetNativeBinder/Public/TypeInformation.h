@@ -9,6 +9,8 @@
 
 #include "Programs/UnrealHeaderTool/Public/IScriptGeneratorPluginInterface.h"
 
+#include "GenerationSettings.h"
+
 // This makes things confusing, we want to use it as an enum field but engine defines it as macro.
 #undef UProperty
 
@@ -67,6 +69,13 @@ struct FMetaInfo
 	{
 	}
 
+	/**
+	 * @brief Serialize the collected info to UTF-8 json.
+	 * @param Output Buffer that receives the file contents.
+	 * @return Whether serialization succeeded.
+	 */
+	bool SerializeJson(TArray<uint8>& Output) const;
+
 	void WriteTo(FString Destination, FString NameOverride = "");
 
 	virtual ~FMetaInfo()
@@ -277,6 +286,9 @@ struct FTypeCollector
 
 	TMap<UEnum*, FEnumInfo*> Enums;
 
+	// Time spent collecting the types reported by UHT, in seconds.
+	double CollectionTime = 0;
+
 	FPackageInfo* TouchPackage(UPackage* Package);
 
 	void SetPackageType(FString PackageName, EBuildModuleType::Type Type);
@@ -285,6 +297,12 @@ struct FTypeCollector
 	
 	FClassInfo* TouchClass(UClass* Class);
 
+	/**
+	 * @brief Collect a class reported by UHT.
+	 * @param Class The class.
+	 */
+	void ExportClass(UClass* Class);
+
 	FScriptStructInfo* TouchStruct(UScriptStruct* Struct);
 
 	FEnumInfo* TouchEnum(UEnum* Enum);
@@ -293,5 +311,5 @@ struct FTypeCollector
 
 	FFunctionInfo* TouchFunction(UFunction* Function);
 
-	void ExportAllTypes(FString DestinationPath);
+	void ExportAllTypes(FString DestinationPath, EMetadataFormat Format);
 };
@@ -3,39 +3,72 @@
 
 #include "DotNet.h"
 
+namespace
+{
+	/** Verbosity of LogClr as seen by managed code, which reads it directly to skip disabled messages. */
+	uint8 ManagedLogVerbosity = ELogVerbosity::Log;
+
+	void LogMessage(const ELogVerbosity::Type Verbosity, const TCHAR* Message)
+	{
+		switch (Verbosity)
+		{
+		case ELogVerbosity::Fatal:
+			UE_LOG(LogClr, Fatal, TEXT("%s"), Message);
+			break;
+		case ELogVerbosity::Error:
+			UE_LOG(LogClr, Error, TEXT("%s"), Message);
+			break;
+		case ELogVerbosity::Warning:
+			UE_LOG(LogClr, Warning, TEXT("%s"), Message);
+			break;
+		case ELogVerbosity::Display:
+			UE_LOG(LogClr, Display, TEXT("%s"), Message);
+			break;
+		case ELogVerbosity::Log:
+			UE_LOG(LogClr, Log, TEXT("%s"), Message);
+			break;
+		case ELogVerbosity::Verbose:
+			UE_LOG(LogClr, Verbose, TEXT("%s"), Message);
+			break;
+		case ELogVerbosity::VeryVerbose:
+			UE_LOG(LogClr, VeryVerbose, TEXT("%s"), Message);
+			break;
+		default: ;
+		}
+	}
+}
+
 extern "C" {
 
 DOTNET_API void UeLog_Log(ELogVerbosity::Type Verbosity, const UTF16CHAR* Msg)
 {
-	const FString Message(Msg);
+	LogMessage(Verbosity, StringCast<TCHAR>(Msg).Get());
+}
 
-	switch (Verbosity)
+/** Log a batch of null terminated messages, stored one after the other. */
+DOTNET_API void UeLog_LogBatch(int32 Count, const uint8* Verbosities, const UTF16CHAR* Messages)
+{
+	for (int32 i = 0; i < Count; ++i)
 	{
-	case ELogVerbosity::Fatal:
-		UE_LOG(LogClr, Fatal, TEXT("%s"), *Message);
-		break;
-	case ELogVerbosity::Error:
-		UE_LOG(LogClr, Error, TEXT("%s"), *Message);
-		break;
-	case ELogVerbosity::Warning:
-		UE_LOG(LogClr, Warning, TEXT("%s"), *Message);
-		break;
-	case ELogVerbosity::Display:
-		UE_LOG(LogClr, Display, TEXT("%s"), *Message);
-		break;
-	case ELogVerbosity::Log:
-		UE_LOG(LogClr, Log, TEXT("%s"), *Message);
-		break;
-	case ELogVerbosity::Verbose:
-		UE_LOG(LogClr, Verbose, TEXT("%s"), *Message);
-		break;
-	case ELogVerbosity::VeryVerbose:
-		UE_LOG(LogClr, VeryVerbose, TEXT("%s"), *Message);
-		break;
-	default: ;
+		LogMessage(static_cast<ELogVerbosity::Type>(Verbosities[i]), StringCast<TCHAR>(Messages).Get());
+
+		while (*Messages)
+			++Messages;
+		++Messages;
 	}
 }
 
+DOTNET_API const uint8* UeLog_GetVerbosity()
+{
+	return &ManagedLogVerbosity;
+}
+
+/** Update the verbosity seen by managed code, done by the module once per frame. */
+DOTNET_API void UeLog_SyncVerbosity()
+{
+	ManagedLogVerbosity = LogClr.GetVerbosity();
+}
+
 DOTNET_API UEngine** UEngine_Get_GEngine()
 {
 	return &GEngine;
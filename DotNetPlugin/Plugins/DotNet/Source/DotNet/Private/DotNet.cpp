@@ -7,6 +7,14 @@
 
 #include "ClrHost.h"
 #include "CoreClrEntryPoints.h"
+#include "Containers/Ticker.h"
+#include "DotNetBindingStats.h"
+#include "DotNetEventQueue.h"
+#include "DotNetFrameArena.h"
+#include "DotNetGcPacing.h"
+#include "DotNetGcTelemetry.h"
+#include "DotNetScheduling.h"
+#include "DotNetTickManager.h"
 #include "Interfaces/IPluginManager.h"
 
 //= Types
@@ -25,12 +33,53 @@ extern "C" void CoreRT_StaticInitialization();
 // Init the unreal DotNet runtime.
 extern "C" void Unreal_Core__Runtime__Init(QueryEntryPointCallback EntryPointGetter);
 
+// Run the callbacks posted to the game thread.
+extern "C" void Unreal_Core__GameThreadSynchronizationContext__Pump(int64 BudgetMicroseconds, FDotNetPumpStats* Stats);
+
+// Submit the batched managed log messages.
+extern "C" void Unreal_Core__UeLog__Flush();
+
+// Deliver native events to their managed handlers.
+extern "C" void Unreal_Core__NativeEvents__Dispatch(const FDotNetEventRecord* Events, int32 Count);
+
+// Apply the registrations of the tick manager.
+extern "C" uint32 Unreal_Core__TickManager__BeginFrame();
+
+// Tick the managed objects of a tick group.
+extern "C" void Unreal_Core__TickManager__Dispatch(uint8 Group, float DeltaTime);
+
+// Per-frame tick of GC pacing.
+extern "C" void Unreal_Core__GcPacing__Tick(uint8 bEnabled, int64 AllocationBudget, int64 FrameNoGcRegionSize,
+                                            FDotNetGcFrameStats* Stats);
+
+// Enter a region without garbage collections.
+extern "C" uint8 Unreal_Core__GcPacing__TryEnterNoGcRegion(int64 TotalSize);
+
+// Leave a region without garbage collections.
+extern "C" uint8 Unreal_Core__GcPacing__ExitNoGcRegion();
+
+#if DOTNET_GC_TELEMETRY
+// Start recording garbage collections.
+extern "C" void Unreal_Core__GcTelemetry__Enable();
+
+// Read the recorded garbage collections.
+extern "C" int32 Unreal_Core__GcTelemetry__Drain(FDotNetGcEvent* Events, int32 Capacity);
+#endif
+
+
+// Update the log verbosity seen by managed code, see Bindings.cpp.
+extern "C" DOTNET_API void UeLog_SyncVerbosity();
 
 //= Entry Point Queries
 //==============================================================================
 
 static void* OurDllHandle = nullptr;
 
+typedef void (*FlushLogFunction)();
+
+// Submits the log messages batched by managed code.
+static FlushLogFunction FlushManagedLog = nullptr;
+
 // Entry point query from managed code.
 static void* GetEntryPoint(const UCS2CHAR* EntryPoint)
 {
@@ -67,6 +116,16 @@ bool TryLoadLibraryFunction(void* LibraryHandle, TCHAR* FunctionName, TFunc& Fun
 
 void FDotNetModule::StartupModule()
 {
+#if DOTNET_BINDING_STATS
+	FDotNetBindingStats::Startup();
+#endif
+
+	FDotNetFrameArena::Startup();
+
+	UeLog_SyncVerbosity();
+
+	TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FDotNetModule::Tick));
+
 	// TODO: Check what happens in shipped builds, at first I though they were always statically linked.
 	auto moduleDllPath = FModuleManager::Get().GetModuleFilename("DotNet");
 
@@ -146,6 +205,37 @@ void FDotNetModule::StartupModule()
 
 	RuntimeInitializer(GetEntryPoint);
 
+	FlushManagedLog = static_cast<FlushLogFunction>(HostInstance->GetDelegate(
+		"Unreal.Core", "Unreal.Core.UeLog", "FlushNative"));
+
+	FDotNetGcPacing::Startup(
+		static_cast<FDotNetGcPacing::FTickFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.GcPacing", "TickNative")),
+		static_cast<FDotNetGcPacing::FTryEnterNoGcRegionFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.GcPacing", "TryEnterNoGcRegionNative")),
+		static_cast<FDotNetGcPacing::FExitNoGcRegionFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.GcPacing", "ExitNoGcRegionNative")));
+
+	FDotNetGameThreadContext::Startup(static_cast<FDotNetGameThreadContext::FPumpFunction>(HostInstance->GetDelegate(
+		"Unreal.Core", "Unreal.Core.GameThreadSynchronizationContext", "PumpNative")));
+
+	FDotNetTickManager::Startup(
+		static_cast<FDotNetTickManager::FBeginFrameFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.TickManager", "BeginFrameNative")),
+		static_cast<FDotNetTickManager::FDispatchFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.TickManager", "DispatchNative")));
+
+	FDotNetEventQueue::Startup(static_cast<FDotNetEventQueue::FDispatchFunction>(HostInstance->GetDelegate(
+		"Unreal.Core", "Unreal.Core.NativeEvents", "DispatchNative")));
+
+#if DOTNET_GC_TELEMETRY
+	FDotNetGcTelemetry::Startup(
+		static_cast<FDotNetGcTelemetry::FEnableFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.GcTelemetry", "EnableNative")),
+		static_cast<FDotNetGcTelemetry::FDrainFunction>(HostInstance->GetDelegate(
+			"Unreal.Core", "Unreal.Core.GcTelemetry", "DrainNative")));
+#endif
+
 	return;
 fail:
 	if (CoreClrLibraryHandle != nullptr)
@@ -169,7 +259,22 @@ fail:
 	// Initialize Core RT.
 	CoreRT_StaticInitialization();
 
-	Unreal_Core__Runtime__Init(GetEntryPoint)
+	Unreal_Core__Runtime__Init(GetEntryPoint);
+
+	FlushManagedLog = &Unreal_Core__UeLog__Flush;
+
+	FDotNetGcPacing::Startup(&Unreal_Core__GcPacing__Tick, &Unreal_Core__GcPacing__TryEnterNoGcRegion,
+		&Unreal_Core__GcPacing__ExitNoGcRegion);
+
+	FDotNetGameThreadContext::Startup(&Unreal_Core__GameThreadSynchronizationContext__Pump);
+
+	FDotNetTickManager::Startup(&Unreal_Core__TickManager__BeginFrame, &Unreal_Core__TickManager__Dispatch);
+
+	FDotNetEventQueue::Startup(&Unreal_Core__NativeEvents__Dispatch);
+
+#if DOTNET_GC_TELEMETRY
+	FDotNetGcTelemetry::Startup(&Unreal_Core__GcTelemetry__Enable, &Unreal_Core__GcTelemetry__Drain);
+#endif
 #endif
 }
 
@@ -178,6 +283,27 @@ void FDotNetModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module. For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+#if DOTNET_BINDING_STATS
+	FDotNetBindingStats::Shutdown();
+#endif
+
+	FDotNetFrameArena::Shutdown();
+
+	FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	if (FlushManagedLog)
+		FlushManagedLog();
+	FlushManagedLog = nullptr;
+
+	FDotNetGcPacing::Shutdown();
+	FDotNetGameThreadContext::Shutdown();
+	FDotNetTickManager::Shutdown();
+	FDotNetEventQueue::Shutdown();
+
+#if DOTNET_GC_TELEMETRY
+	FDotNetGcTelemetry::Shutdown();
+#endif
+
 	if (HostInstance)
 		delete HostInstance;
 
@@ -188,6 +314,20 @@ void FDotNetModule::ShutdownModule()
 	CoreClrLibraryHandle = nullptr;
 }
 
+bool FDotNetModule::Tick(float DeltaTime)
+{
+	UeLog_SyncVerbosity();
+	if (FlushManagedLog)
+		FlushManagedLog();
+
+	FDotNetGcPacing::Tick();
+	FDotNetEventQueue::Drain();
+	FDotNetGameThreadContext::Pump();
+	FDotNetTickManager::BeginFrame();
+
+	return true;
+}
+
 void* FDotNetModule::GetManagedEntryPoint(char* Assembly, char* Type, char* Function) const
 {
 	const auto Entry = EntryGetter(Assembly, Type, Function);
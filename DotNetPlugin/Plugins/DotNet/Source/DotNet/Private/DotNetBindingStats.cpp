@@ -0,0 +1,256 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetBindingStats.h"
+
+#if DOTNET_BINDING_STATS
+
+#include "DotNet.h"
+#include "DotNetStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Binding Calls"), STAT_DotNetBindingCalls, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bindings Called"), STAT_DotNetBindingsCalled, STATGROUP_DotNet);
+
+namespace
+{
+	/** Aggregated state, everything but registration is only touched by the game thread. */
+	struct FBindingStatsState
+	{
+		/** Guards the names and the list of threads. */
+		FCriticalSection Mutex;
+
+		TArray<const ANSICHAR*> Names;
+
+		/** Counters of live threads, and of threads that exited since the last aggregation. */
+		TArray<TPair<FDotNetBindingStats::FThreadStats*, bool>> Threads;
+
+		/** Calls made by threads that have exited, per binding. */
+		TArray<uint64> RetiredCalls;
+
+		/** Calls as of the last aggregation, per binding. */
+		TArray<uint64> TotalCalls;
+
+		/** Latency histogram of each binding, HistogramBuckets per binding. */
+		TArray<uint64> Histograms;
+
+#if STATS
+		TArray<TStatId> StatIds;
+#endif
+
+		FDelegateHandle EndFrameHandle;
+	};
+
+	FBindingStatsState& GetState()
+	{
+		static FBindingStatsState State;
+		return State;
+	}
+
+	/** Owns the counters of a thread and hands them to the aggregation when the thread exits. */
+	struct FThreadStatsHolder
+	{
+		FDotNetBindingStats::FThreadStats* Stats;
+
+		FThreadStatsHolder()
+			: Stats(new FDotNetBindingStats::FThreadStats())
+		{
+			FBindingStatsState& State = GetState();
+			FScopeLock Lock(&State.Mutex);
+			State.Threads.Emplace(Stats, false);
+		}
+
+		~FThreadStatsHolder()
+		{
+			FBindingStatsState& State = GetState();
+			FScopeLock Lock(&State.Mutex);
+
+			for (auto& Thread : State.Threads)
+			{
+				if (Thread.Key == Stats)
+					Thread.Value = true;
+			}
+		}
+	};
+
+	int32 GetBucket(const uint64 Cycles)
+	{
+		return Cycles == 0 ? 0 : FMath::Min<int32>(FMath::FloorLog2_64(Cycles) + 1, FDotNetBindingStats::HistogramBuckets - 1);
+	}
+
+	void Aggregate()
+	{
+		FBindingStatsState& State = GetState();
+		FScopeLock Lock(&State.Mutex);
+
+		const int32 NumBindings = State.Names.Num();
+
+		State.RetiredCalls.SetNumZeroed(NumBindings);
+		State.Histograms.SetNumZeroed(NumBindings * FDotNetBindingStats::HistogramBuckets);
+
+		TArray<uint64> Calls = State.RetiredCalls;
+
+		for (int32 ThreadIndex = State.Threads.Num() - 1; ThreadIndex >= 0; --ThreadIndex)
+		{
+			FDotNetBindingStats::FThreadStats* Thread = State.Threads[ThreadIndex].Key;
+			const bool bRetired = State.Threads[ThreadIndex].Value;
+
+			for (int32 Binding = 0; Binding < NumBindings; ++Binding)
+				Calls[Binding] += Thread->Calls[Binding].load(std::memory_order_relaxed);
+
+			const uint32 Written = Thread->SamplesWritten.load(std::memory_order_acquire);
+			for (uint32 Read = Thread->SamplesRead.load(std::memory_order_relaxed); Read != Written; ++Read)
+			{
+				const auto& Sample = Thread->Samples[Read % FDotNetBindingStats::MaxPendingSamples];
+				++State.Histograms[Sample.Binding * FDotNetBindingStats::HistogramBuckets + GetBucket(Sample.Cycles)];
+			}
+			Thread->SamplesRead.store(Written, std::memory_order_release);
+
+			if (bRetired)
+			{
+				for (int32 Binding = 0; Binding < NumBindings; ++Binding)
+					State.RetiredCalls[Binding] += Thread->Calls[Binding].load(std::memory_order_relaxed);
+
+				delete Thread;
+				State.Threads.RemoveAtSwap(ThreadIndex);
+			}
+		}
+
+		State.TotalCalls.SetNumZeroed(NumBindings);
+
+		uint64 FrameCalls = 0;
+		int32 BindingsCalled = 0;
+
+#if STATS
+		State.StatIds.SetNum(NumBindings);
+		const bool bPublish = FThreadStats::IsCollectingData();
+#endif
+
+		for (int32 Binding = 0; Binding < NumBindings; ++Binding)
+		{
+			const uint64 Delta = Calls[Binding] - State.TotalCalls[Binding];
+			State.TotalCalls[Binding] = Calls[Binding];
+
+			if (Delta == 0)
+				continue;
+
+			FrameCalls += Delta;
+			++BindingsCalled;
+
+#if STATS
+			if (bPublish)
+			{
+				if (State.StatIds[Binding].IsNone())
+				{
+					// A counter, the default would make it a cycle stat.
+					State.StatIds[Binding] = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_DotNet>(
+						FString(State.Names[Binding]), false);
+				}
+
+				FThreadStats::AddMessage(State.StatIds[Binding].GetName(), EStatOperation::Set, int64(Delta));
+			}
+#endif
+		}
+
+		SET_DWORD_STAT(STAT_DotNetBindingCalls, FrameCalls);
+		SET_DWORD_STAT(STAT_DotNetBindingsCalled, BindingsCalled);
+	}
+
+	/** Latency below which a fraction of the samples of a binding fall, in microseconds. */
+	double GetPercentile(const uint64* Histogram, const uint64 Samples, const double Fraction)
+	{
+		const uint64 Target = FMath::CeilToInt(Samples * Fraction);
+
+		uint64 Seen = 0;
+		for (int32 Bucket = 0; Bucket < FDotNetBindingStats::HistogramBuckets; ++Bucket)
+		{
+			Seen += Histogram[Bucket];
+			if (Seen >= Target)
+				return double(1ull << Bucket) * FPlatformTime::GetSecondsPerCycle64() * 1e6;
+		}
+
+		return 0;
+	}
+
+	void DumpBindingStats(const TArray<FString>& Args)
+	{
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50;
+
+		FBindingStatsState& State = GetState();
+		FScopeLock Lock(&State.Mutex);
+
+		TArray<int32> Bindings;
+		for (int32 Binding = 0; Binding < State.TotalCalls.Num(); ++Binding)
+		{
+			if (State.TotalCalls[Binding] > 0)
+				Bindings.Add(Binding);
+		}
+
+		Bindings.Sort([&State](const int32 A, const int32 B) { return State.TotalCalls[A] > State.TotalCalls[B]; });
+
+		UE_LOG(LogClr, Display, TEXT("%d bindings called, showing the %d most called (latencies are upper bounds):"),
+			Bindings.Num(), FMath::Min(Count, Bindings.Num()));
+		UE_LOG(LogClr, Display, TEXT("%12s %8s %10s %10s %10s  %s"), TEXT("Calls"), TEXT("Samples"), TEXT("p50 us"),
+			TEXT("p90 us"), TEXT("p99 us"), TEXT("Binding"));
+
+		for (int32 i = 0; i < Bindings.Num() && i < Count; ++i)
+		{
+			const int32 Binding = Bindings[i];
+			const uint64* Histogram = &State.Histograms[Binding * FDotNetBindingStats::HistogramBuckets];
+
+			uint64 Samples = 0;
+			for (int32 Bucket = 0; Bucket < FDotNetBindingStats::HistogramBuckets; ++Bucket)
+				Samples += Histogram[Bucket];
+
+			UE_LOG(LogClr, Display, TEXT("%12llu %8llu %10.3f %10.3f %10.3f  %s"), State.TotalCalls[Binding], Samples,
+				GetPercentile(Histogram, Samples, 0.5), GetPercentile(Histogram, Samples, 0.9),
+				GetPercentile(Histogram, Samples, 0.99), ANSI_TO_TCHAR(State.Names[Binding]));
+		}
+	}
+
+	FAutoConsoleCommand DumpBindingStatsCommand(
+		TEXT("DotNet.DumpBindingStats"),
+		TEXT("Log call counts and latency percentiles of instrumented bindings. Optionally takes the number of bindings to show."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpBindingStats));
+}
+
+void FDotNetBindingStats::FThreadStats::AddSample(const int32 Binding, const uint64 Cycles)
+{
+	const uint32 Written = SamplesWritten.load(std::memory_order_relaxed);
+	if (Written - SamplesRead.load(std::memory_order_acquire) >= uint32(MaxPendingSamples))
+		return;
+
+	Samples[Written % MaxPendingSamples] = {Binding, uint32(FMath::Min<uint64>(Cycles, MAX_uint32))};
+	SamplesWritten.store(Written + 1, std::memory_order_release);
+}
+
+int32 FDotNetBindingStats::Register(const ANSICHAR* Name)
+{
+	FBindingStatsState& State = GetState();
+	FScopeLock Lock(&State.Mutex);
+
+	if (State.Names.Num() >= MaxBindings)
+		return INDEX_NONE;
+
+	return State.Names.Add(Name);
+}
+
+FDotNetBindingStats::FThreadStats& FDotNetBindingStats::GetThreadStats()
+{
+	static thread_local FThreadStatsHolder Holder;
+	return *Holder.Stats;
+}
+
+void FDotNetBindingStats::Startup()
+{
+	GetState().EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&Aggregate);
+}
+
+void FDotNetBindingStats::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(GetState().EndFrameHandle);
+}
+
+#endif
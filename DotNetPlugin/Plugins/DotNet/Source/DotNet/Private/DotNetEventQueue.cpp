@@ -0,0 +1,103 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetEventQueue.h"
+
+#include "DotNet.h"
+#include "DotNetEventRing.h"
+#include "DotNetStats.h"
+
+#include <atomic>
+
+DECLARE_CYCLE_STAT(TEXT("Native Event Dispatch"), STAT_DotNetEventDispatch, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Native Events"), STAT_DotNetEvents, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Native Events Dropped"), STAT_DotNetEventsDropped, STATGROUP_DotNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Native Events Dropped Total"), STAT_DotNetEventsDroppedTotal, STATGROUP_DotNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Native Event Queue High Water"), STAT_DotNetEventQueueHighWater, STATGROUP_DotNet);
+
+namespace
+{
+	using FEventRing = TDotNetEventRing<FDotNetEventRecord, FDotNetEventQueue::Capacity>;
+
+	std::atomic<FEventRing*> Ring{nullptr};
+
+	/** Records of the current drain, kept between frames to avoid allocating. */
+	TArray<FDotNetEventRecord> DrainBuffer;
+
+	FDotNetEventQueue::FDispatchFunction DispatchFunction = nullptr;
+
+	std::atomic<int32> Dropped{0};
+
+	/** Most events drained at once, the queue is only drained once per frame so that is its deepest. */
+	int32 HighWater = 0;
+
+	bool bWasDropping = false;
+}
+
+bool FDotNetEventQueue::Enqueue(const int32 Type, const void* Payload, const int32 Size)
+{
+	check(Size >= 0 && Size <= FDotNetEventRecord::MaxPayloadSize);
+
+	FEventRing* Events = Ring.load(std::memory_order_acquire);
+	if (Events == nullptr || !Events->Enqueue(Type, Payload, Size))
+	{
+		Dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	return true;
+}
+
+void FDotNetEventQueue::Startup(const FDispatchFunction Dispatch)
+{
+	if (Dispatch == nullptr)
+	{
+		UE_LOG(LogClr, Warning, TEXT("Native event entry point could not be loaded, native events will be dropped."));
+		return;
+	}
+
+	DispatchFunction = Dispatch;
+	DrainBuffer.SetNumUninitialized(Capacity);
+	Ring.store(new FEventRing(), std::memory_order_release);
+}
+
+void FDotNetEventQueue::Shutdown()
+{
+	// Producers may still be running, the ring is leaked rather than freed under them.
+	Ring.store(nullptr, std::memory_order_release);
+	DispatchFunction = nullptr;
+	DrainBuffer.Empty();
+}
+
+void FDotNetEventQueue::Drain()
+{
+	const int32 FrameDropped = Dropped.exchange(0, std::memory_order_relaxed);
+	INC_DWORD_STAT_BY(STAT_DotNetEventsDropped, FrameDropped);
+	INC_DWORD_STAT_BY(STAT_DotNetEventsDroppedTotal, FrameDropped);
+
+	if (bWasDropping != (FrameDropped > 0))
+	{
+		bWasDropping = FrameDropped > 0;
+		if (bWasDropping)
+			UE_LOG(LogClr, Warning, TEXT("Native event queue is full, %d events were dropped this frame."), FrameDropped);
+	}
+
+	FEventRing* Events = Ring.load(std::memory_order_acquire);
+	if (Events == nullptr)
+		return;
+
+	const int32 Count = Events->Dequeue(DrainBuffer.GetData(), Capacity);
+	INC_DWORD_STAT_BY(STAT_DotNetEvents, Count);
+
+	if (Count > HighWater)
+	{
+		HighWater = Count;
+		SET_DWORD_STAT(STAT_DotNetEventQueueHighWater, HighWater);
+	}
+
+	if (Count == 0)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_DotNetEventDispatch);
+	DispatchFunction(DrainBuffer.GetData(), Count);
+}
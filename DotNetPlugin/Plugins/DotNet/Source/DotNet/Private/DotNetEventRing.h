@@ -0,0 +1,105 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+// Only depends on the standard library, the binding stand-in of Unreal.Tests builds the same ring without the engine.
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Bounded multi-producer single-consumer ring of event records.
+ *
+ * Each slot carries a sequence number telling whether it is free for the producer at a position or holds the record of
+ * that position for the consumer, so producers only contend on the enqueue position.
+ *
+ * @tparam TRecord Record with Type, Size and Payload members.
+ * @tparam Capacity Number of slots, a power of two.
+ */
+template <typename TRecord, int32_t Capacity>
+class TDotNetEventRing
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "The capacity of the event ring must be a power of two.");
+
+public:
+	TDotNetEventRing()
+	{
+		for (int32_t i = 0; i < Capacity; ++i)
+			Slots[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/** Copy an event into the ring from any thread, fails if the ring is full. */
+	bool Enqueue(const int32_t Type, const void* Payload, const int32_t Size)
+	{
+		uint64_t Position = EnqueuePosition.load(std::memory_order_relaxed);
+		FSlot* Slot;
+
+		for (;;)
+		{
+			Slot = &Slots[Position & Mask];
+			const int64_t Difference = static_cast<int64_t>(Slot->Sequence.load(std::memory_order_acquire) - Position);
+
+			if (Difference == 0)
+			{
+				if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (Difference < 0)
+			{
+				// The consumer has not freed this slot yet, the ring is full.
+				return false;
+			}
+			else
+			{
+				Position = EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		Slot->Record.Type = Type;
+		Slot->Record.Size = Size;
+		std::memcpy(Slot->Record.Payload, Payload, Size);
+
+		Slot->Sequence.store(Position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Move up to MaxCount records into a buffer, must only be called by the consumer. */
+	int32_t Dequeue(TRecord* Records, const int32_t MaxCount)
+	{
+		int32_t Count = 0;
+
+		while (Count < MaxCount)
+		{
+			FSlot& Slot = Slots[DequeuePosition & Mask];
+			if (Slot.Sequence.load(std::memory_order_acquire) != DequeuePosition + 1)
+				break;
+
+			Records[Count++] = Slot.Record;
+
+			Slot.Sequence.store(DequeuePosition + Capacity, std::memory_order_release);
+			++DequeuePosition;
+		}
+
+		return Count;
+	}
+
+private:
+	static constexpr uint64_t Mask = Capacity - 1;
+
+	struct FSlot
+	{
+		std::atomic<uint64_t> Sequence;
+		TRecord Record;
+	};
+
+	std::atomic<uint64_t> EnqueuePosition{0};
+
+	// Keep the producers' position and the consumer's one on separate cache lines.
+	uint8_t Padding[64];
+
+	uint64_t DequeuePosition = 0;
+
+	FSlot Slots[Capacity];
+};
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetFrameArena.h"
+
+#include "DotNetStats.h"
+#include "DotNetThreadArena.h"
+#include "Misc/CoreDelegates.h"
+
+#include <atomic>
+
+DECLARE_MEMORY_STAT(TEXT("Frame Arena Memory"), STAT_DotNetFrameArenaMemory, STATGROUP_DotNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frame Arena Large Allocations"), STAT_DotNetFrameArenaLarge, STATGROUP_DotNet);
+
+namespace
+{
+	/** Current frame, arenas that last allocated in an earlier frame are reset on their next allocation. */
+	std::atomic<uint64> Frame{1};
+
+	static_assert(sizeof(std::atomic<uint64>) == sizeof(uint64) && std::atomic<uint64>::is_always_lock_free,
+		"Managed code reads the frame number directly.");
+
+	FDelegateHandle EndFrameHandle;
+
+	/** Memory of the thread arenas, taken from the engine's allocator. */
+	struct FArenaMemory
+	{
+		static constexpr int64 ChunkSize = FDotNetFrameArena::ChunkSize;
+		static constexpr int64 MaxChunkAllocation = FDotNetFrameArena::MaxChunkAllocation;
+
+		static void* AllocateChunk()
+		{
+			INC_MEMORY_STAT_BY(STAT_DotNetFrameArenaMemory, ChunkSize);
+			return FMemory::Malloc(ChunkSize, PLATFORM_CACHE_LINE_SIZE);
+		}
+
+		static void FreeChunk(void* Chunk)
+		{
+			DEC_MEMORY_STAT_BY(STAT_DotNetFrameArenaMemory, ChunkSize);
+			FMemory::Free(Chunk);
+		}
+
+		static void* AllocateLarge(const int64 Size, const int32 Alignment)
+		{
+			INC_DWORD_STAT(STAT_DotNetFrameArenaLarge);
+			return FMemory::Malloc(Size, Alignment);
+		}
+
+		static void FreeLarge(void* Allocation)
+		{
+			FMemory::Free(Allocation);
+		}
+	};
+
+	void EndFrame()
+	{
+		Frame.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void* FDotNetFrameArena::Allocate(const int64 Size, const int32 Alignment)
+{
+	check(Size >= 0 && FMath::IsPowerOfTwo(Alignment) && Alignment <= PLATFORM_CACHE_LINE_SIZE);
+
+	static thread_local TDotNetThreadArena<FArenaMemory> Arena;
+	return Arena.Allocate(Size, Alignment, Frame.load(std::memory_order_relaxed));
+}
+
+void FDotNetFrameArena::Startup()
+{
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&EndFrame);
+}
+
+void FDotNetFrameArena::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+}
+
+extern "C" {
+
+DOTNET_API void* FrameArena_Allocate(int64 Size, int32 Alignment)
+{
+	return FDotNetFrameArena::Allocate(Size, Alignment);
+}
+
+/** Number of the current frame, which managed code reads to tell when it's blocks were reset. */
+DOTNET_API const uint64* FrameArena_GetFrame()
+{
+	return reinterpret_cast<const uint64*>(&Frame);
+}
+
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetGcPacing.h"
+
+#include "DotNet.h"
+#include "DotNetStats.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_MEMORY_STAT(TEXT("GC Allocated Per Frame"), STAT_DotNetGcAllocated, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Paced Collections"), STAT_DotNetGcPacedCollections, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Unpaced Collections"), STAT_DotNetGcUnpacedCollections, STATGROUP_DotNet);
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarGcPacingEnable(
+		TEXT("DotNet.GcPacing.Enable"),
+		false,
+		TEXT("Make managed gen0 collections at the start of frames, before the allocation budget runs out."));
+
+	TAutoConsoleVariable<float> CVarGcPacingBudget(
+		TEXT("DotNet.GcPacing.BudgetMB"),
+		8.0f,
+		TEXT("Managed allocations allowed between two paced collections, in megabytes."));
+
+	TAutoConsoleVariable<float> CVarGcPacingFrameNoGcRegion(
+		TEXT("DotNet.GcPacing.FrameNoGcRegionMB"),
+		0.0f,
+		TEXT("Run each frame in a managed no-GC region of this many megabytes, entered at the start of the frame.\n")
+		TEXT("Entering makes an ephemeral collection every frame, no-GC scopes within the frame are then free. 0 to disable."));
+
+	FDotNetGcPacing::FTickFunction TickFunction = nullptr;
+	FDotNetGcPacing::FTryEnterNoGcRegionFunction TryEnterNoGcRegionFunction = nullptr;
+	FDotNetGcPacing::FExitNoGcRegionFunction ExitNoGcRegionFunction = nullptr;
+
+	bool bWasUnderMemoryPressure = false;
+}
+
+void FDotNetGcPacing::Startup(const FTickFunction Tick, const FTryEnterNoGcRegionFunction TryEnterNoGcRegion,
+                              const FExitNoGcRegionFunction ExitNoGcRegion)
+{
+	if (Tick == nullptr || TryEnterNoGcRegion == nullptr || ExitNoGcRegion == nullptr)
+	{
+		UE_LOG(LogClr, Warning, TEXT("GC pacing entry points could not be loaded, collections will not be paced."));
+		return;
+	}
+
+	TickFunction = Tick;
+	TryEnterNoGcRegionFunction = TryEnterNoGcRegion;
+	ExitNoGcRegionFunction = ExitNoGcRegion;
+}
+
+void FDotNetGcPacing::Shutdown()
+{
+	TickFunction = nullptr;
+	TryEnterNoGcRegionFunction = nullptr;
+	ExitNoGcRegionFunction = nullptr;
+}
+
+void FDotNetGcPacing::Tick()
+{
+	if (TickFunction == nullptr)
+		return;
+
+	FDotNetGcFrameStats Stats;
+	TickFunction(CVarGcPacingEnable.GetValueOnGameThread(),
+		static_cast<int64>(CVarGcPacingBudget.GetValueOnGameThread() * 1024 * 1024),
+		static_cast<int64>(CVarGcPacingFrameNoGcRegion.GetValueOnGameThread() * 1024 * 1024), &Stats);
+
+	SET_MEMORY_STAT(STAT_DotNetGcAllocated, Stats.AllocatedBytes);
+	INC_DWORD_STAT_BY(STAT_DotNetGcPacedCollections, Stats.Paced);
+	INC_DWORD_STAT_BY(STAT_DotNetGcUnpacedCollections, Stats.UnpacedCollections);
+
+	if (bWasUnderMemoryPressure != (Stats.UnderMemoryPressure != 0))
+	{
+		bWasUnderMemoryPressure = Stats.UnderMemoryPressure != 0;
+		UE_LOG(LogClr, Log, TEXT("%s"), bWasUnderMemoryPressure
+			? TEXT("Memory load is high, GC pacing and no-GC regions are suspended.")
+			: TEXT("Memory load is back to normal, GC pacing and no-GC regions are resumed."));
+	}
+}
+
+bool FDotNetGcPacing::TryEnterNoGcRegion(const int64 TotalSize)
+{
+	return TryEnterNoGcRegionFunction != nullptr && TryEnterNoGcRegionFunction(TotalSize) != 0;
+}
+
+void FDotNetGcPacing::ExitNoGcRegion()
+{
+	if (ExitNoGcRegionFunction != nullptr && ExitNoGcRegionFunction() == 0)
+		UE_LOG(LogClr, Verbose, TEXT("No-GC region ended early, more was allocated than requested."));
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetGcTelemetry.h"
+
+#if DOTNET_GC_TELEMETRY
+
+#include "DotNet.h"
+#include "DotNetStats.h"
+#include "Misc/CoreDelegates.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Collections"), STAT_DotNetGcCollections, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Gen2 Collections"), STAT_DotNetGcGen2Collections, STATGROUP_DotNet);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("GC Pause (ms)"), STAT_DotNetGcPause, STATGROUP_DotNet);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("GC Longest Pause (ms)"), STAT_DotNetGcLongestPause, STATGROUP_DotNet);
+DECLARE_MEMORY_STAT(TEXT("GC Promoted"), STAT_DotNetGcPromoted, STATGROUP_DotNet);
+DECLARE_MEMORY_STAT(TEXT("GC Heap Size"), STAT_DotNetGcHeapSize, STATGROUP_DotNet);
+
+namespace
+{
+	/** Number of collections read from the managed side per call. */
+	constexpr int32 DrainBatch = 32;
+
+	FDotNetGcTelemetry::FDrainFunction DrainFunction = nullptr;
+
+	FDelegateHandle EndFrameHandle;
+
+	void Report(const FDotNetGcEvent& Event, float& LongestPauseMs)
+	{
+		const float PauseMs = Event.PauseTicks / 10000.0f;
+
+		INC_DWORD_STAT(STAT_DotNetGcCollections);
+		if (Event.Generation >= 2)
+			INC_DWORD_STAT(STAT_DotNetGcGen2Collections);
+
+		INC_FLOAT_STAT_BY(STAT_DotNetGcPause, PauseMs);
+		LongestPauseMs = FMath::Max(LongestPauseMs, PauseMs);
+		SET_MEMORY_STAT(STAT_DotNetGcPromoted, Event.PromotedBytes);
+		SET_MEMORY_STAT(STAT_DotNetGcHeapSize, Event.HeapSizeBytes);
+
+		TRACE_BOOKMARK(TEXT("DotNet GC #%lld gen%d %.2fms"), Event.Index, Event.Generation, PauseMs);
+
+		UE_LOG(LogClr, Verbose, TEXT("GC #%lld: gen%d, paused %.2fms, promoted %lld bytes, heap %lld bytes."),
+			Event.Index, Event.Generation, PauseMs, Event.PromotedBytes, Event.HeapSizeBytes);
+	}
+
+	void DrainEvents()
+	{
+		FDotNetGcEvent Events[DrainBatch];
+		float LongestPauseMs = 0;
+
+		int32 Count;
+		do
+		{
+			Count = DrainFunction(Events, DrainBatch);
+			for (int32 i = 0; i < Count; ++i)
+				Report(Events[i], LongestPauseMs);
+		}
+		while (Count == DrainBatch);
+
+		SET_FLOAT_STAT(STAT_DotNetGcLongestPause, LongestPauseMs);
+	}
+}
+
+void FDotNetGcTelemetry::Startup(const FEnableFunction Enable, const FDrainFunction Drain)
+{
+	if (Enable == nullptr || Drain == nullptr)
+	{
+		UE_LOG(LogClr, Warning, TEXT("GC telemetry entry points could not be loaded, collections will not be reported."));
+		return;
+	}
+
+	DrainFunction = Drain;
+	Enable();
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&DrainEvents);
+}
+
+void FDotNetGcTelemetry::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	DrainFunction = nullptr;
+}
+
+#endif
@@ -0,0 +1,57 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reports the garbage collections of the managed runtime to the stats system and to Unreal Insights.
+ *
+ * Collections are recorded by Unreal.Core.GcTelemetry into a ring buffer that is drained at the end of each frame, so
+ * a collection is reported in the frame it stalled (or the next one if it happened after the frame ended). Each
+ * collection adds to the DotNet stat group and places a bookmark in the trace.
+ */
+#ifndef DOTNET_GC_TELEMETRY
+#define DOTNET_GC_TELEMETRY !UE_BUILD_SHIPPING
+#endif
+
+#if DOTNET_GC_TELEMETRY
+
+/** A garbage collection, layout must match Unreal.Core.GcEvent. */
+struct FDotNetGcEvent
+{
+	/** Number of the collection since the runtime started. */
+	int64 Index;
+
+	/** Time managed threads were suspended for the collection, in ticks of 100ns. */
+	int64 PauseTicks;
+
+	/** Bytes that survived the collection. */
+	int64 PromotedBytes;
+
+	/** Size of the managed heap after the collection. */
+	int64 HeapSizeBytes;
+
+	/** Oldest generation collected. */
+	int32 Generation;
+};
+
+struct FDotNetGcTelemetry
+{
+	typedef void (*FEnableFunction)();
+
+	typedef int32 (*FDrainFunction)(FDotNetGcEvent* Events, int32 Capacity);
+
+	/**
+	 * @brief Start recording collections and reporting them at the end of each frame.
+	 * @param Enable Entry point of Unreal.Core.GcTelemetry that enables recording.
+	 * @param Drain Entry point of Unreal.Core.GcTelemetry that reads the recorded collections.
+	 */
+	static void Startup(FEnableFunction Enable, FDrainFunction Drain);
+
+	/** Stop reporting collections. */
+	static void Shutdown();
+};
+
+#endif
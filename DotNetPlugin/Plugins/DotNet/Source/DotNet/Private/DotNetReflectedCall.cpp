@@ -0,0 +1,92 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetReflectedCall.h"
+
+#include "DotNet.h"
+#include "UObject/Stack.h"
+
+UFunction* FDotNetReflectedCall::FindFunction(const TCHAR* Path, const int32 ParmsSize,
+                                              const std::initializer_list<FParameter> Parameters)
+{
+	const auto Function = FindObject<UFunction>(nullptr, Path);
+	if (!Function)
+	{
+		UE_LOG(LogClr, Error, TEXT("Could not find function %s for reflected call."), Path);
+		return nullptr;
+	}
+
+	// The generated struct is laid out by the compiler, the function's frame by the property system. Those agree for
+	// every type UHT accepts, but a mismatch would corrupt memory so check it once here.
+	auto Parameter = Parameters.begin();
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It, ++Parameter)
+	{
+		if (Parameter == Parameters.end() || Parameter->Offset != It->GetOffset_ForUFunction()
+			|| Parameter->Size != It->GetSize())
+		{
+			UE_LOG(LogClr, Error, TEXT("Parameter %s of %s does not match the generated binding, regenerate the bindings."),
+				*It->GetName(), Path);
+			return nullptr;
+		}
+	}
+
+	if (Parameter != Parameters.end())
+	{
+		UE_LOG(LogClr, Error, TEXT("Function %s has fewer parameters than the generated binding, regenerate the bindings."), Path);
+		return nullptr;
+	}
+
+	// ProcessEvent copies the whole frame out of the parameters.
+	if (Function->ParmsSize > ParmsSize)
+	{
+		UE_LOG(LogClr, Error, TEXT("Frame of %s is %d bytes but the generated binding has %d, regenerate the bindings."),
+			Path, Function->ParmsSize, ParmsSize);
+		return nullptr;
+	}
+
+	return Function;
+}
+
+void FDotNetReflectedCall::Invoke(UObject* Object, UFunction* Function, void* Parms)
+{
+	if (!ensureMsgf(Function, TEXT("Reflected call to a function that could not be resolved.")))
+		return;
+
+	if (!Object)
+		Object = Function->GetOuterUClass()->GetDefaultObject();
+
+	// Calling the thunk directly would skip replication and the authority checks done by the remote call space.
+	if (!Function->HasAnyFunctionFlags(FUNC_Native) || Function->HasAnyFunctionFlags(FUNC_Net)
+		|| Object->GetFunctionCallspace(Function, nullptr) != FunctionCallspace::Local)
+	{
+		Object->ProcessEvent(Function, Parms);
+		return;
+	}
+
+	FFrame Stack(Object, Function, Parms, nullptr, Function->ChildProperties);
+
+	// Native thunks write out parameters through the out parameter chain, same as ProcessEvent sets it up.
+	if (Function->HasAnyFunctionFlags(FUNC_HasOutParms))
+	{
+		FOutParmRec** LastOut = &Stack.OutParms;
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			if (!It->HasAnyPropertyFlags(CPF_OutParm))
+				continue;
+
+			const auto Out = static_cast<FOutParmRec*>(FMemory_Alloca(sizeof(FOutParmRec)));
+			Out->Property = *It;
+			Out->PropAddr = It->ContainerPtrToValuePtr<uint8>(Parms);
+			Out->NextOutParm = nullptr;
+
+			*LastOut = Out;
+			LastOut = &Out->NextOutParm;
+		}
+	}
+
+	const auto ReturnValueAddress = Function->ReturnValueOffset != MAX_uint16
+		? static_cast<uint8*>(Parms) + Function->ReturnValueOffset
+		: nullptr;
+
+	Function->Invoke(Object, Stack, ReturnValueAddress);
+}
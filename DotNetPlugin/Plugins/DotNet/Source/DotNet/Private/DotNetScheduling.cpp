@@ -0,0 +1,74 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetScheduling.h"
+
+#include "DotNet.h"
+#include "DotNetStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/TaskGraphInterfaces.h"
+
+#include <atomic>
+
+DECLARE_CYCLE_STAT(TEXT("Game Thread Pump"), STAT_DotNetPump, STATGROUP_DotNet);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Game Thread Callbacks"), STAT_DotNetPumpExecuted, STATGROUP_DotNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Game Thread Queue"), STAT_DotNetPumpQueue, STATGROUP_DotNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Task Graph Queue"), STAT_DotNetTaskGraphQueue, STATGROUP_DotNet);
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarPumpBudget(
+		TEXT("DotNet.GameThreadPumpBudgetMs"),
+		2.0f,
+		TEXT("Time per frame spent running managed callbacks posted to the game thread, in milliseconds. At least one ")
+		TEXT("callback is run each frame."));
+
+	FDotNetGameThreadContext::FPumpFunction PumpFunction = nullptr;
+
+	/** Managed tasks dispatched to the task graph that have not run yet. */
+	std::atomic<int32> PendingTasks{0};
+}
+
+void FDotNetGameThreadContext::Startup(const FPumpFunction Pump)
+{
+	if (Pump == nullptr)
+	{
+		UE_LOG(LogClr, Warning, TEXT("Game thread context entry point could not be loaded, awaits will not resume."));
+		return;
+	}
+
+	PumpFunction = Pump;
+}
+
+void FDotNetGameThreadContext::Shutdown()
+{
+	PumpFunction = nullptr;
+}
+
+void FDotNetGameThreadContext::Pump()
+{
+	SET_DWORD_STAT(STAT_DotNetTaskGraphQueue, PendingTasks.load(std::memory_order_relaxed));
+
+	if (PumpFunction == nullptr)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_DotNetPump);
+
+	FDotNetPumpStats Stats;
+	PumpFunction(static_cast<int64>(CVarPumpBudget.GetValueOnGameThread() * 1000), &Stats);
+
+	INC_DWORD_STAT_BY(STAT_DotNetPumpExecuted, Stats.Executed);
+	SET_DWORD_STAT(STAT_DotNetPumpQueue, Stats.Remaining);
+}
+
+/** Run a managed work item on a worker of the task graph, used by Unreal.Core.TaskGraphScheduler. */
+extern "C" DOTNET_API void TaskGraph_Dispatch(void (*Execute)(void*), void* Task)
+{
+	PendingTasks.fetch_add(1, std::memory_order_relaxed);
+
+	FFunctionGraphTask::CreateAndDispatchWhenReady([Execute, Task]()
+	{
+		PendingTasks.fetch_sub(1, std::memory_order_relaxed);
+		Execute(Task);
+	}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Result of a pump of the game thread context, layout must match Unreal.Core.PumpStats. */
+struct FDotNetPumpStats
+{
+	/** Number of callbacks run. */
+	int32 Executed;
+
+	/** Number of callbacks left in the queue for the next pump. */
+	int32 Remaining;
+};
+
+/**
+ * Pumps Unreal.Core.GameThreadSynchronizationContext once per frame, within the time budget set by
+ * DotNet.GameThreadPumpBudgetMs.
+ */
+struct FDotNetGameThreadContext
+{
+	typedef void (*FPumpFunction)(int64 BudgetMicroseconds, FDotNetPumpStats* Stats);
+
+	/** Start pumping with the given entry point of the context. */
+	static void Startup(FPumpFunction Pump);
+
+	/** Stop pumping. */
+	static void Shutdown();
+
+	/** Run the callbacks posted to the game thread, done once per frame by the module. */
+	static void Pump();
+};
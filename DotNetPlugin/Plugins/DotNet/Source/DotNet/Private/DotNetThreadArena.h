@@ -0,0 +1,94 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+// Only depends on the standard library, the binding stand-in of Unreal.Tests builds the same arena without the engine.
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Chunks of a single thread of the frame arena, only ever touched by that thread.
+ *
+ * @tparam TMemory Provides ChunkSize, MaxChunkAllocation, and AllocateChunk, FreeChunk, AllocateLarge and FreeLarge to
+ * get memory from the system allocator.
+ */
+template <typename TMemory>
+class TDotNetThreadArena
+{
+public:
+	~TDotNetThreadArena()
+	{
+		Reset();
+
+		for (uint8_t* Chunk : Chunks)
+			TMemory::FreeChunk(Chunk);
+	}
+
+	/**
+	 * @brief Allocate from the thread's chunks, resetting them first if they were last used in an earlier frame.
+	 * @param Size Size of the allocation in bytes.
+	 * @param Alignment Alignment of the allocation, a power of two no larger than the alignment of chunks.
+	 * @param Frame Current frame.
+	 */
+	void* Allocate(const int64_t Size, const int32_t Alignment, const uint64_t Frame)
+	{
+		if (LastFrame != Frame)
+		{
+			LastFrame = Frame;
+			Reset();
+		}
+
+		if (Size > TMemory::MaxChunkAllocation)
+		{
+			LargeAllocations.push_back(TMemory::AllocateLarge(Size, Alignment));
+			return LargeAllocations.back();
+		}
+
+		uint8_t* Result = Align(Cursor, Alignment);
+		if (Result == nullptr || Result + Size > End)
+		{
+			if (++Current == static_cast<int64_t>(Chunks.size()))
+				Chunks.push_back(static_cast<uint8_t*>(TMemory::AllocateChunk()));
+
+			End = Chunks[Current] + TMemory::ChunkSize;
+			Result = Align(Chunks[Current], Alignment);
+		}
+
+		Cursor = Result + Size;
+		return Result;
+	}
+
+private:
+	void Reset()
+	{
+		Current = -1;
+		Cursor = End = nullptr;
+
+		for (void* Allocation : LargeAllocations)
+			TMemory::FreeLarge(Allocation);
+
+		LargeAllocations.clear();
+	}
+
+	static uint8_t* Align(uint8_t* Pointer, const int32_t Alignment)
+	{
+		return reinterpret_cast<uint8_t*>(
+			(reinterpret_cast<uintptr_t>(Pointer) + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1));
+	}
+
+	/** Chunks of the thread, kept across frames. */
+	std::vector<uint8_t*> Chunks;
+
+	/** Allocations too large for a chunk made since the last reset. */
+	std::vector<void*> LargeAllocations;
+
+	/** Index of the chunk being allocated from, -1 before the first allocation. */
+	int64_t Current = -1;
+
+	uint8_t* Cursor = nullptr;
+	uint8_t* End = nullptr;
+
+	uint64_t LastFrame = 0;
+};
@@ -0,0 +1,147 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "DotNetTickManager.h"
+
+#include "DotNet.h"
+#include "DotNetStats.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Managed Tick"), STAT_DotNetTick, STATGROUP_DotNet);
+
+namespace
+{
+	/** Groups managed objects can tick in, must match Unreal.Core.TickGroup. */
+	constexpr int32 GroupCount = TG_LastDemotable + 1;
+
+	FDotNetTickManager::FBeginFrameFunction BeginFrameFunction = nullptr;
+	FDotNetTickManager::FDispatchFunction DispatchFunction = nullptr;
+
+	/** Ticks the managed objects of a group. */
+	struct FDotNetGroupTickFunction : FTickFunction
+	{
+		virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+		                         const FGraphEventRef& MyCompletionGraphEvent) override
+		{
+			if (DispatchFunction == nullptr)
+				return;
+
+			SCOPE_CYCLE_COUNTER(STAT_DotNetTick);
+			DispatchFunction(static_cast<uint8>(TickGroup.GetValue()), DeltaTime);
+		}
+
+		virtual FString DiagnosticMessage() override
+		{
+			return FString::Printf(TEXT("DotNet managed tick (group %d)"), static_cast<int32>(TickGroup.GetValue()));
+		}
+	};
+
+	FDotNetGroupTickFunction TickFunctions[GroupCount];
+
+	/** World the tick functions are registered in. */
+	UWorld* TickWorld = nullptr;
+
+	FDelegateHandle PostWorldInitializationHandle;
+	FDelegateHandle WorldCleanupHandle;
+
+	void RegisterTickFunctions(UWorld* World)
+	{
+		if (TickWorld != nullptr || !World->IsGameWorld())
+			return;
+
+		TickWorld = World;
+		for (FDotNetGroupTickFunction& TickFunction : TickFunctions)
+			TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	void UnregisterTickFunctions()
+	{
+		if (TickWorld == nullptr)
+			return;
+
+		for (FDotNetGroupTickFunction& TickFunction : TickFunctions)
+			TickFunction.UnRegisterTickFunction();
+		TickWorld = nullptr;
+	}
+
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues)
+	{
+		RegisterTickFunctions(World);
+	}
+
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+	{
+		if (World != TickWorld)
+			return;
+
+		UnregisterTickFunctions();
+
+		// Carry on in another game world if there is one, like a second PIE instance.
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* Other = Context.World();
+			if (Other != nullptr && Other != World && Other->bIsWorldInitialized)
+			{
+				RegisterTickFunctions(Other);
+				if (TickWorld != nullptr)
+					break;
+			}
+		}
+	}
+}
+
+void FDotNetTickManager::Startup(const FBeginFrameFunction BeginFrame, const FDispatchFunction Dispatch)
+{
+	if (BeginFrame == nullptr || Dispatch == nullptr)
+	{
+		UE_LOG(LogClr, Warning, TEXT("Tick manager entry points could not be loaded, managed objects will not tick."));
+		return;
+	}
+
+	BeginFrameFunction = BeginFrame;
+	DispatchFunction = Dispatch;
+
+	for (int32 Group = 0; Group < GroupCount; ++Group)
+	{
+		FDotNetGroupTickFunction& TickFunction = TickFunctions[Group];
+		TickFunction.TickGroup = static_cast<ETickingGroup>(Group);
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = false;
+		TickFunction.bTickEvenWhenPaused = false;
+	}
+
+	PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddStatic(&OnPostWorldInitialization);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&OnWorldCleanup);
+}
+
+void FDotNetTickManager::Shutdown()
+{
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+	UnregisterTickFunctions();
+
+	BeginFrameFunction = nullptr;
+	DispatchFunction = nullptr;
+}
+
+void FDotNetTickManager::BeginFrame()
+{
+	if (BeginFrameFunction == nullptr)
+		return;
+
+	const uint32 Mask = BeginFrameFunction();
+
+	if (TickWorld == nullptr)
+		return;
+
+	for (int32 Group = 0; Group < GroupCount; ++Group)
+	{
+		const bool bEnabled = (Mask & (1u << Group)) != 0;
+		if (TickFunctions[Group].IsTickFunctionEnabled() != bEnabled)
+			TickFunctions[Group].SetTickFunctionEnable(bEnabled);
+	}
+}
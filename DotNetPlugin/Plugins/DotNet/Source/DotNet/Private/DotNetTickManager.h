@@ -0,0 +1,30 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Ticks managed objects registered with Unreal.Core.TickManager, making one call into managed code per tick group and
+ * frame.
+ *
+ * A tick function per group is registered in the first game world and moves to the next one when that world is
+ * cleaned up. At the start of each frame the registrations made by managed code are applied and the tick functions of
+ * empty groups are disabled.
+ */
+struct FDotNetTickManager
+{
+	typedef uint32 (*FBeginFrameFunction)();
+
+	typedef void (*FDispatchFunction)(uint8 Group, float DeltaTime);
+
+	/** Start ticking with the given entry points of the tick manager. */
+	static void Startup(FBeginFrameFunction BeginFrame, FDispatchFunction Dispatch);
+
+	/** Stop ticking and unregister the tick functions. */
+	static void Shutdown();
+
+	/** Apply pending registrations, done once per frame by the module. */
+	static void BeginFrame();
+};
@@ -3,18 +3,84 @@
 
 #include "NativeHelper.h"
 
+#include "DotNet.h"
+
 extern "C" DOTNET_API IManagedObject* NativeHelper_Cast_UObject_IManagedObject(UObject* Object)
 {
 	return dynamic_cast<IManagedObject*>(Object);
 }
 
+/**
+ * Names a private member, the engine does not expose the chunk table of GUObjectArray. Access is not checked for the
+ * arguments of explicit instantiations, so the instantiation below hands out a pointer to the member.
+ */
+template <typename TTag, typename TTag::FType Member>
+struct TPrivateMember
+{
+	friend typename TTag::FType GetPrivateMember(TTag)
+	{
+		return Member;
+	}
+};
+
+struct FObjectChunksTag
+{
+	using FType = FUObjectItem** FChunkedFixedUObjectArray::*;
+	friend FType GetPrivateMember(FObjectChunksTag);
+};
+
+template struct TPrivateMember<FObjectChunksTag, &FChunkedFixedUObjectArray::Objects>;
+
 class FContextObjectManager
 {
 public:
+	/** Items per chunk of GUObjectArray, checked against IndexToObject before managed code relies on it. */
+	static constexpr int32 ElementsPerChunk = 64 * 1024;
+
+	/** Table of the chunks of GUObjectArray, null until the object array is allocated. */
+	static FUObjectItem* const* GetObjectChunks()
+	{
+		return GUObjectArray.GetObjectItemArrayUnsafe().*GetPrivateMember(FObjectChunksTag());
+	}
+
+	/** Whether an item is found at the same address through the chunk table and through the engine. */
+	static bool CheckChunks(FUObjectItem* const* Chunks, const int32 Index)
+	{
+		return Chunks[Index / ElementsPerChunk] + Index % ElementsPerChunk == GUObjectArray.IndexToObject(Index);
+	}
+
 	static size_t GetClassOffset()
 	{
 		return offsetof(UObject, ClassPrivate);
 	}
+
+	static size_t GetInternalIndexOffset()
+	{
+		return offsetof(UObject, InternalIndex);
+	}
+};
+
+/** Layout of GUObjectArray, managed code reads it directly to check whether objects are alive. */
+struct FDotNetObjectArrayLayout
+{
+	/**
+	 * Table of the chunks of object items, allocated once.
+	 * Null if items must be looked up with NativeHelper_GetObjectItem.
+	 */
+	FUObjectItem* const* Chunks;
+
+	int32 ElementsPerChunk;
+	int32 MaxElements;
+	int32 ItemSize;
+	int32 ObjectOffset;
+	int32 FlagsOffset;
+	int32 SerialNumberOffset;
+
+	/** Internal flags of objects that are considered dead. */
+	int32 DeadFlags;
+
+	/** Offset of the index of an object in the array, from the start of the object. */
+	int32 InternalIndexOffset;
 };
 
 extern "C" DOTNET_API size_t UObject_GetFieldOffset_UClass()
@@ -46,3 +112,40 @@ extern "C" DOTNET_API UObject* NativeHelper_CreateUObject(UClass* Class, UObject
 {
 	return NewObject<UObject>(Outer, Class);
 }
+
+extern "C" DOTNET_API int32 NativeHelper_GetObjectSerialNumber(UObject* Object, int32* OutIndex)
+{
+	const int32 Index = GUObjectArray.ObjectToIndex(Object);
+	*OutIndex = Index;
+	return GUObjectArray.AllocateSerialNumber(Index);
+}
+
+extern "C" DOTNET_API FUObjectItem* NativeHelper_GetObjectItem(int32 Index)
+{
+	return GUObjectArray.IndexToObject(Index);
+}
+
+extern "C" DOTNET_API void NativeHelper_GetObjectArrayLayout(FDotNetObjectArrayLayout* OutLayout)
+{
+	FUObjectItem* const* Chunks = FContextObjectManager::GetObjectChunks();
+
+	// The chunk size is private to the engine, make sure items are where it puts them before reading them directly.
+	const int32 LastIndex = GUObjectArray.GetObjectArrayNum() - 1;
+	if (Chunks == nullptr || LastIndex < 0
+		|| !FContextObjectManager::CheckChunks(Chunks, 0) || !FContextObjectManager::CheckChunks(Chunks, LastIndex))
+	{
+		UE_LOG(LogClr, Warning,
+			TEXT("Object array layout is not the expected one, object liveness checks will call into the engine."));
+		Chunks = nullptr;
+	}
+
+	OutLayout->Chunks = Chunks;
+	OutLayout->ElementsPerChunk = FContextObjectManager::ElementsPerChunk;
+	OutLayout->MaxElements = GUObjectArray.GetObjectArrayCapacity();
+	OutLayout->ItemSize = sizeof(FUObjectItem);
+	OutLayout->ObjectOffset = STRUCT_OFFSET(FUObjectItem, Object);
+	OutLayout->FlagsOffset = STRUCT_OFFSET(FUObjectItem, Flags);
+	OutLayout->SerialNumberOffset = STRUCT_OFFSET(FUObjectItem, SerialNumber);
+	OutLayout->DeadFlags = int32(EInternalObjectFlags::Unreachable | EInternalObjectFlags::PendingKill);
+	OutLayout->InternalIndexOffset = FContextObjectManager::GetInternalIndexOffset();
+}
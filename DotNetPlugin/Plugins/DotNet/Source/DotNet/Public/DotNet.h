@@ -32,6 +32,11 @@ public:
 	void* GetManagedEntryPoint(char* Assembly, char* Type, char* Function) const;
 
 private:
+	/** Per-frame work of the module, run by the core ticker at the start of each frame. */
+	bool Tick(float DeltaTime);
+
+	FDelegateHandle TickHandle;
+
 	/** Handle to the test dll we will load */
 	void* CoreClrLibraryHandle = nullptr;
 
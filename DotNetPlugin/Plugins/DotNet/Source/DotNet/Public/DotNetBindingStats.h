@@ -0,0 +1,129 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Call counters and latency histograms for generated bindings.
+ *
+ * Bindings generated with UnrealBindingInstrumentation enabled open a DOTNET_BINDING_SCOPE on the native side of each
+ * call, in both directions. Calls are counted per thread without synchronization and one call in SampleInterval is
+ * timed. Counters and samples are aggregated once per frame on the game thread, published to the DotNet stat group and
+ * dumped with DotNet.DumpBindingStats.
+ *
+ * Instrumentation is compiled out unless DOTNET_BINDING_STATS is set, which it is whenever stats are enabled. Without
+ * it the scope expands to nothing, so instrumented bindings cost the same as plain ones.
+ */
+#ifndef DOTNET_BINDING_STATS
+#define DOTNET_BINDING_STATS STATS
+#endif
+
+#if DOTNET_BINDING_STATS
+
+struct DOTNET_API FDotNetBindingStats
+{
+	/** Maximum number of distinct bindings, calls to bindings registered past this are not recorded. */
+	static constexpr int32 MaxBindings = 16 * 1024;
+
+	/** One call in this many is timed. */
+	static constexpr int32 SampleInterval = 64;
+
+	/** Number of histogram buckets, bucket N holds latencies in [2^(N-1), 2^N) cycles. */
+	static constexpr int32 HistogramBuckets = 32;
+
+	/** Number of timed samples each thread can hold between two aggregations, later ones are dropped. */
+	static constexpr int32 MaxPendingSamples = 4096;
+
+	/** Counters of a single thread, only ever written by that thread. */
+	struct FThreadStats
+	{
+		struct FSample
+		{
+			int32 Binding;
+			uint32 Cycles;
+		};
+
+		/** Calls since the thread started, per binding. 64 bit so the per frame deltas never see a wrap. */
+		std::atomic<uint64> Calls[MaxBindings] = {};
+
+		/** Calls left until the next one is timed. */
+		int32 SampleCountdown = SampleInterval;
+
+		/** Ring of timed calls, written by the thread and read by the aggregation. */
+		FSample Samples[MaxPendingSamples];
+		std::atomic<uint32> SamplesWritten{0};
+		std::atomic<uint32> SamplesRead{0};
+
+		FORCEINLINE void Count(int32 Binding)
+		{
+			// Single writer, no need for an atomic increment.
+			Calls[Binding].store(Calls[Binding].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		void AddSample(int32 Binding, uint64 Cycles);
+	};
+
+	/**
+	 * @brief Register a binding, done once by each instrumented binding on its first call.
+	 * @param Name Name of the binding, must outlive the module.
+	 * @return Index of the binding, or INDEX_NONE if there are too many bindings.
+	 */
+	static int32 Register(const ANSICHAR* Name);
+
+	/** Counters of the calling thread. */
+	static FThreadStats& GetThreadStats();
+
+	/** Start aggregating at the end of each frame. */
+	static void Startup();
+
+	/** Stop aggregating. */
+	static void Shutdown();
+};
+
+/**
+ * Records a call to a binding for the duration of the scope.
+ */
+class FDotNetBindingScope
+{
+public:
+	FORCEINLINE explicit FDotNetBindingScope(const int32 InBinding)
+		: Binding(InBinding)
+	{
+		if (Binding == INDEX_NONE)
+			return;
+
+		Stats = &FDotNetBindingStats::GetThreadStats();
+		Stats->Count(Binding);
+
+		if (--Stats->SampleCountdown == 0)
+		{
+			Stats->SampleCountdown = FDotNetBindingStats::SampleInterval;
+			StartCycles = FPlatformTime::Cycles64();
+		}
+	}
+
+	FORCEINLINE ~FDotNetBindingScope()
+	{
+		if (StartCycles)
+			Stats->AddSample(Binding, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	const int32 Binding;
+	FDotNetBindingStats::FThreadStats* Stats = nullptr;
+	uint64 StartCycles = 0;
+};
+
+#define DOTNET_BINDING_SCOPE(Name) \
+	static const int32 DotNetBindingId = FDotNetBindingStats::Register(Name); \
+	const FDotNetBindingScope DotNetBindingScope(DotNetBindingId)
+
+#else
+
+#define DOTNET_BINDING_SCOPE(Name)
+
+#endif
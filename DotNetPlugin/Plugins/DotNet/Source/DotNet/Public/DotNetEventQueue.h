@@ -0,0 +1,69 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <type_traits>
+
+/** An event raised by native code for managed code, layout must match Unreal.Core.NativeEvent. */
+struct FDotNetEventRecord
+{
+	/** Largest payload a record can carry. */
+	static constexpr int32 MaxPayloadSize = 56;
+
+	/** Type of the event, managed handlers subscribe to a type. */
+	int32 Type;
+
+	/** Size of the payload in bytes. */
+	int32 Size;
+
+	/** Trivially copyable data of the event. */
+	alignas(8) uint8 Payload[MaxPayloadSize];
+};
+
+static_assert(sizeof(FDotNetEventRecord) == 64, "Event records must match the layout of Unreal.Core.NativeEvent.");
+
+/**
+ * Queue of events raised by native code on any thread, delivered to managed code on the game thread.
+ *
+ * Producers push fixed size records into a lock-free bounded ring, which the DotNet module drains once per frame and
+ * hands to Unreal.Core.NativeEvents in a single call. When the ring is full, events are dropped and Enqueue returns
+ * false so producers can apply back-pressure. Drained and dropped events, and the most events the queue held at once,
+ * are published to the DotNet stat group.
+ */
+struct DOTNET_API FDotNetEventQueue
+{
+	/** Number of events the queue can hold between two frames. */
+	static constexpr int32 Capacity = 8192;
+
+	typedef void (*FDispatchFunction)(const FDotNetEventRecord* Events, int32 Count);
+
+	/**
+	 * @brief Queue an event for managed code, can be called from any thread.
+	 * @param Type Type of the event.
+	 * @param Payload Data of the event, copied into the record.
+	 * @param Size Size of the data, at most FDotNetEventRecord::MaxPayloadSize bytes.
+	 * @return Whether the event was queued, false if the queue is full.
+	 */
+	static bool Enqueue(int32 Type, const void* Payload, int32 Size);
+
+	/** Queue an event with a trivially copyable payload. */
+	template <typename TPayload>
+	static bool Enqueue(const int32 Type, const TPayload& Payload)
+	{
+		static_assert(std::is_trivially_copyable<TPayload>::value, "Event payloads must be trivially copyable.");
+		static_assert(sizeof(TPayload) <= FDotNetEventRecord::MaxPayloadSize, "Event payload is too large.");
+		return Enqueue(Type, &Payload, sizeof(TPayload));
+	}
+
+	/** Start delivering events to the given entry point of Unreal.Core.NativeEvents. */
+	static void Startup(FDispatchFunction Dispatch);
+
+	/** Stop delivering events, events queued afterwards are dropped. */
+	static void Shutdown();
+
+	/** Deliver the queued events to managed code, done once per frame by the module. */
+	static void Drain();
+};
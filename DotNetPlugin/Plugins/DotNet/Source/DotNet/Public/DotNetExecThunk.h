@@ -0,0 +1,70 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Script.h"
+#include "UObject/Stack.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * Support for the generated exec thunks of managed UFunctions.
+ *
+ * Managed UFunctions are declared with CustomThunk, their thunk reads the parameters from the Blueprint VM frame and
+ * calls the managed entry point directly.
+ */
+struct FDotNetExecThunk
+{
+	/**
+	 * @brief Step over the next parameter of a frame.
+	 *
+	 * Like P_GET_PROPERTY_REF, the returned reference points into the caller's frame when the value lives there, which
+	 * avoids copying it, otherwise the value is evaluated into the temporary.
+	 *
+	 * @param Stack Frame of the call.
+	 * @param Temporary Storage for the value if it has to be evaluated.
+	 * @return Reference to the parameter value.
+	 */
+	template <typename T>
+	static FORCEINLINE T& StepParameter(FFrame& Stack, T& Temporary)
+	{
+		return Stack.StepCompiledInRef<FProperty, T>(&Temporary);
+	}
+
+	/**
+	 * @brief Step over the next out or ref parameter of a frame.
+	 *
+	 * Same as StepParameter but bools are referenced like P_GET_UBOOL_REF so the callee's writes reach the caller.
+	 *
+	 * @param Stack Frame of the call.
+	 * @param Temporary Storage for the value if it has to be evaluated.
+	 * @return Reference to the parameter value.
+	 */
+	template <typename T>
+	static FORCEINLINE T& StepOutParameter(FFrame& Stack, T& Temporary)
+	{
+		return Stack.StepCompiledInRef<FProperty, T>(&Temporary);
+	}
+};
+
+/**
+ * Bool properties may be bitfields, so in parameters are read by value like P_GET_UBOOL does.
+ */
+template <>
+FORCEINLINE bool& FDotNetExecThunk::StepParameter<bool>(FFrame& Stack, bool& Temporary)
+{
+	uint32 Value = 0;
+	Stack.StepCompiledIn<FBoolProperty>(&Value);
+	Temporary = !!Value;
+	return Temporary;
+}
+
+/**
+ * Bool out parameters are always native bools, so they can be referenced in place.
+ */
+template <>
+FORCEINLINE bool& FDotNetExecThunk::StepOutParameter<bool>(FFrame& Stack, bool& Temporary)
+{
+	return Stack.StepCompiledInRef<FBoolProperty, bool>(&Temporary);
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear allocator for transient interop data, such as argument arrays and string conversions, reset every frame.
+ *
+ * Each thread allocates from it's own chunks without synchronization. Chunks are kept across frames, so once the
+ * arena has grown to the needs of a frame allocations no longer reach the system allocator. Memory allocated in a
+ * frame is valid until the end of that frame, and on worker threads only until the thread next allocates in a later
+ * frame, so it must not be held across frames. Managed code allocates from the same arena with
+ * Unreal.Core.FrameAllocator.
+ */
+struct DOTNET_API FDotNetFrameArena
+{
+	/** Size of the chunks threads allocate from. */
+	static constexpr int64 ChunkSize = 256 * 1024;
+
+	/** Allocations larger than this get a block of their own, freed when the thread's arena is reset. */
+	static constexpr int64 MaxChunkAllocation = ChunkSize / 4;
+
+	/**
+	 * @brief Allocate memory valid until the end of the frame, can be called from any thread.
+	 * @param Size Size of the allocation in bytes.
+	 * @param Alignment Alignment of the allocation, a power of two.
+	 * @return The allocation, never null.
+	 */
+	static void* Allocate(int64 Size, int32 Alignment = 16);
+
+	/** Allocate an uninitialized array valid until the end of the frame. */
+	template <typename T>
+	static T* Allocate(const int64 Count)
+	{
+		return static_cast<T*>(Allocate(Count * sizeof(T), alignof(T)));
+	}
+
+	/** Start resetting the arenas at the end of each frame. */
+	static void Startup();
+
+	/** Stop resetting the arenas. */
+	static void Shutdown();
+};
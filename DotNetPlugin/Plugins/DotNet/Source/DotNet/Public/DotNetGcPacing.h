@@ -0,0 +1,96 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Allocation and collection figures of a frame, layout must match Unreal.Core.GcFrameStats. */
+struct FDotNetGcFrameStats
+{
+	/** Bytes allocated by all managed threads since the previous tick. */
+	int64 AllocatedBytes;
+
+	/** Collections the runtime started on it's own since the previous tick. */
+	int32 UnpacedCollections;
+
+	/** Whether a collection was made at the start of this frame. */
+	uint8 Paced;
+
+	/** Whether the system is low on memory, in which case pacing is suspended. */
+	uint8 UnderMemoryPressure;
+
+	/** Whether the frame runs in a no-GC region, see DotNet.GcPacing.FrameNoGcRegionMB. */
+	uint8 InNoGcRegion;
+};
+
+/**
+ * Schedules managed gen0 collections at frame boundaries, see Unreal.Core.GcPacing.
+ *
+ * Pacing is ticked by the DotNet module at the start of each frame and controlled with the DotNet.GcPacing console
+ * variables. The bytes allocated by managed code each frame are published to the DotNet stat group whether pacing is
+ * enabled or not.
+ */
+struct DOTNET_API FDotNetGcPacing
+{
+	typedef void (*FTickFunction)(uint8 bEnabled, int64 AllocationBudget, int64 FrameNoGcRegionSize,
+	                              FDotNetGcFrameStats* Stats);
+
+	typedef uint8 (*FTryEnterNoGcRegionFunction)(int64 TotalSize);
+
+	typedef uint8 (*FExitNoGcRegionFunction)();
+
+	/** Start pacing with the given entry points of Unreal.Core.GcPacing. */
+	static void Startup(FTickFunction Tick, FTryEnterNoGcRegionFunction TryEnterNoGcRegion,
+	                    FExitNoGcRegionFunction ExitNoGcRegion);
+
+	/** Stop pacing. */
+	static void Shutdown();
+
+	/** Measure the allocations of the previous frame and collect if needed, done once per frame by the module. */
+	static void Tick();
+
+	/**
+	 * @brief Prevent managed collections until ExitNoGcRegion is called, regions can be nested.
+	 *
+	 * Entering the outermost region makes an ephemeral collection, nested regions are free.
+	 *
+	 * @param TotalSize Bytes managed code may allocate in the region.
+	 * @return Whether the region was entered, ExitNoGcRegion must only be called if so.
+	 */
+	static bool TryEnterNoGcRegion(int64 TotalSize);
+
+	/** Leave a region entered with TryEnterNoGcRegion. */
+	static void ExitNoGcRegion();
+};
+
+/**
+ * Holds off managed collections for the duration of a latency-critical scope, such as a physics step or a replication
+ * send. The region is skipped if the runtime is low on memory.
+ *
+ * Entering a region is not free: the runtime makes a gen0 or gen1 collection first to make room for TotalSize bytes.
+ * Inside the frame-long region enabled with DotNet.GcPacing.FrameNoGcRegionMB the scope costs nothing, otherwise only
+ * use it where that collection is cheaper than one in the middle of the scope.
+ */
+class FDotNetNoGcScope
+{
+public:
+	/** Default number of bytes managed code may allocate in the region. */
+	static constexpr int64 DefaultSize = 16 * 1024 * 1024;
+
+	explicit FDotNetNoGcScope(const int64 TotalSize = DefaultSize)
+		: bEntered(FDotNetGcPacing::TryEnterNoGcRegion(TotalSize))
+	{ }
+
+	~FDotNetNoGcScope()
+	{
+		if (bEntered)
+			FDotNetGcPacing::ExitNoGcRegion();
+	}
+
+	FDotNetNoGcScope(const FDotNetNoGcScope&) = delete;
+	FDotNetNoGcScope& operator=(const FDotNetNoGcScope&) = delete;
+
+private:
+	const bool bEntered;
+};
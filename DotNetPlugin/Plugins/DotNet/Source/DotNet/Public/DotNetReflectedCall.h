@@ -0,0 +1,49 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+
+/**
+ * Support for bindings that call a UFunction through its reflection data instead of linking to it.
+ *
+ * Used by the generated thunks of classes that do not export their functions from their module. The thunk declares a
+ * parameter struct matching the UFunction's frame, resolves the function once and then invokes it with that struct.
+ */
+struct DOTNET_API FDotNetReflectedCall
+{
+	/** Layout of a member of the generated parameter struct. */
+	struct FParameter
+	{
+		int32 Offset;
+
+		int32 Size;
+	};
+
+	/**
+	 * @brief Find a function by path and check that its parameter frame matches the generated parameter struct.
+	 *
+	 * Returns null without caching anything, callers keep the result only once it resolved.
+	 *
+	 * @param Path Full path of the function, e.g. /Script/Engine.Actor:GetActorLocation.
+	 * @param ParmsSize Size of the generated struct, the function's frame must fit in it.
+	 * @param Parameters Layout of each parameter in the generated struct, in declaration order, return value last.
+	 * @return The function, or null if it could not be found or its layout does not match.
+	 */
+	static UFunction* FindFunction(const TCHAR* Path, int32 ParmsSize, std::initializer_list<FParameter> Parameters);
+
+	/**
+	 * @brief Invoke a function with a prepared parameter frame.
+	 *
+	 * Local native functions are called directly through their exec thunk, skipping the script checks done by
+	 * ProcessEvent. Script functions, network functions and functions that would not run locally go through
+	 * ProcessEvent so they are replicated or absorbed like any other call.
+	 *
+	 * @param Object Object to invoke the function on, static functions may pass null to use the class default object.
+	 * @param Function Function to invoke.
+	 * @param Parms Parameter frame, may be null for functions without parameters.
+	 */
+	static void Invoke(UObject* Object, UFunction* Function, void* Parms);
+};
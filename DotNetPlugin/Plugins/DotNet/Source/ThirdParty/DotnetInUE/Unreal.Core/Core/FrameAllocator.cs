@@ -0,0 +1,196 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Runtime.CompilerServices;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// Allocates transient native memory from the plugin's frame arena, for data passed to native code such as
+    /// argument arrays and string conversions.
+    /// </summary>
+    /// <remarks>
+    /// Memory is valid until the end of the frame it was allocated in and must not be held past it, on threads other
+    /// than the game thread it is only valid until the thread next allocates in a later frame. Each thread carves
+    /// small allocations out of blocks it takes from it's native arena, so they neither allocate on the managed heap
+    /// nor cross into native code. Allocations are not cleared.
+    /// </remarks>
+    public static unsafe class FrameAllocator
+    {
+        #region PInvoke
+
+        // ReSharper disable InconsistentNaming
+        private static readonly delegate* unmanaged<long, int, void*> FrameArena_Allocate =
+            (delegate* unmanaged<long, int, void*>) NativeHelpers.GetPluginFunction("FrameArena_Allocate");
+
+        private static readonly delegate* unmanaged<ulong*> FrameArena_GetFrame =
+            (delegate* unmanaged<ulong*>) NativeHelpers.GetPluginFunction("FrameArena_GetFrame");
+        // ReSharper restore InconsistentNaming
+
+        #endregion
+
+        /// <summary>
+        /// Alignment of allocations when none is given.
+        /// </summary>
+        public const int DefaultAlignment = 16;
+
+        /// <summary>
+        /// Size of the blocks threads take from the native arena.
+        /// </summary>
+        private const int BlockSize = 16 * 1024;
+
+        /// <summary>
+        /// Allocations larger than this are made by the native arena directly.
+        /// </summary>
+        private const int MaxBlockAllocation = BlockSize / 4;
+
+        /// <summary>
+        /// Current frame, advanced by the plugin at the end of each frame.
+        /// </summary>
+        private static readonly ulong* m_frame = FrameArena_GetFrame();
+
+        [ThreadStatic]
+        private static byte* t_cursor;
+
+        [ThreadStatic]
+        private static byte* t_end;
+
+        [ThreadStatic]
+        private static ulong t_frame;
+
+        /// <summary>
+        /// Allocate memory valid until the end of the frame.
+        /// </summary>
+        /// <param name="size">Size of the allocation in bytes.</param>
+        /// <param name="alignment">Alignment of the allocation, a power of two no larger than 64.</param>
+        /// <returns></returns>
+        public static Span<byte> Allocate(int size, int alignment = DefaultAlignment)
+        {
+            return new(AllocateUnsafe(size, alignment), size);
+        }
+
+        /// <summary>
+        /// Allocate an uninitialized array valid until the end of the frame.
+        /// </summary>
+        /// <param name="count"></param>
+        /// <typeparam name="T"></typeparam>
+        /// <returns></returns>
+        public static Span<T> Allocate<T>(int count)
+            where T : unmanaged
+        {
+            return Allocate<T>(count, AlignmentOf<T>());
+        }
+
+        /// <summary>
+        /// Allocate an uninitialized array valid until the end of the frame, for types whose native alignment is
+        /// larger than the one inferred from their size.
+        /// </summary>
+        /// <param name="count"></param>
+        /// <param name="alignment">Alignment of the array, a power of two no larger than 64.</param>
+        /// <typeparam name="T"></typeparam>
+        /// <returns></returns>
+        public static Span<T> Allocate<T>(int count, int alignment)
+            where T : unmanaged
+        {
+            return new(AllocateUnsafe(checked(count * sizeof(T)), alignment), count);
+        }
+
+        /// <summary>
+        /// Copy an array to memory valid until the end of the frame.
+        /// </summary>
+        /// <param name="values"></param>
+        /// <typeparam name="T"></typeparam>
+        /// <returns>The copy, to be passed to native code.</returns>
+        public static T* Copy<T>(ReadOnlySpan<T> values)
+            where T : unmanaged
+        {
+            return Copy(values, AlignmentOf<T>());
+        }
+
+        /// <summary>
+        /// Copy an array to memory valid until the end of the frame.
+        /// </summary>
+        /// <param name="values"></param>
+        /// <param name="alignment">Alignment of the copy, a power of two no larger than 64.</param>
+        /// <typeparam name="T"></typeparam>
+        /// <returns>The copy, to be passed to native code.</returns>
+        public static T* Copy<T>(ReadOnlySpan<T> values, int alignment)
+            where T : unmanaged
+        {
+            var copy = (T*) AllocateUnsafe(checked(values.Length * sizeof(T)), alignment);
+            values.CopyTo(new Span<T>(copy, values.Length));
+            return copy;
+        }
+
+        /// <summary>
+        /// Copy a string to memory valid until the end of the frame, as a null terminated TCHAR string.
+        /// </summary>
+        /// <param name="value"></param>
+        /// <returns>The copy, or null if the string is null.</returns>
+        public static char* CopyString(string? value)
+        {
+            if (value == null)
+                return null;
+
+            var copy = (char*) AllocateUnsafe((value.Length + 1) * sizeof(char), sizeof(char));
+            value.AsSpan().CopyTo(new Span<char>(copy, value.Length));
+            copy[value.Length] = '\0';
+            return copy;
+        }
+
+        /// <summary>
+        /// Allocate memory valid until the end of the frame.
+        /// </summary>
+        /// <param name="size"></param>
+        /// <param name="alignment"></param>
+        /// <returns></returns>
+        public static void* AllocateUnsafe(int size, int alignment = DefaultAlignment)
+        {
+            if (size < 0)
+                throw new ArgumentOutOfRangeException(nameof(size));
+            if (alignment <= 0 || alignment > 64 || (alignment & (alignment - 1)) != 0)
+                throw new ArgumentOutOfRangeException(nameof(alignment));
+
+            var result = (byte*) (((nuint) t_cursor + (nuint) (alignment - 1)) & ~(nuint) (alignment - 1));
+            if (t_frame == *m_frame && result + size <= t_end && t_cursor != null)
+            {
+                t_cursor = result + size;
+                return result;
+            }
+
+            return AllocateSlow(size, alignment);
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static void* AllocateSlow(int size, int alignment)
+        {
+            if (size > MaxBlockAllocation)
+                return FrameArena_Allocate(size, alignment);
+
+            // Blocks of earlier frames are reset by the arena, start over with a new one.
+            t_frame = *m_frame;
+            t_cursor = (byte*) FrameArena_Allocate(BlockSize, 64);
+            t_end = t_cursor + BlockSize;
+
+            var result = t_cursor;
+            t_cursor += size;
+            return result;
+        }
+
+        private static int AlignmentOf<T>()
+            where T : unmanaged
+        {
+            // Natural alignment of primitives, larger structs are aligned for any of their fields. Sizes that are a
+            // multiple of 16 may be vector types such as FVector4 or FQuat, which native code reads with aligned loads.
+            return sizeof(T) switch
+            {
+                1 => 1,
+                2 => 2,
+                4 => 4,
+                _ when sizeof(T) % 16 == 0 => 16,
+                _ => sizeof(T) % 8 == 0 ? 8 : 4
+            };
+        }
+    }
+}
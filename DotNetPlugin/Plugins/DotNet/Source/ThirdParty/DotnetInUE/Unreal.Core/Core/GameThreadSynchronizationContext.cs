@@ -0,0 +1,183 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// Result of a <see cref="GameThreadSynchronizationContext.Pump"/>.
+    /// </summary>
+    /// <remarks>Layout must match FDotNetPumpStats in DotNetScheduling.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PumpStats
+    {
+        /// <summary>
+        /// Number of callbacks run.
+        /// </summary>
+        public int Executed;
+
+        /// <summary>
+        /// Number of callbacks left in the queue for the next pump.
+        /// </summary>
+        public int Remaining;
+    }
+
+    /// <summary>
+    /// Runs posted callbacks, and so the continuations of awaits started on the game thread, on the game thread.
+    /// </summary>
+    /// <remarks>
+    /// The plugin installs the context on the game thread when the runtime is initialized and pumps it once per frame
+    /// within a time budget, callbacks that do not fit in the budget wait for the next frame.
+    /// </remarks>
+    public sealed class GameThreadSynchronizationContext : SynchronizationContext
+    {
+        private readonly ConcurrentQueue<(SendOrPostCallback Callback, object? State)> m_queue = new();
+
+        private readonly Thread m_thread;
+
+        /// <summary>
+        /// The context of the game thread, if installed.
+        /// </summary>
+        public static GameThreadSynchronizationContext? Instance { get; private set; }
+
+        /// <summary>
+        /// Create a context for the calling thread, which is the only one allowed to pump it.
+        /// </summary>
+        public GameThreadSynchronizationContext()
+        {
+            m_thread = Thread.CurrentThread;
+        }
+
+        /// <summary>
+        /// Whether the calling thread is the one the context runs callbacks on.
+        /// </summary>
+        public bool IsCurrentThread => Thread.CurrentThread == m_thread;
+
+        /// <summary>
+        /// Number of callbacks waiting to be run.
+        /// </summary>
+        public int QueueLength => m_queue.Count;
+
+        /// <summary>
+        /// Create the context of the calling thread and make it current.
+        /// </summary>
+        internal static void Install()
+        {
+            Instance = new GameThreadSynchronizationContext();
+            SetSynchronizationContext(Instance);
+        }
+
+        public override void Post(SendOrPostCallback d, object? state)
+        {
+            m_queue.Enqueue((d, state));
+        }
+
+        public override void Send(SendOrPostCallback d, object? state)
+        {
+            if (IsCurrentThread)
+            {
+                d(state);
+                return;
+            }
+
+            using var done = new ManualResetEventSlim();
+            Exception? exception = null;
+
+            Post(_ =>
+            {
+                try
+                {
+                    d(state);
+                }
+                catch (Exception ex)
+                {
+                    exception = ex;
+                }
+                finally
+                {
+                    done.Set();
+                }
+            }, null);
+
+            done.Wait();
+
+            if (exception != null)
+                throw new TargetInvocationException(exception);
+        }
+
+        public override SynchronizationContext CreateCopy()
+        {
+            return this;
+        }
+
+        /// <summary>
+        /// Run queued callbacks until the queue is empty or the budget runs out.
+        /// </summary>
+        /// <remarks>
+        /// At least one callback is run per pump so the queue always progresses. Exceptions thrown by callbacks are
+        /// logged and do not stop the pump.
+        /// </remarks>
+        /// <param name="budget">Time after which no more callbacks are started.</param>
+        /// <returns></returns>
+        public PumpStats Pump(TimeSpan budget)
+        {
+            if (!IsCurrentThread)
+                throw new InvalidOperationException("The context can only be pumped by the thread that created it.");
+
+            var stats = new PumpStats();
+            var start = Stopwatch.GetTimestamp();
+            var budgetTicks = (long) (budget.TotalSeconds * Stopwatch.Frequency);
+
+            var previous = Current;
+            SetSynchronizationContext(this);
+
+            try
+            {
+                while (m_queue.TryDequeue(out var item))
+                {
+                    try
+                    {
+                        item.Callback(item.State);
+                    }
+                    catch (Exception ex)
+                    {
+                        UeLog.Log(LogVerbosity.Error, $"Unhandled exception in a game thread callback: {ex}");
+                    }
+
+                    ++stats.Executed;
+
+                    if (Stopwatch.GetTimestamp() - start >= budgetTicks)
+                        break;
+                }
+            }
+            finally
+            {
+                SetSynchronizationContext(previous);
+            }
+
+            stats.Remaining = m_queue.Count;
+            return stats;
+        }
+
+        #region Native Entry Points
+
+        private static unsafe void PumpNative(long budgetMicroseconds, PumpStats* stats)
+        {
+            *stats = Instance?.Pump(TimeSpan.FromTicks(budgetMicroseconds * 10)) ?? default;
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__GameThreadSynchronizationContext__Pump")]
+        private static unsafe void PumpAot(long budgetMicroseconds, PumpStats* stats)
+        {
+            PumpNative(budgetMicroseconds, stats);
+        }
+
+        #endregion
+    }
+}
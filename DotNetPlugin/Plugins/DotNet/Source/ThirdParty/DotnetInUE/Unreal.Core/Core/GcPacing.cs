@@ -0,0 +1,318 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// Allocation and collection figures of a frame, filled by <see cref="GcPacing.Tick"/>.
+    /// </summary>
+    /// <remarks>Layout must match FDotNetGcFrameStats in DotNetGcPacing.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct GcFrameStats
+    {
+        /// <summary>
+        /// Bytes allocated by all managed threads since the previous tick.
+        /// </summary>
+        public long AllocatedBytes;
+
+        /// <summary>
+        /// Collections the runtime started on it's own since the previous tick.
+        /// </summary>
+        public int UnpacedCollections;
+
+        /// <summary>
+        /// Whether a collection was made at the start of this frame.
+        /// </summary>
+        public byte Paced;
+
+        /// <summary>
+        /// Whether the system is low on memory, in which case pacing is suspended.
+        /// </summary>
+        public byte UnderMemoryPressure;
+
+        /// <summary>
+        /// Whether the frame runs in a no-GC region, see <see cref="GcPacing.FrameNoGcRegionSize"/>.
+        /// </summary>
+        public byte InNoGcRegion;
+    }
+
+    /// <summary>
+    /// Schedules gen0 collections at frame boundaries so they do not land in the middle of a frame.
+    /// </summary>
+    /// <remarks>
+    /// The plugin calls <see cref="Tick"/> at the start of each frame. Once the bytes allocated since the last
+    /// collection would exceed <see cref="AllocationBudget"/> during the next frame, at the rate of the frame that
+    /// just ended, a gen0 collection is made right away. With a budget below the runtime's own gen0 budget the runtime
+    /// rarely has to collect mid-frame.
+    ///
+    /// Latency-critical sections can additionally be run in a no-GC region, see <see cref="TryEnterNoGcRegion"/>.
+    /// Entering a region collects to make room for it, so sections that run every frame are better served by a region
+    /// spanning the whole frame, see <see cref="FrameNoGcRegionSize"/>, in which nested regions are free.
+    ///
+    /// When the system is low on memory pacing backs off: no collections are scheduled and no-GC regions are refused,
+    /// leaving the runtime free to collect as it needs.
+    /// </remarks>
+    public static class GcPacing
+    {
+        /// <summary>
+        /// Whether collections are scheduled, when false <see cref="Tick"/> only measures allocations.
+        /// </summary>
+        public static bool IsEnabled { get; set; }
+
+        /// <summary>
+        /// Bytes that may be allocated between two collections.
+        /// </summary>
+        public static long AllocationBudget { get; set; } = 8 * 1024 * 1024;
+
+        /// <summary>
+        /// Bytes managed code may allocate during a frame run in a no-GC region, zero to not use frame regions.
+        /// </summary>
+        /// <remarks>
+        /// The region is entered by <see cref="Tick"/> at the frame boundary, which makes an ephemeral collection each
+        /// frame in place of the paced one. If a frame allocates more the runtime collects and the region ends early.
+        /// </remarks>
+        public static long FrameNoGcRegionSize { get; set; }
+
+        /// <summary>
+        /// Bytes allocated by all managed threads during the last frame.
+        /// </summary>
+        public static long LastFrameAllocatedBytes { get; private set; }
+
+        /// <summary>
+        /// Number of collections made by pacing.
+        /// </summary>
+        public static int PacedCollections { get; private set; }
+
+        /// <summary>
+        /// Whether the system was low on memory as of the last collection.
+        /// </summary>
+        public static bool IsUnderMemoryPressure { get; private set; }
+
+        private static long m_lastAllocated = GC.GetTotalAllocatedBytes();
+
+        private static long m_allocatedAtCollection = m_lastAllocated;
+
+        private static int m_lastCollectionCount = GC.CollectionCount(0);
+
+        private static readonly object m_regionLock = new();
+
+        private static int m_regionDepth;
+
+        private static bool m_inFrameRegion;
+
+        /// <summary>
+        /// Measure the allocations of the frame that ended and collect if the next one would exceed the budget.
+        /// </summary>
+        /// <remarks>
+        /// Called by the plugin at the start of each frame. Ends the no-GC region of the previous frame and enters the
+        /// one of the next frame if <see cref="FrameNoGcRegionSize"/> is set.
+        /// </remarks>
+        /// <returns></returns>
+        public static GcFrameStats Tick()
+        {
+            var stats = new GcFrameStats();
+
+            lock (m_regionLock)
+            {
+                if (m_inFrameRegion)
+                {
+                    m_inFrameRegion = false;
+                    ExitNoGcRegion();
+                }
+            }
+
+            var allocated = GC.GetTotalAllocatedBytes();
+            stats.AllocatedBytes = LastFrameAllocatedBytes = allocated - m_lastAllocated;
+            m_lastAllocated = allocated;
+
+            var collectionCount = GC.CollectionCount(0);
+            if (collectionCount != m_lastCollectionCount)
+            {
+                stats.UnpacedCollections = collectionCount - m_lastCollectionCount;
+                m_allocatedAtCollection = allocated;
+
+                // The memory load is only updated by collections.
+                var info = GC.GetGCMemoryInfo();
+                IsUnderMemoryPressure = info.MemoryLoadBytes >= info.HighMemoryLoadThresholdBytes;
+            }
+
+            stats.UnderMemoryPressure = (byte) (IsUnderMemoryPressure ? 1 : 0);
+
+            // Entering a frame region collects anyway.
+            if (IsEnabled && !IsUnderMemoryPressure && FrameNoGcRegionSize <= 0 &&
+                allocated - m_allocatedAtCollection + LastFrameAllocatedBytes >= AllocationBudget)
+            {
+                lock (m_regionLock)
+                {
+                    if (m_regionDepth == 0)
+                    {
+                        GC.Collect(0, GCCollectionMode.Forced, true, false);
+
+                        ++PacedCollections;
+                        stats.Paced = 1;
+                        m_allocatedAtCollection = allocated;
+                    }
+                }
+            }
+
+            if (FrameNoGcRegionSize > 0)
+            {
+                lock (m_regionLock)
+                {
+                    // Regions held across frames keep the frame out of a region of it's own.
+                    if (m_regionDepth == 0 && TryEnterNoGcRegion(FrameNoGcRegionSize))
+                    {
+                        m_inFrameRegion = true;
+                        stats.InNoGcRegion = 1;
+                        m_allocatedAtCollection = allocated;
+                    }
+                }
+            }
+
+            m_lastCollectionCount = GC.CollectionCount(0);
+
+            return stats;
+        }
+
+        /// <summary>
+        /// Prevent collections until <see cref="ExitNoGcRegion"/> is called, regions can be nested.
+        /// </summary>
+        /// <remarks>
+        /// Entering the outermost region always makes an ephemeral collection first to make room for the requested
+        /// allocations, full blocking collections are refused. Nested regions cost nothing, including those in the
+        /// frame region, but are limited to the size of the outermost one. If more than that is allocated the runtime
+        /// collects anyway and the region ends early.
+        /// </remarks>
+        /// <param name="totalSize">Bytes the section may allocate, must fit in the ephemeral segment.</param>
+        /// <returns>Whether the region was entered, <see cref="ExitNoGcRegion"/> must only be called if so.</returns>
+        public static bool TryEnterNoGcRegion(long totalSize)
+        {
+            lock (m_regionLock)
+            {
+                if (m_regionDepth > 0)
+                {
+                    ++m_regionDepth;
+                    return true;
+                }
+
+                if (IsUnderMemoryPressure)
+                    return false;
+
+                try
+                {
+                    if (!GC.TryStartNoGCRegion(totalSize, true))
+                        return false;
+                }
+                catch (Exception ex) when (ex is ArgumentOutOfRangeException or InvalidOperationException)
+                {
+                    // Too large a region, or one started by someone else.
+                    return false;
+                }
+
+                m_regionDepth = 1;
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Leave a region entered with <see cref="TryEnterNoGcRegion"/>.
+        /// </summary>
+        /// <returns>False if the outermost region ended early because too much was allocated.</returns>
+        public static bool ExitNoGcRegion()
+        {
+            lock (m_regionLock)
+            {
+                if (m_regionDepth == 0)
+                    throw new InvalidOperationException("Not in a no-GC region.");
+
+                if (--m_regionDepth > 0)
+                    return true;
+
+                // The region must be ended even if the runtime already left it, otherwise the next one can't start.
+                try
+                {
+                    GC.EndNoGCRegion();
+                    return true;
+                }
+                catch (InvalidOperationException)
+                {
+                    return false;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Run the rest of a scope in a no-GC region, if one can be entered.
+        /// </summary>
+        /// <param name="totalSize"></param>
+        /// <returns></returns>
+        public static NoGcRegion NoGcRegionScope(long totalSize)
+        {
+            return new(TryEnterNoGcRegion(totalSize));
+        }
+
+        public readonly struct NoGcRegion : IDisposable
+        {
+            /// <summary>
+            /// Whether the region was entered.
+            /// </summary>
+            public readonly bool IsEntered;
+
+            internal NoGcRegion(bool isEntered)
+            {
+                IsEntered = isEntered;
+            }
+
+            public void Dispose()
+            {
+                if (IsEntered)
+                    ExitNoGcRegion();
+            }
+        }
+
+        #region Native Entry Points
+
+        private static unsafe void TickNative(byte enabled, long allocationBudget, long frameNoGcRegionSize,
+            GcFrameStats* stats)
+        {
+            IsEnabled = enabled != 0;
+            AllocationBudget = allocationBudget;
+            FrameNoGcRegionSize = frameNoGcRegionSize;
+            *stats = Tick();
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__GcPacing__Tick")]
+        private static unsafe void TickAot(byte enabled, long allocationBudget, long frameNoGcRegionSize,
+            GcFrameStats* stats)
+        {
+            TickNative(enabled, allocationBudget, frameNoGcRegionSize, stats);
+        }
+
+        private static byte TryEnterNoGcRegionNative(long totalSize)
+        {
+            return (byte) (TryEnterNoGcRegion(totalSize) ? 1 : 0);
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__GcPacing__TryEnterNoGcRegion")]
+        private static byte TryEnterNoGcRegionAot(long totalSize)
+        {
+            return TryEnterNoGcRegionNative(totalSize);
+        }
+
+        private static byte ExitNoGcRegionNative()
+        {
+            return (byte) (ExitNoGcRegion() ? 1 : 0);
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__GcPacing__ExitNoGcRegion")]
+        private static byte ExitNoGcRegionAot()
+        {
+            return ExitNoGcRegionNative();
+        }
+
+        #endregion
+    }
+}
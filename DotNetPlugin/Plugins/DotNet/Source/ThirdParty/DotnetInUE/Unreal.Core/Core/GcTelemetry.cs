@@ -0,0 +1,231 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Diagnostics.Tracing;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// A garbage collection of the managed runtime, as seen by <see cref="GcTelemetry"/>.
+    /// </summary>
+    /// <remarks>Layout must match FDotNetGcEvent in DotNetGcTelemetry.h.</remarks>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct GcEvent
+    {
+        /// <summary>
+        /// Number of the collection since the runtime started.
+        /// </summary>
+        public long Index;
+
+        /// <summary>
+        /// Time managed threads were suspended for the collection, in ticks of 100ns.
+        /// </summary>
+        public long PauseTicks;
+
+        /// <summary>
+        /// Bytes that survived the collection.
+        /// </summary>
+        public long PromotedBytes;
+
+        /// <summary>
+        /// Size of the managed heap after the collection.
+        /// </summary>
+        /// <remarks>Background collections report the size as of the last collection that completed.</remarks>
+        public long HeapSizeBytes;
+
+        /// <summary>
+        /// Oldest generation collected.
+        /// </summary>
+        public int Generation;
+
+        public TimeSpan Pause => TimeSpan.FromTicks(PauseTicks);
+    }
+
+    /// <summary>
+    /// Records the garbage collections of the runtime so the plugin can report them along with the frames they
+    /// stalled.
+    /// </summary>
+    /// <remarks>
+    /// Collections are observed through the runtime's event source and written into a ring buffer that is drained
+    /// once per frame by the plugin. The ring has a single writer, the event dispatch thread, and a single reader, so
+    /// it needs no locks. Collections that do not fit in the ring are dropped and counted in <see cref="Dropped"/>.
+    /// </remarks>
+    public static class GcTelemetry
+    {
+        /// <summary>
+        /// Number of collections the ring can hold between two drains.
+        /// </summary>
+        public const int Capacity = 256;
+
+        private static readonly GcEvent[] m_events = new GcEvent[Capacity];
+
+        private static long m_written;
+
+        private static long m_read;
+
+        private static long m_dropped;
+
+        private static readonly object m_lock = new();
+
+        private static GcListener? m_listener;
+
+        /// <summary>
+        /// Whether collections are being recorded.
+        /// </summary>
+        public static bool IsEnabled => m_listener != null;
+
+        /// <summary>
+        /// Number of collections that were dropped because the ring was full.
+        /// </summary>
+        public static long Dropped => Interlocked.Read(ref m_dropped);
+
+        /// <summary>
+        /// Start recording collections.
+        /// </summary>
+        public static void Enable()
+        {
+            lock (m_lock)
+                m_listener ??= new GcListener();
+        }
+
+        /// <summary>
+        /// Stop recording collections, those already recorded can still be drained.
+        /// </summary>
+        public static void Disable()
+        {
+            lock (m_lock)
+            {
+                m_listener?.Dispose();
+                m_listener = null;
+            }
+        }
+
+        /// <summary>
+        /// Read the recorded collections, oldest first.
+        /// </summary>
+        /// <remarks>Must not be called concurrently, the plugin calls it from the game thread.</remarks>
+        /// <param name="events">Buffer the collections are copied to.</param>
+        /// <returns>The number of collections read, less than the size of the buffer once the ring is empty.</returns>
+        public static int Drain(Span<GcEvent> events)
+        {
+            var read = Volatile.Read(ref m_read);
+            var count = (int) Math.Min(Volatile.Read(ref m_written) - read, events.Length);
+
+            for (int i = 0; i < count; ++i)
+                events[i] = m_events[(read + i) % Capacity];
+
+            Volatile.Write(ref m_read, read + count);
+            return count;
+        }
+
+        internal static void Write(in GcEvent gcEvent)
+        {
+            var written = Volatile.Read(ref m_written);
+            if (written - Volatile.Read(ref m_read) >= Capacity)
+            {
+                Interlocked.Increment(ref m_dropped);
+                return;
+            }
+
+            m_events[written % Capacity] = gcEvent;
+            Volatile.Write(ref m_written, written + 1);
+        }
+
+        #region Native Entry Points
+
+        private static void EnableNative()
+        {
+            Enable();
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__GcTelemetry__Enable")]
+        private static void EnableAot()
+        {
+            EnableNative();
+        }
+
+        private static unsafe int DrainNative(GcEvent* events, int capacity)
+        {
+            return Drain(new Span<GcEvent>(events, capacity));
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__GcTelemetry__Drain")]
+        private static unsafe int DrainAot(GcEvent* events, int capacity)
+        {
+            return DrainNative(events, capacity);
+        }
+
+        #endregion
+
+        /// <summary>
+        /// Pieces a collection together from the events the runtime raises around it.
+        /// </summary>
+        private class GcListener : EventListener
+        {
+            private const string RuntimeEventSource = "Microsoft-Windows-DotNETRuntime";
+
+            private const EventKeywords GcKeyword = (EventKeywords) 0x1;
+
+            // Ids of the events of the runtime provider.
+            private const int GCStart = 1;
+            private const int GCRestartEEEnd = 3;
+            private const int GCHeapStats = 4;
+            private const int GCSuspendEEBegin = 9;
+
+            // Only touched by the dispatch thread.
+            private DateTime m_suspendTime;
+            private GcEvent m_current;
+            private bool m_collected;
+
+            protected override void OnEventSourceCreated(EventSource eventSource)
+            {
+                if (eventSource.Name == RuntimeEventSource)
+                    EnableEvents(eventSource, EventLevel.Informational, GcKeyword);
+            }
+
+            protected override void OnEventWritten(EventWrittenEventArgs eventData)
+            {
+                switch (eventData.EventId)
+                {
+                    case GCSuspendEEBegin:
+                        m_suspendTime = eventData.TimeStamp;
+                        m_collected = false;
+                        break;
+                    case GCStart:
+                        m_current.Index = GetPayload(eventData, "Count");
+                        m_current.Generation = (int) GetPayload(eventData, "Depth");
+                        m_collected = true;
+                        break;
+                    case GCHeapStats:
+                        m_current.PromotedBytes = 0;
+                        m_current.HeapSizeBytes = 0;
+                        for (int generation = 0; generation <= 4; ++generation)
+                        {
+                            m_current.PromotedBytes += GetPayload(eventData, $"TotalPromotedSize{generation}");
+                            m_current.HeapSizeBytes += GetPayload(eventData, $"GenerationSize{generation}");
+                        }
+
+                        break;
+                    case GCRestartEEEnd:
+                        // Threads are also suspended for reasons other than collections.
+                        if (!m_collected)
+                            break;
+
+                        m_current.PauseTicks = (eventData.TimeStamp - m_suspendTime).Ticks;
+                        m_collected = false;
+                        Write(m_current);
+                        break;
+                }
+            }
+
+            private static long GetPayload(EventWrittenEventArgs eventData, string name)
+            {
+                var index = eventData.PayloadNames?.IndexOf(name) ?? -1;
+                return index < 0 ? 0 : Convert.ToInt64(eventData.Payload![index]);
+            }
+        }
+    }
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// An event raised by native code, see <see cref="NativeEvents"/>.
+    /// </summary>
+    /// <remarks>Layout must match FDotNetEventRecord in DotNetEventQueue.h.</remarks>
+    [StructLayout(LayoutKind.Sequential, Size = 64)]
+    public unsafe struct NativeEvent
+    {
+        /// <summary>
+        /// Largest payload an event can carry.
+        /// </summary>
+        public const int MaxPayloadSize = 56;
+
+        /// <summary>
+        /// Type of the event.
+        /// </summary>
+        public int Type;
+
+        /// <summary>
+        /// Size of the payload in bytes.
+        /// </summary>
+        public int Size;
+
+        private fixed byte m_payload[MaxPayloadSize];
+
+        /// <summary>
+        /// Create an event, mostly useful to raise events from managed code in tests.
+        /// </summary>
+        /// <param name="type"></param>
+        /// <param name="payload"></param>
+        /// <typeparam name="T"></typeparam>
+        /// <returns></returns>
+        public static NativeEvent Create<T>(int type, in T payload)
+            where T : unmanaged
+        {
+            if (sizeof(T) > MaxPayloadSize)
+                throw new ArgumentException($"Payloads can't be larger than {MaxPayloadSize} bytes.", nameof(payload));
+
+            var nativeEvent = new NativeEvent {Type = type, Size = sizeof(T)};
+            *(T*) nativeEvent.m_payload = payload;
+            return nativeEvent;
+        }
+
+        /// <summary>
+        /// Read the payload of the event as the struct the native code wrote.
+        /// </summary>
+        /// <typeparam name="T"></typeparam>
+        /// <returns></returns>
+        public readonly T GetPayload<T>()
+            where T : unmanaged
+        {
+            if (sizeof(T) > Size)
+                throw new InvalidOperationException($"Payload of {Size} bytes can't be read as {typeof(T).Name}.");
+
+            fixed (byte* payload = m_payload)
+                return *(T*) payload;
+        }
+    }
+
+    /// <summary>
+    /// Delivers events raised by native code on any thread to managed handlers on the game thread.
+    /// </summary>
+    /// <remarks>
+    /// Native code queues events with FDotNetEventQueue::Enqueue. The plugin drains the queue once per frame and
+    /// delivers all events in a single call, handlers are invoked in the order the events were queued and can safely
+    /// access UObjects. Event types are agreed upon by the native and managed code of a module.
+    /// </remarks>
+    public static class NativeEvents
+    {
+        public delegate void Handler(in NativeEvent nativeEvent);
+
+        private static readonly object m_lock = new();
+
+        // Copied on write, so dispatch needs no lock.
+        private static Dictionary<int, Handler> m_handlers = new();
+
+        /// <summary>
+        /// Number of events delivered without a handler for their type.
+        /// </summary>
+        public static long Unhandled { get; private set; }
+
+        /// <summary>
+        /// Invoke a handler for each event of a type.
+        /// </summary>
+        /// <param name="type"></param>
+        /// <param name="handler"></param>
+        public static void Subscribe(int type, Handler handler)
+        {
+            lock (m_lock)
+            {
+                var handlers = new Dictionary<int, Handler>(m_handlers);
+                handlers[type] = handlers.TryGetValue(type, out var existing) ? existing + handler : handler;
+                m_handlers = handlers;
+            }
+        }
+
+        /// <summary>
+        /// Stop invoking a handler.
+        /// </summary>
+        /// <param name="type"></param>
+        /// <param name="handler"></param>
+        public static void Unsubscribe(int type, Handler handler)
+        {
+            lock (m_lock)
+            {
+                if (!m_handlers.TryGetValue(type, out var existing))
+                    return;
+
+                var handlers = new Dictionary<int, Handler>(m_handlers);
+                var remaining = existing - handler;
+                if (remaining == null)
+                    handlers.Remove(type);
+                else
+                    handlers[type] = remaining;
+                m_handlers = handlers;
+            }
+        }
+
+        /// <summary>
+        /// Invoke the handlers of a batch of events.
+        /// </summary>
+        /// <remarks>
+        /// Exceptions thrown by handlers are logged and do not prevent the other events from being delivered.
+        /// </remarks>
+        /// <param name="events"></param>
+        public static void Dispatch(ReadOnlySpan<NativeEvent> events)
+        {
+            var handlers = m_handlers;
+
+            foreach (ref readonly var nativeEvent in events)
+            {
+                if (!handlers.TryGetValue(nativeEvent.Type, out var handler))
+                {
+                    ++Unhandled;
+                    continue;
+                }
+
+                try
+                {
+                    handler(in nativeEvent);
+                }
+                catch (Exception ex)
+                {
+                    UeLog.Log(LogVerbosity.Error, $"Unhandled exception in the handler of native event {nativeEvent.Type}: {ex}");
+                }
+            }
+        }
+
+        #region Native Entry Points
+
+        private static unsafe void DispatchNative(NativeEvent* events, int count)
+        {
+            Dispatch(new ReadOnlySpan<NativeEvent>(events, count));
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__NativeEvents__Dispatch")]
+        private static unsafe void DispatchAot(NativeEvent* events, int count)
+        {
+            DispatchNative(events, count);
+        }
+
+        #endregion
+    }
+}
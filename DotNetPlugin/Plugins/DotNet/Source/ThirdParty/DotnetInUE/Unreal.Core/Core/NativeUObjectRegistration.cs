@@ -3,6 +3,7 @@
 
 using System;
 using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.Diagnostics;
 
 namespace Unreal.Core
@@ -10,25 +11,45 @@ namespace Unreal.Core
     /// <summary>
     /// Registrar for native UObjects
     /// </summary>
+    /// <remarks>
+    /// Wrappers for native objects may be requested from any thread. Lookups are lock free, and creation
+    /// is optimistic: when two threads race to wrap the same native object both may construct a wrapper,
+    /// but only the first one to register is published and every caller receives that one.
+    /// </remarks>
     internal static class NativeUObjectRegistration
     {
         private static readonly ConcurrentDictionary<IntPtr, UObjectBase> Objects = new();
-        
+
+        /// <summary>
+        /// Native object that the current thread is creating a wrapper for through <see cref="GetOrCreate{TObject}"/>.
+        /// </summary>
+        /// <remarks>Registration of a wrapper for this object is allowed to lose a race against another thread.</remarks>
+        [ThreadStatic]
+        private static IntPtr t_pendingCreation;
+
         public static void Register(UObjectBase uObject)
         {
             var result = Objects.TryAdd(uObject.NativeObject, uObject);
+            if (result)
+                return;
+
+            // Lost a creation race, the caller will pick up the published instance.
+            if (t_pendingCreation == uObject.NativeObject)
+                return;
+
 #pragma warning disable 618
-            if (!result)
-                throw new ExecutionEngineException("Another managed object was bound to the same native object.");
+            throw new ExecutionEngineException("Another managed object was bound to the same native object.");
 #pragma warning restore 618
         }
 
         public static void Unregister(UObjectBase uObject)
         {
-            var removed = Objects.TryRemove((uObject).NativeObject, out _);
+            // Only remove the entry if it is actually bound to this wrapper, a wrapper that lost a creation race
+            // must never evict the winner.
+            var removed = Objects.TryRemove(new KeyValuePair<IntPtr, UObjectBase>(uObject.NativeObject, uObject));
             Debug.Assert(removed, "UObject was already unregistered.");
         }
-        
+
         /// <summary>
         /// Get the managed object that maps 
         /// </summary>
@@ -43,5 +64,38 @@ namespace Unreal.Core
 
             return null;
         }
+
+        /// <summary>
+        /// Get the managed object that maps to a native instance, creating it if necessary.
+        /// </summary>
+        /// <remarks>The factory is expected to construct a wrapper that registers itself. It is only invoked
+        /// when the object is not yet known, and may be invoked by more than one thread for the same object;
+        /// all of them will receive the same published wrapper.</remarks>
+        /// <param name="nativeInstance">The native object.</param>
+        /// <param name="factory">Constructor of the managed wrapper.</param>
+        /// <typeparam name="TObject"></typeparam>
+        /// <returns></returns>
+        internal static TObject GetOrCreate<TObject>(IntPtr nativeInstance, Func<IntPtr, TObject> factory)
+            where TObject : UObjectBase
+        {
+            UObjectBase? published;
+            while (!Objects.TryGetValue(nativeInstance, out published))
+            {
+                var previous = t_pendingCreation;
+                t_pendingCreation = nativeInstance;
+                try
+                {
+                    factory(nativeInstance);
+                }
+                finally
+                {
+                    t_pendingCreation = previous;
+                }
+
+                // Loop in the unlikely case the published object was unregistered before we could read it back.
+            }
+
+            return (TObject) published;
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// Pointer to a native object along with it's index and serial number, which tell whether the object is still
+    /// alive, like a native weak object pointer.
+    /// </summary>
+    /// <remarks>
+    /// Creating a handle and checking it are plain reads of the engine's object array, only the first handle to an
+    /// object calls into native code to give it a serial number. No managed wrapper is created until
+    /// <see cref="Get{TObject}"/> is called.
+    /// </remarks>
+    public readonly struct ObjectHandle : IEquatable<ObjectHandle>
+    {
+        /// <summary>
+        /// Pointer to the native object.
+        /// </summary>
+        public readonly IntPtr Pointer;
+
+        /// <summary>
+        /// Index of the object in the global object array.
+        /// </summary>
+        public readonly int Index;
+
+        /// <summary>
+        /// Serial number of the object.
+        /// </summary>
+        public readonly int SerialNumber;
+
+        public ObjectHandle(IntPtr nativeInstance)
+        {
+            Pointer = nativeInstance;
+            if (nativeInstance == IntPtr.Zero)
+            {
+                Index = 0;
+                SerialNumber = 0;
+            }
+            else
+            {
+                SerialNumber = UObjectUtil.GetSerialNumber(nativeInstance, out Index);
+            }
+        }
+
+        /// <summary>
+        /// Whether this handle was never bound to an object.
+        /// </summary>
+        public bool IsNull => Pointer == IntPtr.Zero;
+
+        /// <summary>
+        /// Whether the object is still alive.
+        /// </summary>
+        public bool IsValid => Pointer != IntPtr.Zero && UObjectUtil.IsAlive(Pointer, Index, SerialNumber);
+
+        /// <summary>
+        /// Get the managed wrapper of the object.
+        /// </summary>
+        /// <typeparam name="TObject"></typeparam>
+        /// <returns>The managed object, or null if the object is no longer alive.</returns>
+        public TObject? Get<TObject>()
+            where TObject : UObjectBase
+        {
+            return IsValid ? UObjectBase.GetOrCreateNative<TObject>(Pointer) : null;
+        }
+
+        public bool Equals(ObjectHandle other) => Pointer == other.Pointer && SerialNumber == other.SerialNumber;
+
+        public override bool Equals(object? obj) => obj is ObjectHandle other && Equals(other);
+
+        public override int GetHashCode() => HashCode.Combine(Pointer, SerialNumber);
+
+        public static bool operator ==(ObjectHandle lhs, ObjectHandle rhs) => lhs.Equals(rhs);
+
+        public static bool operator !=(ObjectHandle lhs, ObjectHandle rhs) => !lhs.Equals(rhs);
+    }
+}
@@ -47,10 +47,26 @@ namespace Unreal.Core
             m_parent = new Lazy<ReflectionDataBase?>(GetParentReflectionData);
         }
 
+        /// <summary>
+        /// Whether this type is the same as or derived from <paramref name="other"/>.
+        /// </summary>
+        /// <param name="other"></param>
+        /// <returns></returns>
+        public bool IsChildOf(ReflectionDataBase other)
+        {
+            for (var current = this; current != null; current = current.Parent)
+            {
+                if (current.NativeUClass == other.NativeUClass)
+                    return true;
+            }
+
+            return false;
+        }
+
         private ReflectionDataBase? GetParentReflectionData()
         {
             var parentClass = UObjectUtil.GetSuperClass(NativeUClass);
-            return parentClass == IntPtr.Zero ? null : UObjectReflection.Instance.GetTypeData(parentClass);
+            return parentClass == IntPtr.Zero ? null : UObjectReflection.Instance.GetBestFitType(parentClass);
         }
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 using System;
 using System.Collections.Concurrent;
+using System.Diagnostics.CodeAnalysis;
 using System.Reflection;
 using System.Reflection.Emit;
 using System.Runtime.InteropServices;
@@ -14,6 +15,9 @@ namespace Unreal.Core
         private static unsafe void Init(delegate * unmanaged<char*, void*> entryPointGetter)
         {
             NativeHelpers.Init(entryPointGetter);
+
+            // The plugin initializes the runtime from the game thread.
+            GameThreadSynchronizationContext.Install();
         }
 
         [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__Runtime__Init")]
@@ -33,6 +37,10 @@ namespace Unreal.Core
         /// <param name="typeCharPtr"></param>
         /// <param name="functionCharPtr"></param>
         /// <returns></returns>
+        [UnconditionalSuppressMessage("Trimming", "IL2057",
+            Justification = "Generated modules root the entry points they export.")]
+        [UnconditionalSuppressMessage("Trimming", "IL2075",
+            Justification = "Generated modules root the entry points they export.")]
         public static unsafe void* GetFunctionNative(byte* assemblyCharPtr, byte* typeCharPtr, byte* functionCharPtr)
         {
             var assemblyName = new AssemblyName(NativeHelpers.GetString(assemblyCharPtr));
@@ -0,0 +1,81 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// Runs tasks on the worker threads of the engine's task graph, so managed work shares the engine's workers instead
+    /// of competing with them from the thread pool.
+    /// </summary>
+    /// <remarks>
+    /// Tasks run on workers must not touch UObjects, use <see cref="GameThreadSynchronizationContext"/> to get back to
+    /// the game thread.
+    /// </remarks>
+    public sealed unsafe class TaskGraphScheduler : TaskScheduler
+    {
+        #region PInvoke
+
+        // ReSharper disable InconsistentNaming
+        private static readonly delegate* unmanaged<delegate* unmanaged<IntPtr, void>, IntPtr, void> TaskGraph_Dispatch =
+            (delegate* unmanaged<delegate* unmanaged<IntPtr, void>, IntPtr, void>) NativeHelpers.GetPluginFunction(
+                "TaskGraph_Dispatch");
+        // ReSharper restore InconsistentNaming
+
+        #endregion
+
+        /// <summary>
+        /// The scheduler of the task graph.
+        /// </summary>
+        public static readonly TaskGraphScheduler Instance = new();
+
+        /// <summary>
+        /// Factory that starts tasks on the task graph.
+        /// </summary>
+        public static readonly TaskFactory Factory = new(Instance);
+
+        private int m_pending;
+
+        private TaskGraphScheduler()
+        { }
+
+        /// <summary>
+        /// Number of tasks queued on the task graph that have not run yet.
+        /// </summary>
+        public int PendingCount => Volatile.Read(ref m_pending);
+
+        protected override void QueueTask(Task task)
+        {
+            Interlocked.Increment(ref m_pending);
+            TaskGraph_Dispatch(&Execute, GCHandle.ToIntPtr(GCHandle.Alloc(task)));
+        }
+
+        protected override bool TryExecuteTaskInline(Task task, bool taskWasPreviouslyQueued)
+        {
+            // Queued tasks are already owned by a task graph task.
+            return !taskWasPreviouslyQueued && TryExecuteTask(task);
+        }
+
+        protected override IEnumerable<Task>? GetScheduledTasks()
+        {
+            // Tasks are only tracked by the task graph.
+            return null;
+        }
+
+        [UnmanagedCallersOnly]
+        private static void Execute(IntPtr taskHandle)
+        {
+            var handle = GCHandle.FromIntPtr(taskHandle);
+            var task = (Task) handle.Target!;
+            handle.Free();
+
+            Interlocked.Decrement(ref Instance.m_pending);
+            Instance.TryExecuteTask(task);
+        }
+    }
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Unreal.Core
+{
+    /// <summary>
+    /// Groups in which managed objects tick, values match the engine's ETickingGroup.
+    /// </summary>
+    public enum TickGroup : byte
+    {
+        PrePhysics,
+        StartPhysics,
+        DuringPhysics,
+        EndPhysics,
+        PostPhysics,
+        PostUpdateWork,
+        LastDemotable,
+    }
+
+    /// <summary>
+    /// An object ticked every frame by the <see cref="TickManager"/>.
+    /// </summary>
+    public interface IManagedTickable
+    {
+        void Tick(float deltaTime);
+    }
+
+    /// <summary>
+    /// Ticks managed objects with a single call from the engine per tick group and frame.
+    /// </summary>
+    /// <remarks>
+    /// The plugin registers one tick function per group in the game world. Each of them calls <see cref="Dispatch"/>,
+    /// which ticks the objects of the group from a dense array, so the cost of the transition from native code is paid
+    /// once per group instead of once per object. Groups without objects are disabled and cost nothing.
+    ///
+    /// Registration can be done from any thread without locking and takes effect at the start of the next frame, so
+    /// an object unregistered while ticking still ticks until the end of the current frame.
+    /// </remarks>
+    public static class TickManager
+    {
+        public const int GroupCount = (int) TickGroup.LastDemotable + 1;
+
+        private class Group
+        {
+            public IManagedTickable[] Tickables = new IManagedTickable[16];
+            public int Count;
+        }
+
+        private static readonly Group[] m_groups = CreateGroups();
+
+        /// <summary>
+        /// Group and index of each registered object.
+        /// </summary>
+        private static readonly Dictionary<IManagedTickable, (TickGroup Group, int Index)> m_registered =
+            new(ReferenceEqualityComparer.Instance);
+
+        private static readonly ConcurrentQueue<(IManagedTickable Tickable, TickGroup? Group)> m_pending = new();
+
+        private static Group[] CreateGroups()
+        {
+            var groups = new Group[GroupCount];
+            for (int i = 0; i < groups.Length; ++i)
+                groups[i] = new Group();
+            return groups;
+        }
+
+        /// <summary>
+        /// Tick an object in a group each frame, starting next frame. Registering an object again moves it to the
+        /// new group.
+        /// </summary>
+        /// <param name="tickable"></param>
+        /// <param name="group"></param>
+        public static void Register(IManagedTickable tickable, TickGroup group = TickGroup.PrePhysics)
+        {
+            m_pending.Enqueue((tickable, group));
+        }
+
+        /// <summary>
+        /// Stop ticking an object, starting next frame.
+        /// </summary>
+        /// <param name="tickable"></param>
+        public static void Unregister(IManagedTickable tickable)
+        {
+            m_pending.Enqueue((tickable, null));
+        }
+
+        /// <summary>
+        /// Called with the exceptions thrown by ticking objects, logs them by default.
+        /// </summary>
+        public static Action<IManagedTickable, Exception> ExceptionHandler { get; set; } = LogException;
+
+        /// <summary>
+        /// Number of objects ticking in a group this frame.
+        /// </summary>
+        /// <param name="group"></param>
+        /// <returns></returns>
+        public static int GetCount(TickGroup group) => m_groups[(int) group].Count;
+
+        /// <summary>
+        /// Apply the registrations made since the last frame.
+        /// </summary>
+        /// <remarks>Called by the plugin on the game thread at the start of each frame.</remarks>
+        /// <returns>Mask of the groups that have objects to tick, bit N is set for group N.</returns>
+        public static uint BeginFrame()
+        {
+            while (m_pending.TryDequeue(out var registration))
+            {
+                Remove(registration.Tickable);
+
+                if (registration.Group is { } group)
+                    Add(registration.Tickable, group);
+            }
+
+            uint mask = 0;
+            for (int i = 0; i < GroupCount; ++i)
+            {
+                if (m_groups[i].Count > 0)
+                    mask |= 1u << i;
+            }
+
+            return mask;
+        }
+
+        /// <summary>
+        /// Tick all objects of a group.
+        /// </summary>
+        /// <remarks>
+        /// Exceptions thrown by an object are passed to <see cref="ExceptionHandler"/> and do not prevent the others
+        /// from ticking.
+        /// </remarks>
+        /// <param name="group"></param>
+        /// <param name="deltaTime">Time since the last frame, in seconds.</param>
+        public static void Dispatch(TickGroup group, float deltaTime)
+        {
+            var data = m_groups[(int) group];
+            var tickables = data.Tickables.AsSpan(0, data.Count);
+
+            foreach (var tickable in tickables)
+            {
+                try
+                {
+                    tickable.Tick(deltaTime);
+                }
+                catch (Exception ex)
+                {
+                    ExceptionHandler(tickable, ex);
+                }
+            }
+        }
+
+        private static void LogException(IManagedTickable tickable, Exception ex)
+        {
+            UeLog.Log(LogVerbosity.Error, $"Unhandled exception while ticking {tickable}: {ex}");
+        }
+
+        private static void Add(IManagedTickable tickable, TickGroup group)
+        {
+            var data = m_groups[(int) group];
+
+            if (data.Count == data.Tickables.Length)
+                Array.Resize(ref data.Tickables, data.Count * 2);
+
+            data.Tickables[data.Count] = tickable;
+            m_registered.Add(tickable, (group, data.Count));
+            ++data.Count;
+        }
+
+        private static void Remove(IManagedTickable tickable)
+        {
+            if (!m_registered.Remove(tickable, out var location))
+                return;
+
+            // Swap the last object into the freed slot to keep the array dense.
+            var data = m_groups[(int) location.Group];
+            var last = --data.Count;
+
+            if (location.Index != last)
+            {
+                var moved = data.Tickables[last];
+                data.Tickables[location.Index] = moved;
+                m_registered[moved] = (location.Group, location.Index);
+            }
+
+            data.Tickables[last] = null!;
+        }
+
+        #region Native Entry Points
+
+        private static uint BeginFrameNative()
+        {
+            return BeginFrame();
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__TickManager__BeginFrame")]
+        private static uint BeginFrameAot()
+        {
+            return BeginFrameNative();
+        }
+
+        private static void DispatchNative(byte group, float deltaTime)
+        {
+            Dispatch((TickGroup) group, deltaTime);
+        }
+
+        [UnmanagedCallersOnly(EntryPoint = "Unreal_Core__TickManager__Dispatch")]
+        private static void DispatchAot(byte group, float deltaTime)
+        {
+            DispatchNative(group, deltaTime);
+        }
+
+        #endregion
+    }
+}
@@ -3,6 +3,7 @@
 
 using System;
 using System.ComponentModel;
+using System.Diagnostics.CodeAnalysis;
 using System.Reflection;
 
 namespace Unreal.Core
@@ -18,6 +19,19 @@ namespace Unreal.Core
         /// </summary>
         internal IntPtr NativeObject;
 
+        /// <summary>
+        /// Cached reflection data for the class of the native object.
+        /// </summary>
+        private ReflectionDataBase? m_typeData;
+
+        /// <summary>
+        /// Reflection data for the class of this object.
+        /// </summary>
+        /// <remarks>The class of an object never changes, so this is resolved at most once per instance.</remarks>
+        [EditorBrowsable(EditorBrowsableState.Never)]
+        public ReflectionDataBase TypeData
+            => m_typeData ??= UObjectReflection.Instance.GetBestFitType(UObjectUtil.GetUClass(NativeObject));
+
         // Implemented so the compiler lets you write a class without errors before we insert the actual ctor.
         [EditorBrowsable(EditorBrowsableState.Never)]
         protected UObjectBase()
@@ -38,19 +52,27 @@ namespace Unreal.Core
 
         #region UClass Reflection System
 
+        [UnconditionalSuppressMessage("Trimming", "IL2072",
+            Justification = "The native instance constructors of registered types are rooted by their module.")]
         private static TObject CreateManaged<TObject>(IntPtr nativeInstance)
             where TObject : UObjectBase
         {
             var uClass = UObjectUtil.GetUClass(nativeInstance);
 
-            var type = UObjectReflection.Instance.GetBestFitType(uClass).ManagedType;
+            var typeData = UObjectReflection.Instance.GetBestFitType(uClass);
+            var type = typeData.ManagedType;
 
             if (!typeof(TObject).IsAssignableFrom(type))
                 throw new TypeLoadException(
                     "Best fit managed class for object instance is not assignable to the current expected type.");
 
-            return (TObject) Activator.CreateInstance(type, BindingFlags.Instance | BindingFlags.NonPublic, null,
-                new object[] {nativeInstance}, null)!;
+            var instance = (TObject) Activator.CreateInstance(type, BindingFlags.Instance | BindingFlags.NonPublic,
+                null, new object[] {nativeInstance}, null)!;
+
+            // We already know the class, save the lookup later.
+            instance.m_typeData = typeData;
+
+            return instance;
         }
 
         #endregion
@@ -77,12 +99,12 @@ namespace Unreal.Core
             if (nativeInstance == IntPtr.Zero)
                 return null;
 
-            // TODO: This needs a lock.
+            // Fast path, no allocation.
             var instance = NativeUObjectRegistration.GetUObject<TObject>(nativeInstance);
-            if (instance == null)
-                return CreateManaged<TObject>(nativeInstance);
+            if (instance != null)
+                return instance;
 
-            return instance;
+            return NativeUObjectRegistration.GetOrCreate(nativeInstance, CreateManaged<TObject>);
         }
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Licensed under the MIT license.
 
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 
 namespace Unreal.Core
@@ -32,7 +33,7 @@ namespace Unreal.Core
 
         public void RegisterFactory(IReflectionDataFactory factory)
         {
-            if (m_nativeIndex.Count > 0)
+            if (!m_nativeIndex.IsEmpty)
                 throw new InvalidOperationException(
                     "The reflection data factory can onl;y be set before indexing starts.");
 
@@ -50,7 +51,9 @@ namespace Unreal.Core
 
         #region Reflection Info
 
-        private readonly Dictionary<IntPtr, ReflectionDataBase> m_nativeIndex = new();
+        // The native index is concurrent because best fit entries are appended lazily from whatever thread first
+        // resolves an object of an unknown class.
+        private readonly ConcurrentDictionary<IntPtr, ReflectionDataBase> m_nativeIndex = new();
 
         private readonly Dictionary<Type, ReflectionDataBase> m_managedIndex = new();
 
@@ -58,7 +61,8 @@ namespace Unreal.Core
         {
             var data = m_factory.Create(nativeUClass, managedType, implementation);
 
-            m_nativeIndex.Add(nativeUClass, data);
+            if (!m_nativeIndex.TryAdd(nativeUClass, data))
+                throw new ArgumentException("The native class was already registered.", nameof(nativeUClass));
             m_managedIndex.Add(managedType, data);
         }
 
@@ -120,11 +124,11 @@ namespace Unreal.Core
             if (typeData == null)
                 throw new TypeLoadException("No component of the type's hierarchy is known.");
 
-            // Cache result of search for next use.
+            // Cache result of search for next use. If another thread got there first we use it's entry instead.
             if (bestFitClass != uClassHandle)
             {
                 typeData = m_factory.Create(uClassHandle, typeData.ManagedType, typeData.Implementation, true);
-                m_nativeIndex.Add(uClassHandle, typeData);
+                typeData = m_nativeIndex.GetOrAdd(uClassHandle, typeData);
             }
 
             return typeData;
@@ -3,6 +3,8 @@
 
 using System;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading;
 
 namespace Unreal.Core
 {
@@ -22,8 +24,48 @@ namespace Unreal.Core
         
         private static readonly unsafe delegate* unmanaged<IntPtr, IntPtr> UClass_GetSuperClass =
             (delegate* unmanaged<IntPtr, IntPtr>) NativeHelpers.GetPluginFunction("UClass_GetSuperClass");
+
+        private static readonly unsafe delegate* unmanaged<IntPtr, int*, int> NativeHelper_GetObjectSerialNumber =
+            (delegate* unmanaged<IntPtr, int*, int>) NativeHelpers.GetPluginFunction(
+                "NativeHelper_GetObjectSerialNumber");
+
+        private static readonly unsafe delegate* unmanaged<ObjectArrayLayout*, void> NativeHelper_GetObjectArrayLayout =
+            (delegate* unmanaged<ObjectArrayLayout*, void>) NativeHelpers.GetPluginFunction(
+                "NativeHelper_GetObjectArrayLayout");
+
+        private static readonly unsafe delegate* unmanaged<int, byte*> NativeHelper_GetObjectItem =
+            (delegate* unmanaged<int, byte*>) NativeHelpers.GetPluginFunction("NativeHelper_GetObjectItem");
         // ReSharper restore InconsistentNaming
 
+        /// <summary>
+        /// Layout of the engine's global object array, layout must match FDotNetObjectArrayLayout in NativeHelper.cpp.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        private unsafe struct ObjectArrayLayout
+        {
+            /// <summary>
+            /// Table of the chunks of the array, null when the plugin could not validate it.
+            /// </summary>
+            public IntPtr* Chunks;
+            public int ElementsPerChunk;
+            public int MaxElements;
+            public int ItemSize;
+            public int ObjectOffset;
+            public int FlagsOffset;
+            public int SerialNumberOffset;
+            public int DeadFlags;
+            public int InternalIndexOffset;
+        }
+
+        private static readonly ObjectArrayLayout ObjectArray = GetObjectArrayLayout();
+
+        private static unsafe ObjectArrayLayout GetObjectArrayLayout()
+        {
+            ObjectArrayLayout layout;
+            NativeHelper_GetObjectArrayLayout(&layout);
+            return layout;
+        }
+
         /// <summary>
         /// Get a pointer to the native counterpart of a managed UObject instance.
         /// </summary>
@@ -60,6 +102,68 @@ namespace Unreal.Core
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public static unsafe IntPtr GetSuperClass(IntPtr classHandle) => UClass_GetSuperClass(classHandle);
 
+        /// <summary>
+        /// Get the serial number of a native object, allocating one if the object did not have one yet.
+        /// </summary>
+        /// <remarks>The pair of index and serial number identifies an object for it's whole lifetime,
+        /// the same way a native weak object pointer does. The serial number is kept by the engine with the object, so
+        /// only the first call for an object calls into native code.</remarks>
+        /// <param name="nativeInstance">The native object.</param>
+        /// <param name="index">Index of the object in the global object array.</param>
+        /// <returns>The serial number of the object.</returns>
+        public static unsafe int GetSerialNumber(IntPtr nativeInstance, out int index)
+        {
+            index = *(int*) ((byte*) nativeInstance + ObjectArray.InternalIndexOffset);
+
+            var item = GetObjectItem(index);
+            var serialNumber = item == null ? 0 : Volatile.Read(ref *(int*) (item + ObjectArray.SerialNumberOffset));
+            if (serialNumber != 0)
+                return serialNumber;
+
+            int objectIndex;
+            return NativeHelper_GetObjectSerialNumber(nativeInstance, &objectIndex);
+        }
+
+        /// <summary>
+        /// Whether a native object identified by it's index and serial number is still alive.
+        /// </summary>
+        /// <remarks>Reads the object array directly, without calling into native code.</remarks>
+        /// <param name="nativeInstance">The native object.</param>
+        /// <param name="index">Index of the object in the global object array.</param>
+        /// <param name="serialNumber">Serial number of the object.</param>
+        /// <returns></returns>
+        public static unsafe bool IsAlive(IntPtr nativeInstance, int index, int serialNumber)
+        {
+            var item = GetObjectItem(index);
+
+            return item != null
+                && Volatile.Read(ref *(IntPtr*) (item + ObjectArray.ObjectOffset)) == nativeInstance
+                && Volatile.Read(ref *(int*) (item + ObjectArray.SerialNumberOffset)) == serialNumber
+                && (Volatile.Read(ref *(int*) (item + ObjectArray.FlagsOffset)) & ObjectArray.DeadFlags) == 0;
+        }
+
+        /// <summary>
+        /// Get the slot of the object array at an index.
+        /// </summary>
+        /// <remarks>Reads the chunk table of the array when the plugin could validate it, otherwise asks the
+        /// engine.</remarks>
+        /// <param name="index"></param>
+        /// <returns>The slot, or null if the index is out of the array.</returns>
+        private static unsafe byte* GetObjectItem(int index)
+        {
+            if ((uint) index >= (uint) ObjectArray.MaxElements)
+                return null;
+
+            if (ObjectArray.Chunks == null)
+                return NativeHelper_GetObjectItem(index);
+
+            var chunk = (byte*) Volatile.Read(ref ObjectArray.Chunks[index / ObjectArray.ElementsPerChunk]);
+            if (chunk == null)
+                return null;
+
+            return chunk + (long) (index % ObjectArray.ElementsPerChunk) * ObjectArray.ItemSize;
+        }
+
         /// <summary>
         /// Create a new object given type and outer instance.
         /// </summary>
@@ -1,31 +1,450 @@
 // Copyright (c) 2021 Keen Software House
 // Licensed under the MIT license.
 
+using System;
+using System.Buffers;
+using System.Threading;
+
 namespace Unreal.Core
 {
     /// <summary>
     /// Provides methods for interacting with the UE Logging system.
     /// </summary>
-    public static class UeLog
+    /// <remarks>
+    /// Messages are checked against the verbosity of the LogClr category before anything is formatted, the verbosity
+    /// is read from memory the plugin keeps in sync with the category, so a disabled log statement costs a branch.
+    /// Enabled messages are formatted into pooled buffers and submitted to the engine in batches, once per frame or
+    /// when the batch fills up. Errors and fatal errors are submitted right away, along with the messages before them.
+    /// </remarks>
+    public static unsafe class UeLog
     {
         #region PInvoke
 
         // ReSharper disable InconsistentNaming
-        private static readonly unsafe delegate * unmanaged<byte, char*, void> UeLog_Log =
-            (delegate * unmanaged<byte, char*, void>) NativeHelpers.GetPluginFunction("UeLog_Log");
+        private static readonly delegate* unmanaged<byte, char*, void> UeLog_Log =
+            (delegate* unmanaged<byte, char*, void>) NativeHelpers.GetPluginFunction("UeLog_Log");
+
+        private static readonly delegate* unmanaged<int, byte*, char*, void> UeLog_LogBatch =
+            (delegate* unmanaged<int, byte*, char*, void>) NativeHelpers.GetPluginFunction("UeLog_LogBatch");
+
+        private static readonly delegate* unmanaged<byte*> UeLog_GetVerbosity =
+            (delegate* unmanaged<byte*>) NativeHelpers.GetPluginFunction("UeLog_GetVerbosity");
         // ReSharper restore InconsistentNaming
 
         #endregion
 
+        /// <summary>
+        /// Verbosity of the LogClr category, updated by the plugin once per frame.
+        /// </summary>
+        private static readonly byte* m_verbosity = UeLog_GetVerbosity();
+
+        /// <summary>
+        /// Number of messages held by a batch.
+        /// </summary>
+        private const int BatchMessages = 256;
+
+        /// <summary>
+        /// Number of characters held by a batch, longer messages are submitted on their own.
+        /// </summary>
+        private const int BatchChars = 32 * 1024;
+
+        private static readonly object m_batchLock = new();
+
+        private static readonly byte[] m_batchVerbosities = new byte[BatchMessages];
+
+        // Messages are stored one after the other, null terminated.
+        private static readonly char[] m_batchChars = new char[BatchChars];
+
+        private static int m_batchCount;
+
+        private static int m_batchLength;
+
+        /// <summary>
+        /// Whether messages of a verbosity are written to the log.
+        /// </summary>
+        /// <remarks>Fatal messages are always written, like the engine does whatever the verbosity of the
+        /// category.</remarks>
+        /// <param name="verbosity"></param>
+        /// <returns></returns>
+        public static bool IsEnabled(LogVerbosity verbosity)
+        {
+            return verbosity == LogVerbosity.Fatal || (byte) verbosity <= *m_verbosity;
+        }
+
         /// <summary>
         /// Write a message to the engine's log.
         /// </summary>
         /// <param name="verbosity"></param>
         /// <param name="message"></param>
-        public static unsafe void Log(LogVerbosity verbosity, string message)
+        public static void Log(LogVerbosity verbosity, string message)
+        {
+            if (IsEnabled(verbosity))
+                Submit(verbosity, message);
+        }
+
+        /// <summary>
+        /// Format and write a message to the engine's log, if it's verbosity is enabled.
+        /// </summary>
+        /// <remarks>
+        /// Takes the same format as <see cref="string.Format(string, object)"/>. Primitives and strings are formatted
+        /// without allocating.
+        /// </remarks>
+        /// <param name="verbosity"></param>
+        /// <param name="format"></param>
+        /// <param name="arg0"></param>
+        /// <typeparam name="T0"></typeparam>
+        public static void Log<T0>(LogVerbosity verbosity, string format, T0 arg0)
+        {
+            if (IsEnabled(verbosity))
+                Format(verbosity, format, 1, arg0, 0, 0, 0);
+        }
+
+        /// <inheritdoc cref="Log{T0}"/>
+        public static void Log<T0, T1>(LogVerbosity verbosity, string format, T0 arg0, T1 arg1)
+        {
+            if (IsEnabled(verbosity))
+                Format(verbosity, format, 2, arg0, arg1, 0, 0);
+        }
+
+        /// <inheritdoc cref="Log{T0}"/>
+        public static void Log<T0, T1, T2>(LogVerbosity verbosity, string format, T0 arg0, T1 arg1, T2 arg2)
         {
-            fixed (char* chars = message)
-                UeLog_Log((byte) verbosity, chars);
+            if (IsEnabled(verbosity))
+                Format(verbosity, format, 3, arg0, arg1, arg2, 0);
+        }
+
+        /// <inheritdoc cref="Log{T0}"/>
+        public static void Log<T0, T1, T2, T3>(LogVerbosity verbosity, string format, T0 arg0, T1 arg1, T2 arg2,
+            T3 arg3)
+        {
+            if (IsEnabled(verbosity))
+                Format(verbosity, format, 4, arg0, arg1, arg2, arg3);
+        }
+
+        /// <summary>
+        /// Start building a message, for messages that do not fit the format overloads of <see cref="Log{T0}"/>.
+        /// </summary>
+        /// <remarks>Check <see cref="IsEnabled"/> first, the message is formatted regardless.</remarks>
+        /// <param name="verbosity"></param>
+        /// <returns></returns>
+        public static LogMessage Begin(LogVerbosity verbosity)
+        {
+            return new(verbosity);
+        }
+
+        /// <summary>
+        /// Submit the batched messages to the engine.
+        /// </summary>
+        /// <remarks>Called by the plugin at the start of each frame.</remarks>
+        public static void Flush()
+        {
+            lock (m_batchLock)
+                FlushLocked();
+        }
+
+        private static void Format<T0, T1, T2, T3>(LogVerbosity verbosity, string format, int argCount, T0 arg0,
+            T1 arg1, T2 arg2, T3 arg3)
+        {
+            var message = new LogMessage(verbosity);
+
+            try
+            {
+                var literalStart = 0;
+                for (int i = 0; i < format.Length; ++i)
+                {
+                    var c = format[i];
+                    if (c != '{' && c != '}')
+                        continue;
+
+                    message.AppendLiteral(format.AsSpan(literalStart, i - literalStart));
+
+                    // Escaped braces.
+                    if (i + 1 < format.Length && format[i + 1] == c)
+                    {
+                        literalStart = ++i;
+                        continue;
+                    }
+
+                    if (c == '}')
+                        throw new FormatException("Unexpected '}' in log format.");
+
+                    var end = format.IndexOf('}', i);
+                    if (end < 0)
+                        throw new FormatException("Missing '}' in log format.");
+
+                    var hole = format.AsSpan(i + 1, end - i - 1);
+                    var formatStart = hole.IndexOf(':');
+                    var itemFormat = formatStart < 0 ? default : hole.Slice(formatStart + 1);
+                    if (formatStart >= 0)
+                        hole = hole.Slice(0, formatStart);
+
+                    var alignment = 0;
+                    var alignmentStart = hole.IndexOf(',');
+                    if (alignmentStart >= 0)
+                    {
+                        alignment = int.Parse(hole.Slice(alignmentStart + 1));
+                        hole = hole.Slice(0, alignmentStart);
+                    }
+
+                    var index = int.Parse(hole);
+                    if (index < 0 || index >= argCount)
+                        throw new FormatException($"Log format references argument {index} of {argCount}.");
+
+                    switch (index)
+                    {
+                        case 0:
+                            message.AppendFormatted(arg0, alignment, itemFormat);
+                            break;
+                        case 1:
+                            message.AppendFormatted(arg1, alignment, itemFormat);
+                            break;
+                        case 2:
+                            message.AppendFormatted(arg2, alignment, itemFormat);
+                            break;
+                        default:
+                            message.AppendFormatted(arg3, alignment, itemFormat);
+                            break;
+                    }
+
+                    i = end;
+                    literalStart = end + 1;
+                }
+
+                message.AppendLiteral(format.AsSpan(literalStart));
+                message.Submit();
+            }
+            finally
+            {
+                message.Dispose();
+            }
+        }
+
+        internal static void Submit(LogVerbosity verbosity, ReadOnlySpan<char> message)
+        {
+            lock (m_batchLock)
+            {
+                if (message.Length + 1 > BatchChars)
+                {
+                    // Too long to batch, keep the order of messages by submitting the batch first.
+                    FlushLocked();
+
+                    fixed (char* chars = message.ToString())
+                        UeLog_Log((byte) verbosity, chars);
+                    return;
+                }
+
+                if (m_batchCount == BatchMessages || m_batchLength + message.Length + 1 > BatchChars)
+                    FlushLocked();
+
+                m_batchVerbosities[m_batchCount++] = (byte) verbosity;
+                message.CopyTo(m_batchChars.AsSpan(m_batchLength));
+                m_batchLength += message.Length;
+                m_batchChars[m_batchLength++] = '\0';
+
+                if (verbosity <= LogVerbosity.Error)
+                    FlushLocked();
+            }
+        }
+
+        private static void FlushLocked()
+        {
+            if (m_batchCount == 0)
+                return;
+
+            fixed (byte* verbosities = m_batchVerbosities)
+            fixed (char* chars = m_batchChars)
+                UeLog_LogBatch(m_batchCount, verbosities, chars);
+
+            m_batchCount = 0;
+            m_batchLength = 0;
+        }
+
+        #region Native Entry Points
+
+        private static void FlushNative()
+        {
+            Flush();
+        }
+
+        [System.Runtime.InteropServices.UnmanagedCallersOnly(EntryPoint = "Unreal_Core__UeLog__Flush")]
+        private static void FlushAot()
+        {
+            FlushNative();
+        }
+
+        #endregion
+    }
+
+    /// <summary>
+    /// A log message being formatted into a pooled buffer, see <see cref="UeLog.Begin"/>.
+    /// </summary>
+    /// <remarks>
+    /// Shaped like an interpolated string handler, so it can become one once the projects move to C# 10. Being a
+    /// mutable struct it must not be held in a using statement, call <see cref="Submit"/> or <see cref="Dispose"/>.
+    /// </remarks>
+    public struct LogMessage : IDisposable
+    {
+        private readonly LogVerbosity m_verbosity;
+
+        private char[] m_buffer;
+
+        private int m_length;
+
+        internal LogMessage(LogVerbosity verbosity)
+        {
+            m_verbosity = verbosity;
+            m_buffer = ArrayPool<char>.Shared.Rent(256);
+            m_length = 0;
+        }
+
+        /// <summary>
+        /// The message formatted so far.
+        /// </summary>
+        public ReadOnlySpan<char> Text => m_buffer.AsSpan(0, m_length);
+
+        public void AppendLiteral(string value)
+        {
+            AppendLiteral(value.AsSpan());
+        }
+
+        public void AppendLiteral(ReadOnlySpan<char> value)
+        {
+            Reserve(value.Length);
+            value.CopyTo(m_buffer.AsSpan(m_length));
+            m_length += value.Length;
+        }
+
+        public void AppendFormatted<T>(T value)
+        {
+            AppendFormatted(value, 0, default);
+        }
+
+        public void AppendFormatted<T>(T value, string? format)
+        {
+            AppendFormatted(value, 0, format);
+        }
+
+        /// <summary>
+        /// Append a value, primitives and strings are formatted without allocating.
+        /// </summary>
+        /// <param name="value"></param>
+        /// <param name="alignment">Minimum width, values are right aligned if positive and left aligned if negative.</param>
+        /// <param name="format">Format of the value.</param>
+        /// <typeparam name="T"></typeparam>
+        public void AppendFormatted<T>(T value, int alignment, ReadOnlySpan<char> format)
+        {
+            var start = m_length;
+
+            int written;
+            while (!TryFormat(value, m_buffer.AsSpan(m_length), out written, format))
+                Grow(written);
+            m_length += written;
+
+            var padding = Math.Abs(alignment) - written;
+            if (padding <= 0)
+                return;
+
+            Reserve(padding);
+            if (alignment > 0)
+            {
+                m_buffer.AsSpan(start, written).CopyTo(m_buffer.AsSpan(start + padding));
+                m_buffer.AsSpan(start, padding).Fill(' ');
+            }
+            else
+            {
+                m_buffer.AsSpan(m_length, padding).Fill(' ');
+            }
+
+            m_length += padding;
+        }
+
+        /// <summary>
+        /// Write the message to the log and release the buffer.
+        /// </summary>
+        public void Submit()
+        {
+            UeLog.Submit(m_verbosity, Text);
+            Dispose();
+        }
+
+        public void Dispose()
+        {
+            if (m_buffer == null || m_buffer.Length == 0)
+                return;
+
+            ArrayPool<char>.Shared.Return(m_buffer);
+            m_buffer = Array.Empty<char>();
+            m_length = 0;
+        }
+
+        private void Reserve(int count)
+        {
+            if (m_length + count > m_buffer.Length)
+                Grow(count);
+        }
+
+        private void Grow(int count)
+        {
+            var buffer = ArrayPool<char>.Shared.Rent(Math.Max(m_buffer.Length * 2, m_length + count));
+            m_buffer.AsSpan(0, m_length).CopyTo(buffer);
+            ArrayPool<char>.Shared.Return(m_buffer);
+            m_buffer = buffer;
+        }
+
+        // Type checks on T are resolved when the method is compiled for a value type, so the casts do not box.
+        private static bool TryFormat<T>(T value, Span<char> destination, out int written, ReadOnlySpan<char> format)
+        {
+            if (typeof(T) == typeof(int))
+                return ((int) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(uint))
+                return ((uint) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(long))
+                return ((long) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(ulong))
+                return ((ulong) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(short))
+                return ((short) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(ushort))
+                return ((ushort) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(byte))
+                return ((byte) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(sbyte))
+                return ((sbyte) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(float))
+                return ((float) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(double))
+                return ((double) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(decimal))
+                return ((decimal) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(bool))
+                return ((bool) (object) value!).TryFormat(destination, out written);
+            if (typeof(T) == typeof(TimeSpan))
+                return ((TimeSpan) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(DateTime))
+                return ((DateTime) (object) value!).TryFormat(destination, out written, format);
+            if (typeof(T) == typeof(Guid))
+                return ((Guid) (object) value!).TryFormat(destination, out written, format);
+
+            if (typeof(T) == typeof(char))
+            {
+                written = 1;
+                if (destination.IsEmpty)
+                    return false;
+                destination[0] = (char) (object) value!;
+                return true;
+            }
+
+            // Anything else allocates it's string.
+            var str = value switch
+            {
+                null => "",
+                string s => s,
+                IFormattable formattable => formattable.ToString(format.IsEmpty ? null : format.ToString(), null),
+                _ => value.ToString() ?? ""
+            };
+
+            written = str.Length;
+            return str.AsSpan().TryCopyTo(destination);
         }
     }
-}
\ No newline at end of file
+}
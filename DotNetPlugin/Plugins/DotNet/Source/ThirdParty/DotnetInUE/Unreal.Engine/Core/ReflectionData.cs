@@ -10,16 +10,24 @@ namespace Unreal.Core
 {
     public class ReflectionData : ReflectionDataBase
     {
-        private readonly Lazy<UClass> m_class;
+        private UClass? m_class;
 
-        public UClass Class => m_class.Value;
+        /// <summary>
+        /// The class instance this reflection data describes.
+        /// </summary>
+        public UClass Class => m_class ??= GetClass();
 
         private ReflectionData(IntPtr nativeUClass, Type managedType, TypeImplementation implementation,
             bool isBestFit = false)
             : base(nativeUClass, managedType, implementation, isBestFit)
+        { }
+
+        private UClass GetClass()
         {
             // nativeClass cannot be null, our base validates this.
-            m_class = new Lazy<UClass>(() => UObjectBase.GetOrCreateNative<UClass>(nativeUClass)!);
+            var uClass = UObjectBase.GetOrCreateNative<UClass>(NativeUClass)!;
+            uClass.BindReflection(this);
+            return uClass;
         }
         
         [EditorBrowsable(EditorBrowsableState.Never)]
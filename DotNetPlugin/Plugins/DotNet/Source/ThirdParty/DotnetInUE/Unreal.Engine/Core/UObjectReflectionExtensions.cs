@@ -37,7 +37,7 @@ namespace Unreal.Core
         /// <returns></returns>
         public static ReflectionData GetTypeData(this UObjectReflection self, UObject instance)
         {
-            return (ReflectionData) self.GetTypeData(UObjectUtil.GetUClass(instance));
+            return (ReflectionData) instance.TypeData;
         }
 
         /// <summary>
@@ -2,37 +2,37 @@
 // Licensed under the MIT license.
 
 using System;
-using System.Reflection;
 using Unreal.Core;
 
 namespace Unreal.CoreUObject
 {
     public partial class UClass
     {
+        private ReflectionData? m_reflection;
+
         /// <summary>
         /// The implementation of the type represented by this UClass instance.
         /// </summary>
-        public TypeImplementation Implementation { get; private set; }
+        public TypeImplementation Implementation => Reflection.Implementation;
 
         /// <summary>
         /// Reflection data for this class.
         /// </summary>
-        public ReflectionData Reflection { get; private set; }
-        
+        /// <remarks>Best fit because this UClass could be coming from native code about some type we don't know.</remarks>
+        public ReflectionData Reflection => m_reflection ??= UObjectReflection.Instance.GetBestFitType(this);
+
         /// <summary>
         /// Parent UClass.
         /// </summary>
         public UClass? ParentClass => Reflection.GetParent()?.Class;
 
-        [Constructor]
-        private void Construct()
+        /// <summary>
+        /// Called by the reflection data that created this class instance so it does not need to be looked up again.
+        /// </summary>
+        /// <param name="reflection"></param>
+        internal void BindReflection(ReflectionData reflection)
         {
-            Implementation = typeof(UClass).IsDefined<ManagedTypeAttribute>()
-                ? TypeImplementation.Managed
-                : TypeImplementation.Native;
-
-            // Get best fit because this UClass could be coming from native code about some type we don't know.
-            Reflection = UObjectReflection.Instance.GetBestFitType(this);
+            m_reflection ??= reflection;
         }
 
         /// <summary>
@@ -64,15 +64,17 @@ namespace Unreal.CoreUObject
         /// <returns></returns>
         public bool IsBaseClassOf(UClass derived)
         {
-            var cl = derived;
-            while (cl != this)
-            {
-                if (cl.ParentClass == null)
-                    return false;
-                cl = cl.ParentClass;
-            }
+            return derived.Reflection.IsChildOf(Reflection);
+        }
 
-            return true;
+        /// <summary>
+        /// Whether the current class is equal to or derived from <paramref name="parent"/>.
+        /// </summary>
+        /// <param name="parent"></param>
+        /// <returns></returns>
+        public bool IsChildOf(UClass parent)
+        {
+            return Reflection.IsChildOf(parent.Reflection);
         }
     }
 }
\ No newline at end of file
@@ -8,6 +8,28 @@ namespace Unreal.CoreUObject
 {
     public partial class UObject : UObjectBase
     {
+        /// <summary>
+        /// Whether this object is an instance of <paramref name="uClass"/> or any of it's subclasses.
+        /// </summary>
+        /// <param name="uClass"></param>
+        /// <returns></returns>
+        public bool IsA(UClass uClass)
+        {
+            return TypeData.IsChildOf(uClass.Reflection);
+        }
+
+        /// <summary>
+        /// Whether this object is an instance of <typeparamref name="TClass"/> or any of it's subclasses.
+        /// </summary>
+        /// <typeparam name="TClass"></typeparam>
+        /// <returns></returns>
+        /// <remarks>Managed wrappers always mirror the native hierarchy, so this is a plain type check.</remarks>
+        public bool IsA<TClass>()
+            where TClass : UObject
+        {
+            return this is TClass;
+        }
+
         public static TClass NewObject<TClass>(UClass uClass, UObject outer)
             where TClass : UObject
         {
@@ -0,0 +1,89 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.ComponentModel;
+using Unreal.Core;
+using Unreal.CoreUObject;
+using Unreal.Marshalling;
+
+namespace Unreal
+{
+    /// <summary>
+    /// Lightweight handle to a native object that does not require a managed wrapper.
+    /// </summary>
+    /// <remarks>
+    /// Object references are meant for transient access, such as query results, where allocating and
+    /// registering a <see cref="UObject"/> wrapper for every object would be wasteful. The handle records
+    /// the object's serial number so it can tell whether the object it points to is still alive, and is
+    /// only promoted to a full wrapper when <see cref="Get"/> is called.
+    ///
+    /// The native counterpart is TWeakObjectPtr, so weak object parameters and properties, such as the actor and
+    /// component of hit and overlap results, are bound as references.
+    /// </remarks>
+    /// <typeparam name="TObject">The type of the referenced object.</typeparam>
+    [NativeType("TWeakObjectPtr", "WeakObjectProperty", TypeMemoryKind.ValueType,
+        typeof(UObject), TypeTransformation.OpaquePointer)]
+    [Header("UObject/WeakObjectPtrTemplates.h")]
+    [MarshalFormats(fromManagedToIntermediate: "{0}.Handle", // Pass object pointer.
+        fromIntermediateToManaged: "new ({0})", // Capture serial number.
+        fromNativeToIntermediate: "{0}.Get()", // Get object, null if it is dead.
+        fromIntermediateToNative: "{0}")] // Set from object.
+    public readonly struct UObjectRef<TObject> : IEquatable<UObjectRef<TObject>>
+        where TObject : UObject
+    {
+        private readonly ObjectHandle m_handle;
+
+        /// <summary>
+        /// Pointer to the native object.
+        /// </summary>
+        [EditorBrowsable(EditorBrowsableState.Never)]
+        public IntPtr Handle => m_handle.Pointer;
+
+        /// <summary>
+        /// Whether this reference was never bound to an object.
+        /// </summary>
+        public bool IsNull => m_handle.IsNull;
+
+        /// <summary>
+        /// Whether the referenced object is still alive.
+        /// </summary>
+        public bool IsValid => m_handle.IsValid;
+
+        [EditorBrowsable(EditorBrowsableState.Never)]
+        public UObjectRef(IntPtr handle)
+        {
+            m_handle = new ObjectHandle(handle);
+        }
+
+        /// <summary>
+        /// Get the managed wrapper for the referenced object.
+        /// </summary>
+        /// <returns>The managed object, or null if the object is no longer alive.</returns>
+        public TObject? Get() => m_handle.Get<TObject>();
+
+        /// <summary>
+        /// Get the managed wrapper for the referenced object.
+        /// </summary>
+        /// <param name="instance">The managed object.</param>
+        /// <returns>Whether the object is still alive.</returns>
+        public bool TryGet(out TObject instance)
+        {
+            instance = Get()!;
+            return instance != null;
+        }
+
+        public bool Equals(UObjectRef<TObject> other) => m_handle == other.m_handle;
+
+        public override bool Equals(object? obj) => obj is UObjectRef<TObject> other && Equals(other);
+
+        public override int GetHashCode() => m_handle.GetHashCode();
+
+        public static bool operator ==(UObjectRef<TObject> lhs, UObjectRef<TObject> rhs) => lhs.Equals(rhs);
+
+        public static bool operator !=(UObjectRef<TObject> lhs, UObjectRef<TObject> rhs) => !lhs.Equals(rhs);
+
+        public static implicit operator UObjectRef<TObject>(TObject? instance)
+            => new(UObjectUtil.GetNativeInstance(instance!));
+    }
+}
@@ -101,13 +101,9 @@ namespace Unreal.Generation
                 getClass.WithAttribute(SymbolAttribute.Override);
             writer.AddMember(new FunctionWriter(getClass.Build(), Codespace.Managed)
             {
-                // Class body must first check if the current class is the same as the native one.
-                // If they differ return the native uclass instead.
-                CustomBody = $@"var nativeClass = UObjectUtil.GetUClass(this);
-if (nativeClass == ModuleHelper.GetNativeMetaInstance({index}))
-    return StaticClass();
-else
-    return GetOrCreateNative<UClass>(nativeClass);"
+                // The class of an object never changes, the reflection data is cached by the instance and
+                // already knows the exact native class, even when it is a subtype of this one.
+                CustomBody = "return ((ReflectionData) TypeData).Class;"
             });
         }
     }
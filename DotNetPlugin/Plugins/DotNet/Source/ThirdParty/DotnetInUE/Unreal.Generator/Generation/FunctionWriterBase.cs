@@ -23,6 +23,29 @@ namespace Unreal.Generation
         /// </summary>
         public string? CustomBody { get; set; }
 
+        /// <summary>
+        /// Header declaring the instrumentation of bindings.
+        /// </summary>
+        public const string InstrumentationHeader = "DotNetBindingStats.h";
+
+        private bool m_isInstrumented;
+
+        /// <summary>
+        /// Whether the native side of the binding records its calls, see <see cref="InstrumentationHeader"/>.
+        /// </summary>
+        public bool IsInstrumented
+        {
+            get => m_isInstrumented;
+            set
+            {
+                m_isInstrumented = value;
+                if (value)
+                    AdditionalHeaders.Add(InstrumentationHeader);
+                else
+                    AdditionalHeaders.Remove(InstrumentationHeader);
+            }
+        }
+
         public FunctionWriterBase(FunctionDefinition member,
             MemberCodeComponentFlags components = MemberCodeComponentFlags.None)
             : base(member, components)
@@ -42,6 +65,16 @@ namespace Unreal.Generation
                 yield return dep;
         }
 
+        /// <summary>
+        /// Open the instrumentation scope at the start of a native function body, if the binding is instrumented.
+        /// </summary>
+        /// <param name="writer"></param>
+        protected void WriteInstrumentationScope(CodeWriter writer)
+        {
+            if (IsInstrumented)
+                writer.WriteLine($"DOTNET_BINDING_SCOPE(\"{Member.EnclosingType.NativeName}::{Member.Name}\");");
+        }
+
         protected void WriteNativeSignature(CodeWriter writer)
         {
             WriteComments(writer, Codespace.Native);
@@ -177,7 +210,16 @@ namespace Unreal.Generation
             return sb.ToString();
         }
 
-        protected void WriteBindingCall(CodeWriter writer, Codespace sourceSpace, Order order)
+        /// <summary>
+        /// Write the marshalling and the call to the other side of the binding.
+        /// </summary>
+        /// <param name="writer"></param>
+        /// <param name="sourceSpace">Codespace the call originates from.</param>
+        /// <param name="order"></param>
+        /// <param name="self">Native expression for the instance, when calling into managed code.</param>
+        /// <param name="result">Native lvalue the return value is stored to instead of being returned.</param>
+        protected void WriteBindingCall(CodeWriter writer, Codespace sourceSpace, Order order, string self = "this",
+            string? result = null)
         {
             string varKeyword = sourceSpace.IsManaged() ? "var" : "auto";
 
@@ -190,13 +232,18 @@ namespace Unreal.Generation
             {
                 if (Marshalling.HasThis)
                     writer.WriteLine(
-                        $"{Member.EnclosingType.FormatName(sourceSpace)} {Marshalling.Parameters[0].Name} = this;");
+                        $"{Member.EnclosingType.FormatName(sourceSpace)} {Marshalling.Parameters[0].Name} = {self};");
 
                 if (Marshalling.HasModifiedReturn)
                 {
                     ref var ret = ref Marshalling.GetReturnParameter();
                     var varType = ret.OriginalType.TypeInfo.FormatName(sourceSpace);
-                    writer.WriteLine($"{varType} {Marshalling.Return.Name};");
+
+                    // Write the returned value in place when there is a result.
+                    if (result != null)
+                        writer.WriteLine($"{varType}& {Marshalling.Return.Name} = {result};");
+                    else
+                        writer.WriteLine($"{varType} {Marshalling.Return.Name};");
                 }
             }
 
@@ -241,7 +288,7 @@ namespace Unreal.Generation
                 }
                 else
                 {
-                    writer.Write("return ");
+                    writer.Write(result != null ? $"{result} = " : "return ");
                 }
             }
             else if (Marshalling.HasModifiedReturn && order == Order.After)
@@ -249,29 +296,19 @@ namespace Unreal.Generation
                 writer.Write($"{Marshalling.Return.Name} = ");
             }
 
+            var arguments = FormatMarshalledArgumentList(true, sourceSpace, nextOrder);
             if (order == Order.Before)
             {
                 writer.Write(Member.EntryPointName);
+
+                using (writer.OpenParenthesis(";\n"))
+                    writer.Write(arguments);
             }
             else
             {
-                if (IsStatic)
-                {
-                    writer.Write(Member.EnclosingType.Name);
-                    writer.Write(sourceSpace.IsManaged() ? "." : "::");
-                }
-                else
-                {
-                    writer.Write(Marshalling.Parameters[0].Name);
-                    writer.Write(sourceSpace.IsManaged() ? "." : "->");
-                }
-
-                writer.Write(Member.Name);
+                WriteTargetCall(writer, sourceSpace, arguments);
             }
 
-            using (writer.OpenParenthesis(";\n"))
-                writer.Write(FormatMarshalledArgumentList(true, sourceSpace, nextOrder));
-
             if (hasOutArguments)
             {
                 var marshalOutOrder = order.GetOpposite();
@@ -302,14 +339,41 @@ namespace Unreal.Generation
                 }
 
                 // For some types this will generate code that could be simplified, but at little cost to the actual performance so not bothering.
-                writer.WriteLine($"return {Marshalling.Return.Name};");
+                writer.WriteLine(result != null
+                    ? $"{result} = {Marshalling.Return.Name};"
+                    : $"return {Marshalling.Return.Name};");
             }
-            else if (Marshalling.HasModifiedReturn && order == Order.Before)
+            else if (Marshalling.HasModifiedReturn && order == Order.Before && result == null)
             {
                 writer.WriteLine($"return {Marshalling.GetReturnParameter().Name};");
             }
         }
 
+        /// <summary>
+        /// Write the call to the bound function once all arguments are marshalled.
+        /// </summary>
+        /// <param name="writer"></param>
+        /// <param name="space">Codespace of the bound function.</param>
+        /// <param name="arguments">Formatted argument list, not including the instance.</param>
+        protected virtual void WriteTargetCall(CodeWriter writer, Codespace space, string arguments)
+        {
+            if (IsStatic)
+            {
+                writer.Write(Member.EnclosingType.Name);
+                writer.Write(space.IsManaged() ? "." : "::");
+            }
+            else
+            {
+                writer.Write(Marshalling.Parameters[0].Name);
+                writer.Write(space.IsManaged() ? "." : "->");
+            }
+
+            writer.Write(Member.Name);
+
+            using (writer.OpenParenthesis(";\n"))
+                writer.Write(arguments);
+        }
+
         protected void WriteName(CodeWriter writer)
         {
             switch (Member.SpecialMethod)
@@ -0,0 +1,186 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Security.Cryptography;
+using System.Text;
+using System.Threading;
+
+namespace Unreal.Generation
+{
+    /// <summary>
+    /// Record of the native files written by the previous generation.
+    /// </summary>
+    /// <remarks>
+    /// Files are only written when their contents change, so the timestamps of untouched files are preserved and
+    /// Unreal's build does not recompile them. Files generated previously but not in the current generation are deleted
+    /// once generation finishes.
+    ///
+    /// Files may be written from multiple threads, <see cref="Finish"/> must only be called once all writes completed.
+    /// </remarks>
+    public class GeneratedFileManifest
+    {
+        public const string FileName = "DotNetGenerated.manifest";
+
+        private const string Header = "DotNetGenerated 1";
+
+        private static readonly Encoding FileEncoding = new UTF8Encoding(false);
+
+        /// <summary>
+        /// Directories owned by the generator, files there that were not generated are removed.
+        /// </summary>
+        private static readonly string[] OwnedDirectories = {"Public", "Private"};
+
+        private readonly string m_root;
+
+        // Relative path -> hash.
+        private readonly Dictionary<string, string> m_previous = new(StringComparer.OrdinalIgnoreCase);
+        private readonly Dictionary<string, string> m_current = new(StringComparer.OrdinalIgnoreCase);
+
+        private int m_written;
+        private int m_unchanged;
+
+        public int Written => m_written;
+
+        public int Unchanged => m_unchanged;
+
+        public int Removed { get; private set; }
+
+        private GeneratedFileManifest(string root)
+        {
+            m_root = root;
+        }
+
+        /// <summary>
+        /// Whether a manifest was written to the output directory.
+        /// </summary>
+        public static bool Exists(string root) => File.Exists(Path.Combine(root, FileName));
+
+        /// <summary>
+        /// Load the manifest of an output directory, a missing or outdated manifest is treated as empty.
+        /// </summary>
+        /// <param name="root">Native output directory.</param>
+        /// <returns></returns>
+        public static GeneratedFileManifest Load(string root)
+        {
+            var manifest = new GeneratedFileManifest(root);
+
+            var path = Path.Combine(root, FileName);
+            if (!File.Exists(path))
+                return manifest;
+
+            using var reader = new StreamReader(path);
+            if (reader.ReadLine() != Header)
+                return manifest;
+
+            while (reader.ReadLine() is { } line)
+            {
+                var separator = line.IndexOf('\t');
+                if (separator > 0)
+                    manifest.m_previous[line.Substring(separator + 1)] = line.Substring(0, separator);
+            }
+
+            return manifest;
+        }
+
+        /// <summary>
+        /// Write a file unless it already has the same contents.
+        /// </summary>
+        /// <param name="relativePath">Path relative to the output directory.</param>
+        /// <param name="contents"></param>
+        /// <returns>Whether the file was written.</returns>
+        public bool WriteIfChanged(string relativePath, string contents)
+        {
+            var bytes = FileEncoding.GetBytes(contents);
+            var hash = HashContents(bytes);
+
+            lock (m_current)
+                m_current[relativePath] = hash;
+
+            var fullPath = Path.Combine(m_root, relativePath);
+            if (m_previous.TryGetValue(relativePath, out var previous) && previous == hash)
+            {
+                var info = new FileInfo(fullPath);
+                if (info.Exists && info.Length == bytes.Length)
+                {
+                    Interlocked.Increment(ref m_unchanged);
+                    return false;
+                }
+            }
+
+            Directory.CreateDirectory(Path.GetDirectoryName(fullPath)!);
+            File.WriteAllBytes(fullPath, bytes);
+
+            Interlocked.Increment(ref m_written);
+            return true;
+        }
+
+        /// <summary>
+        /// Delete files that were not generated this time and save the manifest.
+        /// </summary>
+        public void Finish()
+        {
+            bool changed = Written > 0;
+
+            foreach (var relativePath in m_previous.Keys)
+            {
+                if (m_current.ContainsKey(relativePath))
+                    continue;
+
+                changed = true;
+
+                var fullPath = Path.Combine(m_root, relativePath);
+                if (File.Exists(fullPath))
+                {
+                    File.Delete(fullPath);
+                    Removed++;
+                }
+            }
+
+            // Also clean files we have no record of, e.g. from generations before the manifest existed.
+            foreach (var directory in OwnedDirectories)
+            {
+                var fullDirectory = Path.Combine(m_root, directory);
+                if (!Directory.Exists(fullDirectory))
+                    continue;
+
+                foreach (var file in Directory.EnumerateFiles(fullDirectory, "*", SearchOption.AllDirectories))
+                {
+                    var relativePath = file.Substring(m_root.Length).TrimStart(Path.DirectorySeparatorChar,
+                        Path.AltDirectorySeparatorChar);
+
+                    if (m_current.ContainsKey(relativePath))
+                        continue;
+
+                    File.Delete(file);
+                    Removed++;
+                }
+            }
+
+            if (!changed && Exists(m_root))
+                return;
+
+            // Sorted so the manifest does not depend on the order files were written in.
+            var builder = new StringBuilder(Header).Append('\n');
+            foreach (var pair in m_current.OrderBy(x => x.Key, StringComparer.OrdinalIgnoreCase))
+                builder.Append(pair.Value).Append('\t').Append(pair.Key).Append('\n');
+
+            File.WriteAllText(Path.Combine(m_root, FileName), builder.ToString(), FileEncoding);
+        }
+
+        private static string HashContents(byte[] contents)
+        {
+            using var sha = SHA1.Create();
+            var hash = sha.ComputeHash(contents);
+
+            var builder = new StringBuilder(hash.Length * 2);
+            foreach (var b in hash)
+                builder.Append(b.ToString("x2"));
+
+            return builder.ToString();
+        }
+    }
+}
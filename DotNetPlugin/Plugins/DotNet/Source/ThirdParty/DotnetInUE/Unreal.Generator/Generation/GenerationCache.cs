@@ -0,0 +1,160 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Security.Cryptography;
+using System.Text;
+using Microsoft.CodeAnalysis;
+using Unreal.Util;
+
+namespace Unreal.Generation
+{
+    /// <summary>
+    /// Reuses the output of the last generation when its inputs did not change.
+    /// </summary>
+    /// <remarks>
+    /// The IDE and the compiler server keep the generator alive and run it again for every compilation, even when
+    /// nothing it depends on was modified. The inputs are the syntax trees, the additional files (metadata and
+    /// generation settings), the referenced assemblies and the msbuild properties the generator reads.
+    /// </remarks>
+    public class GenerationCache
+    {
+        // Msbuild properties read during generation.
+        private static readonly string[] Properties =
+        {
+            "UnrealProjectPath",
+            "UnrealNativeOutputPath",
+            "UnrealForceNativeOutput",
+            "UnrealNativeBindingsMissingSymbolHandling",
+            "UnrealNativeUnityFiles",
+            "UnrealManagedExecThunks",
+            "UnrealBindingInstrumentation"
+        };
+
+        private readonly object m_lock = new();
+
+        private string? m_fingerprint;
+
+        private string m_nativeOutputPath = "";
+
+        private List<(string HintName, string Source)>? m_sources;
+
+        public int Hits { get; private set; }
+
+        /// <summary>
+        /// Add the sources of the previous generation to the compilation if the inputs are the same.
+        /// </summary>
+        /// <param name="context"></param>
+        /// <param name="fingerprint">Fingerprint of the current inputs.</param>
+        /// <returns>Whether the previous output was reused.</returns>
+        public bool TryReplay(GeneratorExecutionContext context, string fingerprint)
+        {
+            lock (m_lock)
+            {
+                if (m_sources == null || m_fingerprint != fingerprint)
+                    return false;
+
+                // The native output could have been cleaned in the meantime.
+                if (m_nativeOutputPath != "" && !GeneratedFileManifest.Exists(m_nativeOutputPath))
+                    return false;
+
+                foreach (var (hintName, source) in m_sources)
+                    context.AddSource(hintName, source);
+
+                Hits++;
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Record the output of a generation.
+        /// </summary>
+        /// <remarks>Generations that reported diagnostics are not cached so the diagnostics are reported again.</remarks>
+        /// <param name="fingerprint">Fingerprint of the inputs.</param>
+        /// <param name="coordinator">Coordinator that ran the generation.</param>
+        public void Store(string fingerprint, GenerationCoordinator coordinator)
+        {
+            lock (m_lock)
+            {
+                if (coordinator.ReportedDiagnostics > 0)
+                {
+                    m_fingerprint = null;
+                    m_sources = null;
+                    return;
+                }
+
+                m_fingerprint = fingerprint;
+                m_nativeOutputPath = coordinator.NativeOutputPath;
+                m_sources = coordinator.ManagedSources;
+            }
+        }
+
+        /// <summary>
+        /// Compute a fingerprint of all inputs of the generator.
+        /// </summary>
+        /// <param name="context"></param>
+        /// <returns></returns>
+        public static string ComputeFingerprint(GeneratorExecutionContext context)
+        {
+            using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+
+            void Append(string? value)
+            {
+                hash.AppendData(Encoding.UTF8.GetBytes(value ?? ""));
+                hash.AppendData(new byte[] {0});
+            }
+
+            void AppendFileStamp(string path)
+            {
+                var info = new FileInfo(path);
+                Append(info.Exists ? $"{info.Length}:{info.LastWriteTimeUtc.Ticks}" : "missing");
+            }
+
+            var compilation = context.Compilation;
+            Append(compilation.AssemblyName);
+
+            foreach (var property in Properties)
+                Append(context.GetMsBuildProperty(property));
+
+            foreach (var tree in compilation.SyntaxTrees)
+            {
+                Append(tree.FilePath);
+                hash.AppendData(tree.GetText().GetChecksum().ToArray());
+            }
+
+            foreach (var file in context.AdditionalFiles)
+            {
+                Append(file.Path);
+
+                // Binary databases are read straight from disk.
+                if (file.Path.EndsWith(MetadataDatabase.Extension, StringComparison.OrdinalIgnoreCase))
+                {
+                    AppendFileStamp(file.Path);
+                    continue;
+                }
+
+                var text = file.GetText();
+                if (text != null)
+                    hash.AppendData(text.GetChecksum().ToArray());
+            }
+
+            foreach (var reference in compilation.References)
+            {
+                if (reference is PortableExecutableReference {FilePath: { } path})
+                {
+                    Append(path);
+                    AppendFileStamp(path);
+                }
+                else
+                {
+                    Append(reference.Display);
+                }
+            }
+
+            return Convert.ToBase64String(hash.GetHashAndReset());
+        }
+    }
+}
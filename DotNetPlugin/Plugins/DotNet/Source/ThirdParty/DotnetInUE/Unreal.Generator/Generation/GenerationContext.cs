@@ -25,6 +25,9 @@ namespace Unreal.Generation
 
         private readonly Dictionary<ITypeSymbol, ITypeInfo> m_infoPerSymbol = new(SymbolEqualityComparer.Default);
 
+        // Members are built in parallel, this guards the type tables above.
+        private readonly object m_typeLock = new();
+
         public readonly AttributeIndex MetaAttributes;
 
         public readonly Compilation Compilation;
@@ -143,10 +146,13 @@ namespace Unreal.Generation
 
         public INamedTypeSymbol GetSymbol(Type type)
         {
-            if (!m_symbolPerManagedType.TryGetValue(type, out var symbol))
-                m_symbolPerManagedType[type] = symbol = LoadSymbol(type);
+            lock (m_typeLock)
+            {
+                if (!m_symbolPerManagedType.TryGetValue(type, out var symbol))
+                    m_symbolPerManagedType[type] = symbol = LoadSymbol(type);
 
-            return symbol;
+                return symbol;
+            }
         }
 
         public INamedTypeSymbol GetSymbol<T>()
@@ -156,17 +162,20 @@ namespace Unreal.Generation
 
         public bool TryGetSymbolTypeInfo(ITypeSymbol type, out ITypeInfo? info)
         {
-            return m_infoPerSymbol.TryGetValue(type, out info);
+            lock (m_typeLock)
+                return m_infoPerSymbol.TryGetValue(type, out info);
         }
         
         public bool TryGetNativeTypeInfo(QualifiedNativeTypeName name, out ITypeInfo? info)
         {
-            return m_infoByNativeName.TryGetValue(name, out info);
+            lock (m_typeLock)
+                return m_infoByNativeName.TryGetValue(name, out info);
         }
 
         public bool TryGetManagedTypeInfo(Type type, out ITypeInfo? info)
         {
-            return m_infoPerManagedType.TryGetValue(type, out info);
+            lock (m_typeLock)
+                return m_infoPerManagedType.TryGetValue(type, out info);
         }
 
         /// <summary>
@@ -231,13 +240,16 @@ namespace Unreal.Generation
 
         public void RegisterType(ITypeInfo type)
         {
-            m_infoByNativeName.Add(type.GetNativeFullName(), type);
+            lock (m_typeLock)
+            {
+                m_infoByNativeName.Add(type.GetNativeFullName(), type);
 
-            if (type.ManagedType != null)
-                m_infoPerManagedType.Add(type.ManagedType, type);
+                if (type.ManagedType != null)
+                    m_infoPerManagedType.Add(type.ManagedType, type);
 
-            if (type.TypeSymbol != null)
-                m_infoPerSymbol.Add(type.TypeSymbol, type);
+                if (type.TypeSymbol != null)
+                    m_infoPerSymbol.Add(type.TypeSymbol, type);
+            }
         }
 
         /// <summary>
@@ -289,13 +301,22 @@ namespace Unreal.Generation
 
             public static TValue GetOrAdd(TKey key, Func<TKey, TValue> creator)
             {
-                if (!m_index.TryGetValue(key, out var value))
-                    m_index[key] = value = creator(key);
+                lock (m_index)
+                {
+                    if (!m_index.TryGetValue(key, out var value))
+                        m_index[key] = value = creator(key);
 
-                return value;
+                    return value;
+                }
             }
 
             public static void EnsureCached(TKey key, TValue value)
+            {
+                lock (m_index)
+                    EnsureCachedLocked(key, value);
+            }
+
+            private static void EnsureCachedLocked(TKey key, TValue value)
             {
                 if (!m_index.TryGetValue(key, out var existing))
                 {
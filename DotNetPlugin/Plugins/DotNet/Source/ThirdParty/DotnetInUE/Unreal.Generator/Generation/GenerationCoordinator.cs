@@ -8,7 +8,10 @@ using System.IO;
 using System.Linq;
 using System.Reflection;
 using System.Security;
+using System.Text;
 using System.Text.RegularExpressions;
+using System.Threading;
+using System.Threading.Tasks;
 using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp.Syntax;
 using Microsoft.CodeAnalysis.Text;
@@ -35,12 +38,53 @@ namespace Unreal.Generation
 
         internal readonly GeneratorExecutionContext ExecutionContext;
 
+        /// <summary>
+        /// Managed sources added to the compilation, by hint name.
+        /// </summary>
+        public readonly List<(string HintName, string Source)> ManagedSources = new();
+
+        /// <summary>
+        /// Number of diagnostics reported during generation.
+        /// </summary>
+        public int ReportedDiagnostics => m_reportedDiagnostics;
+
+        /// <summary>
+        /// Options for the parallel phases of generation, the degree of parallelism can be limited with the
+        /// UnrealGeneratorMaxParallelism msbuild property.
+        /// </summary>
+        public readonly ParallelOptions ParallelOptions;
+
+        /// <summary>
+        /// Timings and output sizes of this generation.
+        /// </summary>
+        public readonly GenerationReport Report;
+
+        private int m_reportedDiagnostics;
+
+        private GeneratedFileManifest? m_manifest;
+
+        /// <summary>
+        /// Number of unity files the native implementation of types is grouped into, 0 to write a file per type.
+        /// </summary>
+        private readonly int m_unityFileCount;
+
+        /// <summary>
+        /// Types whose native implementation goes into the unity files.
+        /// </summary>
+        private readonly List<TypeWriter> m_unityTypes = new();
+
         public GenerationCoordinator(GeneratorExecutionContext executionContext)
         {
             ExecutionContext = executionContext;
 
-            m_writerBacking = new StringWriter();
-            m_managedWriter = new CodeWriter(m_writerBacking, CodeWriter.ManagedIndent);
+            var maxParallelism = executionContext.GetMsBuildProperty("UnrealGeneratorMaxParallelism", -1);
+            ParallelOptions = new ParallelOptions
+            {
+                MaxDegreeOfParallelism = maxParallelism > 0 ? maxParallelism : -1,
+                CancellationToken = executionContext.CancellationToken
+            };
+
+            m_unityFileCount = Math.Max(0, executionContext.GetMsBuildProperty("UnrealNativeUnityFiles", 0));
 
             m_generators = new GeneratorBase[]
             {
@@ -54,6 +98,8 @@ namespace Unreal.Generation
 
             Module = new Module(executionContext);
             ModuleWriter = new ModuleWriter(Module);
+            Report = new GenerationReport(Module,
+                executionContext.GetMsBuildProperty("UnrealGeneratorReportLargestTypes", 20));
             try
             {
                 GenerationContext = new GenerationContext(executionContext);
@@ -64,8 +110,9 @@ namespace Unreal.Generation
                 throw;
             }
 
-            // Determine if the current process is an IDE or csc process.
-            if (Assembly.GetEntryAssembly()?.GetName().Name == "csc")
+            // Determine if the current process is an IDE or csc process. Hosts other than the compiler can opt in.
+            if (Assembly.GetEntryAssembly()?.GetName().Name == "csc"
+                || executionContext.GetMsBuildProperty("UnrealForceNativeOutput", false))
             {
                 ProjectBasePath = executionContext.GetMsBuildProperty("UnrealProjectPath", "")!;
                 NativeOutputPath = NormalizePath(executionContext.GetMsBuildProperty("UnrealNativeOutputPath", ""))!;
@@ -81,28 +128,80 @@ namespace Unreal.Generation
 
         public void Execute()
         {
-            // TODO: Make this work together with caching. Ideally record a manifest and delete only files that are not generated.
+            // Native files are only rewritten when they change, stale ones are removed once generation finishes.
             if (!string.IsNullOrEmpty(NativeOutputPath))
+                m_manifest = GeneratedFileManifest.Load(NativeOutputPath);
+
+            using (Report.Measure(GenerationPhase.TypeResolution))
             {
-                EmptyDirectory(Path.Combine(NativeOutputPath, "Public"));
-                EmptyDirectory(Path.Combine(NativeOutputPath, "Private"));
-            }
+                // Collect declared types.
+                var types = ExecutionContext.Compilation.SyntaxTrees.SelectMany(GetDeclarations).ToArray();
 
-            // Collect declared types.
-            var types = ExecutionContext.Compilation.SyntaxTrees.SelectMany(GetDeclarations).ToArray();
+                DoWithGenerators(x => x.CollectTypes(types));
 
-            DoWithGenerators(x => x.CollectTypes(types));
+                // Collect custom native type mappings
+                CollectTypeMappings(types);
+            }
 
-            // Collect custom native type mappings
-            CollectTypeMappings(types);
+            using (Report.Measure(GenerationPhase.MemberBuilding))
+            {
+                DoWithGenerators(x => x.ProcessAndExportTypes());
 
-            DoWithGenerators(x => x.ProcessAndExportTypes());
+                ModuleWriter.PostProcess();
+            }
 
-            ModuleWriter.PostProcess();
             WriteComponents(ModuleWriter);
 
             var build = new ModuleBuildWriter(ModuleWriter);
             WriteComponents(build);
+
+            WriteUnityFiles();
+
+            using (Report.Measure(GenerationPhase.Writing))
+                FinishNativeOutput();
+
+            WriteReport();
+        }
+
+        private void WriteReport()
+        {
+            if (m_manifest == null)
+                return;
+
+            var path = Path.Combine(NativeOutputPath, GenerationReport.FileName);
+            try
+            {
+                Report.Write(path);
+            }
+            catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+            {
+                Error(new IOGenerationException(ex, path, true));
+            }
+        }
+
+        private void FinishNativeOutput()
+        {
+            if (m_manifest == null)
+                return;
+
+            try
+            {
+                m_manifest.Finish();
+            }
+            catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+            {
+                Error(new IOGenerationException(ex, Path.Combine(NativeOutputPath, GeneratedFileManifest.FileName), true));
+            }
+        }
+
+        /// <summary>
+        /// Report a diagnostic to the compilation.
+        /// </summary>
+        /// <param name="diagnostic"></param>
+        public void ReportDiagnostic(Diagnostic diagnostic)
+        {
+            Interlocked.Increment(ref m_reportedDiagnostics);
+            ExecutionContext.ReportDiagnostic(diagnostic);
         }
 
         private void DoWithGenerators(Action<GeneratorBase> action)
@@ -119,7 +218,7 @@ namespace Unreal.Generation
                 }
                 catch (Exception ex)
                 {
-                    ExecutionContext.ReportDiagnostic(new UnknownErrorException(ex).CreateDiagnostic());
+                    ReportDiagnostic(new UnknownErrorException(ex).CreateDiagnostic());
                 }
             }
         }
@@ -197,27 +296,6 @@ namespace Unreal.Generation
                 .OfType<TypeDeclarationSyntax>();
         }
 
-        private static void EmptyDirectory(string dir) => EmptyDirectory(new DirectoryInfo(dir));
-
-        private static void EmptyDirectory(DirectoryInfo dir)
-        {
-            if (!dir.Exists)
-                return;
-
-            foreach (var info in dir.EnumerateFileSystemInfos())
-            {
-                switch (info)
-                {
-                    case DirectoryInfo dirInfo:
-                        EmptyDirectory(dirInfo);
-                        break;
-                    case FileInfo file:
-                        file.Delete();
-                        break;
-                }
-            }
-        }
-
         /// <summary>
         /// Notify of an error in the generation process.
         /// </summary>
@@ -232,7 +310,7 @@ namespace Unreal.Generation
             }
             else
             {
-                ExecutionContext.ReportDiagnostic(exception.CreateDiagnostic());
+                ReportDiagnostic(exception.CreateDiagnostic());
             }
 
             // Rethrow fatal exception and stop generation.
@@ -258,12 +336,10 @@ namespace Unreal.Generation
 
         private void WriteManaged(string source, string name)
         {
-            ExecutionContext.AddSource(CleanHintName(name), source);
-        }
+            var hintName = CleanHintName(name);
 
-        private void WriteManaged(SourceText source, string name)
-        {
-            ExecutionContext.AddSource(CleanHintName(name), source);
+            ExecutionContext.AddSource(hintName, source);
+            ManagedSources.Add((hintName, source));
         }
 
         private string CleanHintName(string name)
@@ -278,35 +354,171 @@ namespace Unreal.Generation
         /// <param name="directory">Subdirectory to place the generated files.</param>
         public void WriteComponents(AbstractWriter writer, string directory = "")
         {
+            WriteComponents(new[] {(writer, directory)});
+        }
+
+        /// <summary>
+        /// Write the components of multiple type writers.
+        /// </summary>
+        /// <remarks>
+        /// Files are rendered and written in parallel. Managed sources are added and errors reported in the order of
+        /// the writers afterwards, so the result does not depend on scheduling.
+        /// </remarks>
+        /// <param name="writers">Writers and the subdirectory to place their generated files.</param>
+        public void WriteComponents(IReadOnlyList<(AbstractWriter Writer, string Directory)> writers)
+        {
+            using var phase = Report.Measure(GenerationPhase.Writing);
+
+            var outputs = new WriterOutput[writers.Count];
+
+            Parallel.For(0, writers.Count, ParallelOptions, i =>
+            {
+                var (writer, directory) = writers[i];
+                outputs[i] = WriteFiles(writer, directory);
+            });
+
+            for (int i = 0; i < writers.Count; ++i)
+            {
+                var output = outputs[i];
+
+                if (output.Managed is var (path, source))
+                    WriteManaged(source, path);
+
+                if (output.UnityType != null)
+                    m_unityTypes.Add(output.UnityType);
+
+                Report.AddOutput(writers[i].Writer, output.Files, output.Bytes);
+
+                if (output.Errors != null)
+                {
+                    foreach (var error in output.Errors)
+                        Error(error);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Files produced by a writer.
+        /// </summary>
+        private class WriterOutput
+        {
+            public (string Path, string Source)? Managed;
+
+            public int Files;
+
+            public long Bytes;
+
+            public List<GenerationException>? Errors;
+
+            /// <summary>
+            /// Set when the native implementation is deferred to the unity files.
+            /// </summary>
+            public TypeWriter? UnityType;
+
+            public void Add(string contents)
+            {
+                Files++;
+                Bytes += Encoding.UTF8.GetByteCount(contents);
+            }
+
+            public void Error(GenerationException exception)
+            {
+                (Errors ??= new()).Add(exception);
+            }
+        }
+
+        /// <summary>
+        /// Write the native components of a type writer and render its managed part.
+        /// </summary>
+        private WriterOutput WriteFiles(AbstractWriter writer, string directory)
+        {
+            var output = new WriterOutput();
+
             if (writer.Components.HasComponent(MemberCodeComponent.ManagedPart))
-                WriteManaged(writer, directory);
+            {
+                try
+                {
+                    var path = Path.Combine(directory, writer.GetFilename(MemberCodeComponent.ManagedPart));
+                    var source = Render(writer, MemberCodeComponent.ManagedPart, CodeWriter.ManagedIndent);
+
+                    output.Managed = (path, source);
+                    output.Add(source);
+                }
+                catch (GenerationException ex)
+                {
+                    output.Error(ex);
+                }
+            }
 
             if (writer.Components.HasComponent(MemberCodeComponent.NativeFunctionDeclaration))
-                WriteNative(writer, MemberCodeComponent.NativeFunctionDeclaration, directory);
+                WriteNative(writer, MemberCodeComponent.NativeFunctionDeclaration, directory, output);
 
             if (writer.Components.HasComponent(MemberCodeComponent.NativeClassDeclaration))
-                WriteNative(writer, MemberCodeComponent.NativeClassDeclaration, directory);
+                WriteNative(writer, MemberCodeComponent.NativeClassDeclaration, directory, output);
 
             if (writer.Components.HasComponent(MemberCodeComponent.NativeImplementation))
-                WriteNative(writer, MemberCodeComponent.NativeImplementation, directory, false);
+            {
+                if (m_unityFileCount > 0 && writer is TypeWriter typeWriter)
+                    output.UnityType = typeWriter;
+                else
+                    WriteNative(writer, MemberCodeComponent.NativeImplementation, directory, output, false);
+            }
 
             if (writer.Components.HasComponent(MemberCodeComponent.Custom))
-                WritePhysical(writer, MemberCodeComponent.Custom, directory);
-        }
+                WritePhysical(writer, MemberCodeComponent.Custom, directory, output);
 
-        private readonly StringWriter m_writerBacking;
-        private readonly CodeWriter m_managedWriter;
+            return output;
+        }
 
-        private void WriteManaged(AbstractWriter typeWriter, string directory)
+        /// <summary>
+        /// Group the native implementation of the deferred types into unity files and write them.
+        /// </summary>
+        /// <remarks>
+        /// Types are assigned largest first to the file with the fewest native members so far, then sorted by name
+        /// within each file so the contents do not depend on the order the types were written in.
+        /// </remarks>
+        private void WriteUnityFiles()
         {
-            typeWriter.Write(m_managedWriter, MemberCodeComponent.ManagedPart);
-            var result = m_writerBacking.ToString();
-            m_managedWriter.Clear();
-            m_writerBacking.GetStringBuilder().Clear();
+            if (m_manifest == null || m_unityTypes.Count == 0)
+                return;
+
+            var files = Enumerable.Range(0, Math.Min(m_unityFileCount, m_unityTypes.Count))
+                .Select(i => new UnityFileWriter(Module, i))
+                .ToArray();
+
+            var types = m_unityTypes
+                .OrderByDescending(x => x.NativeImplementationCount)
+                .ThenBy(x => x.Member.GetManagedFullName(), StringComparer.Ordinal);
+
+            foreach (var type in types)
+            {
+                var file = files[0];
+                foreach (var candidate in files)
+                {
+                    if (candidate.Weight < file.Weight)
+                        file = candidate;
+                }
 
-            var path = Path.Combine(directory, typeWriter.GetFilename(MemberCodeComponent.ManagedPart));
+                file.Types.Add(type);
+                file.Weight += Math.Max(1, type.NativeImplementationCount);
+            }
+
+            foreach (var file in files)
+            {
+                file.Types.Sort((x, y) =>
+                    StringComparer.Ordinal.Compare(x.Member.GetManagedFullName(), y.Member.GetManagedFullName()));
+            }
+
+            WriteComponents(files.Select(x => ((AbstractWriter) x, "Private")).ToList());
+        }
+
+        private static string Render(AbstractWriter typeWriter, MemberCodeComponent component, string indent)
+        {
+            var contents = new StringWriter();
+            using (var writer = new CodeWriter(contents, indent))
+                typeWriter.Write(writer, component);
 
-            WriteManaged(result, path);
+            return contents.ToString();
         }
 
         /// <summary>
@@ -315,12 +527,13 @@ namespace Unreal.Generation
         /// <param name="typeWriter"></param>
         /// <param name="directory">The directory to write to.</param>
         /// <param name="component">The component to write.</param>
+        /// <param name="output">Output of the writer.</param>
         /// <param name="public">Whether the file should be included into the 'Public' or 'Private' source directories. </param>
         private void WriteNative(AbstractWriter typeWriter, MemberCodeComponent component, string directory,
-            bool @public = true)
+            WriterOutput output, bool @public = true)
         {
             directory = Path.Combine(@public ? "Public" : "Private", directory);
-            WritePhysical(typeWriter, component, directory);
+            WritePhysical(typeWriter, component, directory, output);
         }
 
         /// <summary>
@@ -329,23 +542,26 @@ namespace Unreal.Generation
         /// <param name="typeWriter"></param>
         /// <param name="directory">The directory to write to.</param>
         /// <param name="component">The component to write.</param>
-        private void WritePhysical(AbstractWriter typeWriter, MemberCodeComponent component, string directory)
+        /// <param name="output">Output of the writer.</param>
+        private void WritePhysical(AbstractWriter typeWriter, MemberCodeComponent component, string directory,
+            WriterOutput output)
         {
-            if (NativeOutputPath == "")
+            if (m_manifest == null)
                 return;
 
-            var fullPath = Path.Combine(NativeOutputPath, directory, typeWriter.GetFilename(component));
+            var relativePath = Path.Combine(directory, typeWriter.GetFilename(component));
+            var fullPath = Path.Combine(NativeOutputPath, relativePath);
 
             try
             {
-                Directory.CreateDirectory(Path.GetDirectoryName(fullPath)!);
+                var contents = Render(typeWriter, component, CodeWriter.NativeIndent);
+                m_manifest.WriteIfChanged(relativePath, contents);
 
-                using (var writer = new CodeWriter(new StreamWriter(fullPath), CodeWriter.NativeIndent))
-                    typeWriter.Write(writer, component);
+                output.Add(contents);
             }
             catch (GenerationException gen)
             {
-                Error(gen);
+                output.Error(gen);
             }
             catch (Exception ex) when (ex is IOException
                                        || ex is UnauthorizedAccessException
@@ -354,11 +570,11 @@ namespace Unreal.Generation
                                        || ex is NotSupportedException
                                        || ex is SecurityException)
             {
-                Error(new IOGenerationException(ex, fullPath, true));
+                output.Error(new IOGenerationException(ex, fullPath, true));
             }
             catch (Exception ex)
             {
-                Error(new UnknownErrorException(ex));
+                output.Error(new UnknownErrorException(ex));
             }
         }
 
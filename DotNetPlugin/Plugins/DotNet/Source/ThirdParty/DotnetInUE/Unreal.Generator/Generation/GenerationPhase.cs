@@ -0,0 +1,36 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+namespace Unreal.Generation
+{
+    /// <summary>
+    /// Phases of generation timed by the <see cref="GenerationReport"/>.
+    /// </summary>
+    public enum GenerationPhase
+    {
+        /// <summary>
+        /// Setup and anything not covered by the other phases.
+        /// </summary>
+        Other,
+
+        /// <summary>
+        /// Reading native metadata and generation settings.
+        /// </summary>
+        MetadataLoad,
+
+        /// <summary>
+        /// Collecting types and resolving type mappings.
+        /// </summary>
+        TypeResolution,
+
+        /// <summary>
+        /// Building the members of generated types.
+        /// </summary>
+        MemberBuilding,
+
+        /// <summary>
+        /// Rendering and writing generated files.
+        /// </summary>
+        Writing
+    }
+}
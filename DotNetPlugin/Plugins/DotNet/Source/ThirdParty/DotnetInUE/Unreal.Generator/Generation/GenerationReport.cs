@@ -0,0 +1,234 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text.Json;
+using Unreal.Metadata;
+
+namespace Unreal.Generation
+{
+    /// <summary>
+    /// Timings and output sizes of a generation, written as json next to the generated native sources.
+    /// </summary>
+    /// <remarks>
+    /// Phases are timed exclusively: while a nested phase is measured its time is not counted for the outer phase.
+    /// Measuring is not thread-safe and should only be done from the thread running the generation.
+    /// </remarks>
+    public class GenerationReport
+    {
+        public const string FileName = "DotNetGenerationReport.json";
+
+        private readonly Module m_module;
+
+        private readonly int m_largestTypeCount;
+
+        private readonly Stopwatch m_watch = Stopwatch.StartNew();
+
+        private readonly TimeSpan[] m_phases = new TimeSpan[Enum.GetValues(typeof(GenerationPhase)).Length];
+
+        private GenerationPhase m_currentPhase = GenerationPhase.Other;
+
+        private TimeSpan m_phaseStart;
+
+        private readonly Dictionary<string, ModuleOutput> m_modules = new();
+
+        private readonly List<TypeOutput> m_types = new();
+
+        /// <summary>
+        /// Stats of the native binding generator, if it generated anything.
+        /// </summary>
+        public NativeGenerationStats? NativeStats;
+
+        public GenerationReport(Module module, int largestTypeCount)
+        {
+            m_module = module;
+            m_largestTypeCount = largestTypeCount;
+        }
+
+        /// <summary>
+        /// Total time spent in a phase so far.
+        /// </summary>
+        public TimeSpan GetPhaseTime(GenerationPhase phase)
+        {
+            return m_phases[(int) phase] + (phase == m_currentPhase ? m_watch.Elapsed - m_phaseStart : TimeSpan.Zero);
+        }
+
+        /// <summary>
+        /// Measure a phase until the returned scope is disposed.
+        /// </summary>
+        /// <param name="phase"></param>
+        /// <returns></returns>
+        public PhaseScope Measure(GenerationPhase phase)
+        {
+            var previous = m_currentPhase;
+            SwitchPhase(phase);
+
+            return new PhaseScope(this, previous);
+        }
+
+        private void SwitchPhase(GenerationPhase phase)
+        {
+            var now = m_watch.Elapsed;
+            m_phases[(int) m_currentPhase] += now - m_phaseStart;
+
+            m_phaseStart = now;
+            m_currentPhase = phase;
+        }
+
+        public readonly struct PhaseScope : IDisposable
+        {
+            private readonly GenerationReport m_report;
+            private readonly GenerationPhase m_previous;
+
+            public PhaseScope(GenerationReport report, GenerationPhase previous)
+            {
+                m_report = report;
+                m_previous = previous;
+            }
+
+            public void Dispose()
+            {
+                m_report.SwitchPhase(m_previous);
+            }
+        }
+
+        /// <summary>
+        /// Record the files produced by a writer.
+        /// </summary>
+        /// <param name="writer"></param>
+        /// <param name="files">Number of files written.</param>
+        /// <param name="bytes">Total size of the files.</param>
+        public void AddOutput(AbstractWriter writer, int files, long bytes)
+        {
+            var moduleName = m_module.Name;
+            var name = writer.Name;
+            int thunks = 0;
+            int exports = 0;
+
+            if (writer is TypeWriter typeWriter)
+            {
+                if (typeWriter.Member.NativeModule != "")
+                    moduleName = typeWriter.Member.NativeModule;
+
+                name = typeWriter.Member.GetManagedFullName();
+
+                foreach (var member in typeWriter.Members)
+                {
+                    if (member is NativeFunctionBinder)
+                        thunks++;
+                    else if (member is ManagedFunctionBinder)
+                        exports++;
+                }
+            }
+
+            if (!m_modules.TryGetValue(moduleName, out var module))
+                m_modules[moduleName] = module = new ModuleOutput(moduleName);
+
+            module.Files += files;
+            module.Bytes += bytes;
+            module.Thunks += thunks;
+            module.Exports += exports;
+
+            if (writer is TypeWriter)
+            {
+                module.Types++;
+                m_types.Add(new TypeOutput(name, moduleName, files, bytes));
+            }
+        }
+
+        /// <summary>
+        /// Write the report.
+        /// </summary>
+        /// <param name="path"></param>
+        public void Write(string path)
+        {
+            using var stream = File.Create(path);
+            using var writer = new Utf8JsonWriter(stream, new JsonWriterOptions {Indented = true});
+
+            writer.WriteStartObject();
+            writer.WriteString("Module", m_module.Name);
+            writer.WriteString("Timestamp", DateTime.UtcNow.ToString("O"));
+            writer.WriteNumber("TotalMilliseconds", Math.Round(m_watch.Elapsed.TotalMilliseconds, 2));
+
+            writer.WriteStartObject("PhaseMilliseconds");
+            foreach (GenerationPhase phase in Enum.GetValues(typeof(GenerationPhase)))
+                writer.WriteNumber(phase.ToString(), Math.Round(GetPhaseTime(phase).TotalMilliseconds, 2));
+            writer.WriteEndObject();
+
+            writer.WriteStartArray("Modules");
+            foreach (var module in m_modules.Values.OrderBy(x => x.Name, StringComparer.Ordinal))
+            {
+                writer.WriteStartObject();
+                writer.WriteString("Name", module.Name);
+                writer.WriteNumber("Types", module.Types);
+                writer.WriteNumber("Files", module.Files);
+                writer.WriteNumber("Bytes", module.Bytes);
+                writer.WriteNumber("Thunks", module.Thunks);
+                writer.WriteNumber("Exports", module.Exports);
+                writer.WriteEndObject();
+            }
+
+            writer.WriteEndArray();
+
+            writer.WriteStartArray("LargestTypes");
+            foreach (var type in m_types.OrderByDescending(x => x.Bytes).ThenBy(x => x.Name, StringComparer.Ordinal)
+                .Take(m_largestTypeCount))
+            {
+                writer.WriteStartObject();
+                writer.WriteString("Name", type.Name);
+                writer.WriteString("Module", type.Module);
+                writer.WriteNumber("Files", type.Files);
+                writer.WriteNumber("Bytes", type.Bytes);
+                writer.WriteEndObject();
+            }
+
+            writer.WriteEndArray();
+
+            if (NativeStats is { } stats)
+            {
+                writer.WriteStartObject("NativeStats");
+                foreach (var field in typeof(NativeGenerationStats).GetFields())
+                    writer.WriteNumber(field.Name, (int) field.GetValue(stats)!);
+                writer.WriteEndObject();
+            }
+
+            writer.WriteEndObject();
+        }
+
+        private class ModuleOutput
+        {
+            public readonly string Name;
+
+            public int Types;
+            public int Files;
+            public long Bytes;
+            public int Thunks;
+            public int Exports;
+
+            public ModuleOutput(string name)
+            {
+                Name = name;
+            }
+        }
+
+        private readonly struct TypeOutput
+        {
+            public readonly string Name;
+            public readonly string Module;
+            public readonly int Files;
+            public readonly long Bytes;
+
+            public TypeOutput(string name, string module, int files, long bytes)
+            {
+                Name = name;
+                Module = module;
+                Files = files;
+                Bytes = bytes;
+            }
+        }
+    }
+}
@@ -16,17 +16,28 @@ namespace Unreal.Generation
     //
     // At this point it makes more sense to just create another indirection level and instantiate
     // a coordinator for each execute method.
+    //
+    // Since the instance does live between calls it keeps the output of the last generation, which is reused as long as
+    // none of the inputs change.
     [Generator]
     public class Generator : ISourceGenerator
     {
+        private readonly GenerationCache m_cache = new();
+
         public void Initialize(GeneratorInitializationContext context)
         { }
 
         /// <inheritdoc />
         public void Execute(GeneratorExecutionContext context)
         {
+            var fingerprint = GenerationCache.ComputeFingerprint(context);
+            if (m_cache.TryReplay(context, fingerprint))
+                return;
+
             var coordinator = new GenerationCoordinator(context);
             coordinator.Execute();
+
+            m_cache.Store(fingerprint, coordinator);
         }
     }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 // Copyright (c) 2021 Keen Software House
 // Licensed under the MIT license.
 
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
 using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp;
 using Microsoft.CodeAnalysis.CSharp.Syntax;
@@ -24,6 +27,8 @@ namespace Unreal.Generation
 
         protected ref readonly GeneratorExecutionContext ExecutionContext => ref m_coordinator.ExecutionContext; 
 
+        protected GenerationReport Report => m_coordinator.Report;
+
         public GeneratorBase(GenerationCoordinator coordinator)
         {
             m_coordinator = coordinator;
@@ -69,6 +74,15 @@ namespace Unreal.Generation
             m_coordinator.WriteComponents(writer, directory);
         }
 
+        /// <summary>
+        /// Write the components of multiple type writers in parallel.
+        /// </summary>
+        /// <param name="writers">Writers and the subdirectory to place their generated files.</param>
+        protected void WriteComponents(IReadOnlyList<(AbstractWriter Writer, string Directory)> writers)
+        {
+            m_coordinator.WriteComponents(writers);
+        }
+
         #endregion
 
         #region Error Handling
@@ -87,7 +101,7 @@ namespace Unreal.Generation
             }
             else
             {
-                m_coordinator.ExecutionContext.ReportDiagnostic(exception.CreateDiagnostic());
+                m_coordinator.ReportDiagnostic(exception.CreateDiagnostic());
             }
 
             // Rethrow fatal exception and stop generation.
@@ -97,6 +111,37 @@ namespace Unreal.Generation
 
         #endregion
 
+        /// <summary>
+        /// Process a list of items in parallel.
+        /// </summary>
+        /// <remarks>
+        /// Generation errors are reported once all items are processed, in the order of the items.
+        /// </remarks>
+        /// <param name="items"></param>
+        /// <param name="action"></param>
+        protected void ForEachParallel<T>(IReadOnlyList<T> items, Action<T> action)
+        {
+            var errors = new GenerationException?[items.Count];
+
+            Parallel.For(0, items.Count, m_coordinator.ParallelOptions, i =>
+            {
+                try
+                {
+                    action(items[i]);
+                }
+                catch (GenerationException ex)
+                {
+                    errors[i] = ex;
+                }
+            });
+
+            foreach (var error in errors)
+            {
+                if (error != null)
+                    Error(error);
+            }
+        }
+
         /// <summary>
         /// Validate the signature of a special method. Currently that's either a custom constructor or destructor.
         /// </summary>
@@ -27,10 +27,26 @@ namespace Unreal.Generation
         
         private readonly List<(ClassWriter Def, ClassDeclarationSyntax Syntax)> m_classes = new();
 
+        /// <summary>
+        /// Whether UFunctions get generated exec thunks instead of the ones from UHT.
+        /// </summary>
+        private bool m_execThunks;
+
+        /// <summary>
+        /// Whether UFunctions record their calls, see <see cref="FunctionWriterBase.IsInstrumented"/>.
+        /// </summary>
+        private bool m_instrumentBindings;
+
         public ManagedBindingGenerator(GenerationCoordinator coordinator)
             : base(coordinator)
         { }
 
+        public override void Initialize()
+        {
+            m_execThunks = ExecutionContext.GetMsBuildProperty("UnrealManagedExecThunks", true);
+            m_instrumentBindings = ExecutionContext.GetMsBuildProperty("UnrealBindingInstrumentation", false);
+        }
+
         public override void CollectTypes(TypeDeclarationSyntax[] declaredTypes)
         {
             var module = Context.GetModule("DotNet");
@@ -82,6 +98,8 @@ namespace Unreal.Generation
                 return;
             
             // Collect members.
+            // Resolving symbols can register generic types with the context, so this is done sequentially.
+            var writers = new List<(AbstractWriter Writer, string Directory)>();
             foreach (var (writer, @class) in m_classes)
             {
                 try
@@ -95,8 +113,10 @@ namespace Unreal.Generation
                     continue;
                 }
 
-                WriteComponents(writer);
+                writers.Add((writer, ""));
             }
+
+            WriteComponents(writers);
         }
 
         private ClassWriter CreateType(ClassDeclarationSyntax classSyntax)
@@ -140,13 +160,25 @@ namespace Unreal.Generation
                     not { } attributeSyntax)
                     continue;
 
+                var type = ModelExtensions.GetTypeInfo(model, attributeSyntax).Type;
+
                 ManagedFunctionBinder function;
                 try
                 {
-                    var functionDef = FunctionDefinition
-                        .PrepareFromManaged(Context, writer.Member, functionSyntax, model)
-                        .Build();
-                    function = new ManagedFunctionBinder(functionDef);
+                    var builder = FunctionDefinition.PrepareFromManaged(Context, writer.Member, functionSyntax, model);
+
+                    // Blueprint calls go straight to the entry point through our own thunk.
+                    if (m_execThunks && type.IsEqualTo(Context.UFunctionAttribute))
+                        builder.WithMetaAttribute(ManagedFunctionBinder.CustomThunk);
+
+                    function = new ManagedFunctionBinder(builder.Build());
+
+                    if (m_instrumentBindings && type.IsEqualTo(Context.UFunctionAttribute))
+                    {
+                        // The native method is declared inline in the class header.
+                        function.IsInstrumented = true;
+                        writer.AdditionalHeaders.Add(FunctionWriterBase.InstrumentationHeader);
+                    }
                 }
                 catch (GenerationException ex)
                 {
@@ -157,8 +189,6 @@ namespace Unreal.Generation
                     continue;
                 }
 
-                var type = ModelExtensions.GetTypeInfo(model, attributeSyntax).Type;
-
                 if (!type.IsEqualTo(Context.UFunctionAttribute))
                 {
                     // Not a UFunction, so a special method then.
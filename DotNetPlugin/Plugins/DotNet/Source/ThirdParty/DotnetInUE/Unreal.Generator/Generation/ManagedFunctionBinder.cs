@@ -3,6 +3,7 @@
 
 using System;
 using System.Diagnostics;
+using System.Linq;
 using Unreal.Marshalling;
 using Unreal.Metadata;
 using Unreal.Util;
@@ -11,11 +12,32 @@ namespace Unreal.Generation
 {
     public class ManagedFunctionBinder : FunctionWriterBase
     {
+        /// <summary>
+        /// UFunction specifier that tells UHT the exec thunk of the function is provided by us.
+        /// </summary>
+        public static readonly MetaAttribute CustomThunk = new("CustomThunk", null, false);
+
+        /// <summary>
+        /// Whether the function is a CustomThunk UFunction, in which case the exec thunk Blueprint calls is generated
+        /// alongside the entry point.
+        /// </summary>
+        public bool HasExecThunk { get; }
+
+        private string ExecThunkName => "exec" + Member.Name;
+
+        // Prefixes of the exec thunk locals that hold the frame values.
+        private const string ThunkTemporaryPrefix = "ThunkTemp_";
+        private const string ThunkParameterPrefix = "ThunkParam_";
+
         public ManagedFunctionBinder(FunctionDefinition function)
             : base(function, MemberCodeComponentFlags.All)
         {
             AdditionalNamespaces.Add("System.ComponentModel");
             AdditionalNamespaces.Add("System.Runtime.InteropServices");
+
+            HasExecThunk = function.MetaAttributes?.Any(x => x.Name == CustomThunk.Name && !x.IsMeta) == true;
+            if (HasExecThunk)
+                AdditionalHeaders.Add("DotNetExecThunk.h");
         }
 
         public override void Write(CodeWriter writer, MemberCodeComponent component)
@@ -30,6 +52,8 @@ namespace Unreal.Generation
                     break;
                 case MemberCodeComponent.NativeImplementation:
                     WriteEntryPointImplementation(writer);
+                    if (HasExecThunk)
+                        WriteExecThunk(writer);
                     break;
                 case MemberCodeComponent.ManagedPart:
                     WriteManagedMethod(writer);
@@ -66,7 +90,70 @@ namespace Unreal.Generation
             WriteNativeSignature(writer);
 
             using (writer.OpenBlock())
+            {
+                WriteInstrumentationScope(writer);
                 WriteBindingCall(writer, Codespace.Native, Order.Before);
+            }
+
+            if (HasExecThunk)
+                writer.WriteLine($"DECLARE_FUNCTION({ExecThunkName});");
+        }
+
+        /// <summary>
+        /// Exec thunk called by the Blueprint VM, replaces the one UHT would generate.
+        /// </summary>
+        /// <remarks>
+        /// Parameters are referenced in place in the VM frame when possible and marshalled straight from there, and the
+        /// return value is written directly to the result. The thunk calls the managed entry point itself so there is
+        /// a single transition per call and no intermediate copy of the arguments.
+        /// <para>
+        /// The frame is read into prefixed locals and the parameters are only named inside the native scope, where they
+        /// may shadow the thunk's own Context, Stack and result parameters.
+        /// </para>
+        /// </remarks>
+        /// <param name="writer"></param>
+        private void WriteExecThunk(CodeWriter writer)
+        {
+            var enclosingType = Member.EnclosingType.NativeName;
+
+            writer.WriteLine();
+            writer.WriteLine($"DEFINE_FUNCTION({enclosingType}::{ExecThunkName})");
+
+            using (writer.OpenBlock())
+            {
+                foreach (var parameter in Member.Parameters)
+                {
+                    var type = parameter.Type.TypeInfo.FormatName(Codespace.Native);
+                    var step = parameter.Type.TransferType.IsOut() ? "StepOutParameter" : "StepParameter";
+                    writer.WriteLine($"{type} {ThunkTemporaryPrefix}{parameter.Name}{{}};");
+                    writer.WriteLine(
+                        $"{type}& {ThunkParameterPrefix}{parameter.Name} = FDotNetExecThunk::{step}(Stack, {ThunkTemporaryPrefix}{parameter.Name});");
+                }
+
+                writer.WriteLine("P_FINISH;");
+                writer.WriteLine($"{enclosingType}* const ThunkSelf = ({enclosingType}*) Context;");
+
+                string? result = null;
+                if (!Member.Return.Type.IsVoid)
+                {
+                    var returnType = Member.Return.Type.TypeInfo.FormatName(Codespace.Native);
+                    writer.WriteLine($"{returnType}* const ThunkResult = ({returnType}*) RESULT_PARAM;");
+                    result = "*ThunkResult";
+                }
+
+                writer.WriteLine("P_NATIVE_BEGIN;");
+                WriteInstrumentationScope(writer);
+
+                foreach (var parameter in Member.Parameters)
+                {
+                    var type = parameter.Type.TypeInfo.FormatName(Codespace.Native);
+                    writer.WriteLine($"{type}& {parameter.Name} = {ThunkParameterPrefix}{parameter.Name};");
+                }
+
+                WriteBindingCall(writer, Codespace.Native, Order.Before, "ThunkSelf", result);
+
+                writer.WriteLine("P_NATIVE_END;");
+            }
         }
 
         /// <summary>
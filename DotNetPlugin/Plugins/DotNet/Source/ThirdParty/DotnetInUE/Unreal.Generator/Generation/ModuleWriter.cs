@@ -249,17 +249,44 @@ IMPLEMENT_GAME_MODULE(F{ModuleId}Module, {ModuleId})
                 ClassCount = TypesForRegistration.Count,
                 NativeModules = nativeModules,
                 TypeMappings = typeMappings,
-                Registration = string.Join("\n        ", registrations)
+                Registration = string.Join("\n        ", registrations),
+                TrimmingRoots = string.Join("\n    ", GetTrimmingRoots().Select(x => $"[DynamicDependency({x})]"))
             };
 
             writer.WriteLine(
                 TemplateWriter.WriteTemplate(ManagedModuleTemplate, Module, registration));
         }
 
+        /// <summary>
+        /// Arguments of the dynamic dependencies on the members the runtime only reaches through reflection.
+        /// </summary>
+        /// <remarks>
+        /// Wrappers for registered types are created through their native instance constructor with
+        /// <see cref="Activator"/>, and managed entry points are looked up by name in JIT builds.
+        /// </remarks>
+        /// <returns></returns>
+        public IEnumerable<string> GetTrimmingRoots()
+        {
+            foreach (var (type, _) in TypesForRegistration)
+                yield return $"\"#ctor(System.IntPtr)\", typeof({type.GetManagedFullName()})";
+
+            foreach (var type in DefinedTypes)
+            {
+                var entryPoints = type.Members.OfType<ManagedFunctionBinder>()
+                    .Select(x => x.Member.EntryPointName)
+                    .Distinct()
+                    .OrderBy(x => x, StringComparer.Ordinal);
+
+                foreach (var entryPoint in entryPoints)
+                    yield return $"\"{entryPoint}\", typeof({type.Member.GetManagedFullName()})";
+            }
+        }
+
         //language=C#
         public const string ManagedModuleTemplate =
             @"
 using System;
+using System.Diagnostics.CodeAnalysis;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.ComponentModel;
@@ -305,6 +332,13 @@ internal static class ModuleHelper
         }
     }
 
+    // Roots the members only reached through reflection, so trimmed builds keep exactly the bindings.
+    [ModuleInitializer]
+    [DynamicDependency(nameof(Init))]
+    {TrimmingRoots}
+    internal static void KeepBindings()
+    { }
+
     private static void RegisterTypes(Span<IntPtr> handles)
     {
         {Registration}
@@ -6,6 +6,7 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.Linq;
+using System.Threading;
 using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp.Syntax;
 using Unreal.ErrorHandling;
@@ -22,6 +23,11 @@ namespace Unreal.Generation
     {
         private MissingSymbolHandling m_missingSymbolHandling;
 
+        /// <summary>
+        /// Whether native functions record their calls, see <see cref="FunctionWriterBase.IsInstrumented"/>.
+        /// </summary>
+        private bool m_instrumentBindings;
+
         private readonly List<(TypeWriter TypeWriter, UEStruct Data)> m_generatedTypes = new();
 
         private Dictionary<(string Namespace, string Name), TypeDeclarationSyntax> m_syntaxes = null!;
@@ -38,6 +44,11 @@ namespace Unreal.Generation
             : base(coordinator)
         { }
 
+        public override void Initialize()
+        {
+            m_instrumentBindings = ExecutionContext.GetMsBuildProperty("UnrealBindingInstrumentation", false);
+        }
+
         public override void CollectTypes(TypeDeclarationSyntax[] declaredTypes)
         {
             // For new we default to skip, this is because in rider we don't get any msbuild variables,
@@ -51,67 +62,104 @@ namespace Unreal.Generation
 
             // Collect types.
             // ==============
-            foreach (var text in ExecutionContext.AdditionalFiles)
-            {
-                if (!text.Path.EndsWith(".umeta"))
-                    continue;
+            var modules = new List<UEModule>();
+            var fields = new List<UEField>();
+            var settings = new GenerationSettings();
 
-                var sourceText = text.GetText();
-                if (sourceText == null)
-                    continue;
+            void AddMeta(UEMeta meta)
+            {
+                if (meta is UEModule module)
+                    modules.Add(module);
+                else if (meta is UEField field)
+                    fields.Add(field);
+            }
 
-                UEMeta meta;
-                try
-                {
-                    var data = sourceText.ToString();
-                    meta = MetadataCollector.LoadFromString(data);
-                }
-                catch (Exception e)
-                {
-                    throw new NativeMetadataException(Path.GetFileNameWithoutExtension(text.Path), e.Message);
-                }
+            using (Report.Measure(GenerationPhase.MetadataLoad))
+            {
+                // A module exported as a database may still have json files from an earlier export next to it, the
+                // database is authoritative for those modules.
+                var databaseModules =
+                    MetadataDatabase.GetDatabaseModules(ExecutionContext.AdditionalFiles.Select(x => x.Path));
 
-                if (meta is UEField field)
+                foreach (var text in ExecutionContext.AdditionalFiles)
                 {
-                    if (field.Meta.ContainsKey(MetaAttribute.ManagedTypeAttributeName))
-                        continue; // Skip types that were generated by us already
+                    if (Path.GetFileName(text.Path) == GenerationSettings.FileName)
+                    {
+                        var settingsText = text.GetText();
+                        if (settingsText != null)
+                            settings = GenerationSettings.Load(settingsText.ToString());
 
-                    if (field.Meta.TryGetValue("ModuleRelativePath", out var relativePath)
-                        && relativePath.StartsWith("Private"))
                         continue;
+                    }
 
-                    if (field is UEStruct @struct)
+                    if (text.Path.EndsWith(MetadataDatabase.Extension))
                     {
-                        if (field is UEClass @class)
+                        try
                         {
-                            if (TypeBlacklist.Contains(@class.CppName))
-                                continue;
+                            using var database = MetadataDatabase.Open(text.Path);
 
-                            m_classes.Add(@class);
+                            AddMeta(database.Module);
+                            foreach (var type in database.ReadTypes())
+                                AddMeta(type);
                         }
-                        else
+                        catch (Exception e) when (e is IOException or InvalidDataException
+                                                      or UnauthorizedAccessException)
                         {
-                            m_stats.TotalStructs++;
+                            throw new NativeMetadataException(Path.GetFileNameWithoutExtension(text.Path), e.Message);
+                        }
 
-                            // TODO: Support properties with object references.
-                            if (@struct.Properties.Any(x => x.PropertyType == "ObjectProperty"))
-                            {
-                                m_stats.SkippedStructReferenceType++;
-                                continue;
-                            }
+                        continue;
+                    }
 
-                            m_structs.Add(@struct);
-                        }
+                    if (!text.Path.EndsWith(".umeta"))
+                        continue;
+
+                    if (MetadataDatabase.IsSuperseded(text.Path, databaseModules))
+                        continue;
+
+                    var sourceText = text.GetText();
+                    if (sourceText == null)
+                        continue;
+
+                    UEMeta meta;
+                    try
+                    {
+                        var data = sourceText.ToString();
+                        meta = MetadataCollector.LoadFromString(data);
                     }
-                    else if (field is UEEnum @enum)
+                    catch (Exception e)
                     {
-                        CollectEnum(@enum);
+                        throw new NativeMetadataException(Path.GetFileNameWithoutExtension(text.Path), e.Message);
                     }
+
+                    AddMeta(meta);
                 }
-                else if (meta is UEModule module)
+            }
+
+            // Apply the generation rules shared with the binder. Without rules we generate everything that was exported.
+            var excludedModules = new HashSet<string>();
+            foreach (var module in modules)
+            {
+                if (settings.HasRules && !settings.ShouldGenerateModule(module.Name, module.PackageType))
                 {
-                    ModuleWriter.NativeModules.Add(module.Name);
+                    excludedModules.Add(module.Name);
+                    m_stats.PrunedModules++;
+                    continue;
                 }
+
+                ModuleWriter.NativeModules.Add(module.Name);
+            }
+
+            foreach (var field in fields)
+            {
+                if (settings.HasRules && (excludedModules.Contains(field.Module)
+                                          || !settings.ShouldGenerateType(field.Module, field.Name)))
+                {
+                    m_stats.PrunedTypes++;
+                    continue;
+                }
+
+                CollectField(field);
             }
 
             // TODO: Interfaces
@@ -194,6 +242,8 @@ namespace Unreal.Generation
         public override void ProcessAndExportTypes()
         {
             // Second pass to collect members.
+            // Static class members are registered with the module in order, so that stays sequential.
+            var typesWithMembers = new List<(TypeWriter TypeWriter, UEStruct Data, bool HasApi)>();
             foreach (var (typeWriter, typeData) in m_generatedTypes)
             {
                 try
@@ -205,8 +255,7 @@ namespace Unreal.Generation
 
                     FinishBasicType(typeWriter, ModuleWriter, part, hasApi);
 
-                    // Skip generation of methods for NoAPI types.
-                    CollectMembers(typeWriter, typeData, hasApi);
+                    typesWithMembers.Add((typeWriter, typeData, hasApi));
                 }
                 catch (GenerationException ex)
                 {
@@ -214,6 +263,10 @@ namespace Unreal.Generation
                 }
             }
 
+            // Methods of NoAPI types are invoked through reflection.
+            ForEachParallel(typesWithMembers, x => CollectMembers(x.TypeWriter, x.Data, x.HasApi));
+
+            var writers = new List<(AbstractWriter Writer, string Directory)>();
             foreach (var typeWriter in m_generatedTypes.Select(x => x.TypeWriter).Concat(m_enums))
             {
                 // TODO: Check assembly default namespace instead.
@@ -224,8 +277,12 @@ namespace Unreal.Generation
                 var ns = typeWriter.Member.Namespace;
                 ns = ns.StartsWith(unreal) ? ns.Substring(unreal.Length) : ns;
 
-                WriteComponents(typeWriter, ns);
+                writers.Add((typeWriter, ns));
             }
+
+            WriteComponents(writers);
+
+            Report.NativeStats = m_stats;
         }
 
         private void FinishBasicType(TypeWriter typeWriter, ModuleWriter moduleWriter,
@@ -284,55 +341,75 @@ namespace Unreal.Generation
 
             if (typeData is UEClass classData)
             {
-                // Only collect functions of types with API access.
-                // TODO: This might be fixable by calling reflection data directly. 
-                if (hasApi)
+                bool anySkippedFunctions = false;
+                bool anyReflectedFunctions = false;
+
+                foreach (var ueFunction in classData.Functions)
                 {
-                    bool anySkippedFunctions = false;
+                    Interlocked.Increment(ref m_stats.TotalFunctions);
 
-                    foreach (var ueFunction in classData.Functions)
-                    {
-                        m_stats.TotalFunctions++;
+                    // TODO: Events and virtual methods:
+                    // For now let's just skip what's not public
+                    FunctionFlags flagsToIgnore =
+                        FunctionFlags.BlueprintEvent
+                        | FunctionFlags.Protected
+                        | FunctionFlags.Private
+                        | FunctionFlags.Delegate;
 
-                        // TODO: Events and virtual methods:
-                        // For now let's just skip what's not public
-                        FunctionFlags flagsToIgnore =
-                            FunctionFlags.BlueprintEvent
-                            | FunctionFlags.Protected
-                            | FunctionFlags.Private
-                            | FunctionFlags.Delegate;
+                    if ((ueFunction.Flags & flagsToIgnore) != 0)
+                        continue;
 
-                        if ((ueFunction.Flags & flagsToIgnore) != 0)
-                            continue;
+                    // Custom thunk functions are fake and don't actually have an implementation we can call.
+                    if (ueFunction.Meta.ContainsKey("CustomThunk"))
+                        continue;
 
-                        // Custom thunk functions are fake and don't actually have an implementation we can call.
-                        if (ueFunction.Meta.ContainsKey("CustomThunk"))
-                            continue;
+                    // Functions of types without API access are invoked through their reflection data, which
+                    // requires the frame layout exported by newer binders.
+                    if (!hasApi && ueFunction.ParmsSize == 0
+                                && (ueFunction.Parameters.Count > 0 || ueFunction.ReturnValueOffset >= 0))
+                    {
+                        Interlocked.Increment(ref m_stats.SkippedFunctions);
+                        anySkippedFunctions = true;
+                        continue;
+                    }
 
-                        try
+                    try
+                    {
+                        var fn = FunctionDefinition.PrepareFromNative(Context, writer.Member, ueFunction).Build();
+
+                        NativeFunctionBinder functionWriter;
+                        if (hasApi)
                         {
-                            var fn = FunctionDefinition.PrepareFromNative(Context, writer.Member, ueFunction).Build();
-                            var functionWriter = new NativeFunctionBinder(fn);
-                            writer.AddMember(functionWriter);
+                            functionWriter = new NativeFunctionBinder(fn);
                         }
-                        catch (GenerationException ex)
+                        else
                         {
-                            if (ex is MissingSymbolException ms)
-                                ms.RequestingType = $"{writer.Member.NativeName}::{ueFunction.Name}";
+                            var path = $"/Script/{classData.Module}.{classData.Name}:{ueFunction.Name}";
+                            functionWriter = new ReflectedFunctionBinder(fn, path);
 
-                            m_stats.SkippedFunctions++;
-                            anySkippedFunctions = true;
-                            collector.Add(ex);
+                            Interlocked.Increment(ref m_stats.ReflectedFunctions);
+                            anyReflectedFunctions = true;
                         }
+
+                        functionWriter.IsInstrumented = m_instrumentBindings;
+                        writer.AddMember(functionWriter);
                     }
+                    catch (GenerationException ex)
+                    {
+                        if (ex is MissingSymbolException ms)
+                            ms.RequestingType = $"{writer.Member.NativeName}::{ueFunction.Name}";
 
-                    if (anySkippedFunctions)
-                        m_stats.ClassesMissingFunctions++;
-                }
-                else
-                {
-                    m_stats.ClassesMissingFunctionsNoExport++;
+                        Interlocked.Increment(ref m_stats.SkippedFunctions);
+                        anySkippedFunctions = true;
+                        collector.Add(ex);
+                    }
                 }
+
+                if (anySkippedFunctions)
+                    Interlocked.Increment(ref m_stats.ClassesMissingFunctions);
+
+                if (anyReflectedFunctions)
+                    Interlocked.Increment(ref m_stats.ClassesWithReflectedFunctions);
             }
             else
             {
@@ -340,7 +417,7 @@ namespace Unreal.Generation
                 // For now we're ignoring class properties.
                 foreach (var ueProperty in typeData.Properties)
                 {
-                    m_stats.TotalProperties++;
+                    Interlocked.Increment(ref m_stats.TotalProperties);
 
                     try
                     {
@@ -356,14 +433,14 @@ namespace Unreal.Generation
                         if (ex is MissingSymbolException ms)
                             ms.RequestingType = $"{writer.Member.NativeName}::{ueProperty.Name}";
 
-                        m_stats.SkippedProperties++;
+                        Interlocked.Increment(ref m_stats.SkippedProperties);
                         anySkippedProperties = true;
                         collector.Add(ex);
                     }
                 }
 
                 if (anySkippedProperties)
-                    m_stats.StructsMissingProperties++;
+                    Interlocked.Increment(ref m_stats.StructsMissingProperties);
             }
 
             collector.ThrowIfNeeded();
@@ -447,6 +524,44 @@ namespace Unreal.Generation
             }
         }
 
+        private void CollectField(UEField field)
+        {
+            if (field.Meta.ContainsKey(MetaAttribute.ManagedTypeAttributeName))
+                return; // Skip types that were generated by us already
+
+            if (field.Meta.TryGetValue("ModuleRelativePath", out var relativePath)
+                && relativePath.StartsWith("Private"))
+                return;
+
+            if (field is UEStruct @struct)
+            {
+                if (field is UEClass @class)
+                {
+                    if (TypeBlacklist.Contains(@class.CppName))
+                        return;
+
+                    m_classes.Add(@class);
+                }
+                else
+                {
+                    m_stats.TotalStructs++;
+
+                    // TODO: Support properties with object references.
+                    if (@struct.Properties.Any(x => x.PropertyType == "ObjectProperty"))
+                    {
+                        m_stats.SkippedStructReferenceType++;
+                        return;
+                    }
+
+                    m_structs.Add(@struct);
+                }
+            }
+            else if (field is UEEnum @enum)
+            {
+                CollectEnum(@enum);
+            }
+        }
+
         private void CollectEnum(UEEnum enumInfo)
         {
             // TODO: Enum meta.
@@ -65,7 +65,10 @@ namespace Unreal.Generation
                 writer.Write(FormatMarshalledArgumentList(false, Codespace.Native, MarshalOrder.Marshalled));
 
             using (writer.OpenBlock())
+            {
+                WriteInstrumentationScope(writer);
                 WriteBindingCall(writer, Codespace.Native, Order.After);
+            }
         }
     }
 }
\ No newline at end of file
@@ -19,6 +19,16 @@ namespace Unreal.Generation
 
         public float GeneratedFunctionRatio => TotalFunctions > 0 ? 1 - (float) SkippedFunctions / TotalFunctions : 0;
 
+        /// <summary>
+        /// Modules excluded by the generation settings.
+        /// </summary>
+        public int PrunedModules;
+
+        /// <summary>
+        /// Types excluded by the generation settings, either directly or because their module was excluded.
+        /// </summary>
+        public int PrunedTypes;
+
         /// <summary>
         /// Structs not generated because they contained reference types.
         /// </summary>
@@ -50,20 +60,26 @@ namespace Unreal.Generation
         public int ClassesMissingFunctions;
 
         /// <summary>
-        /// Number of classes missing functions because those were not exported.
+        /// Functions of classes without API access, bound through their reflection data.
+        /// </summary>
+        public int ReflectedFunctions;
+
+        /// <summary>
+        /// Number of classes with functions bound through their reflection data.
         /// </summary>
-        public int ClassesMissingFunctionsNoExport;
+        public int ClassesWithReflectedFunctions;
 
         /// <summary>
         /// Whether these stats have recorded any missing types and or members.
         /// </summary>
         public bool AnyMissing
-            => SkippedStructReferenceType + SkippedFunctions + SkippedProperties + ClassesMissingFunctionsNoExport > 0;
+            => SkippedStructReferenceType + SkippedFunctions + SkippedProperties > 0;
 
         public override string ToString()
         {
             return $@"Types
     Total: {TotalTypes}
+    Pruned: {PrunedTypes} (from {PrunedModules} excluded modules and type rules)
     Enums: {TotalEnums}
     Structs: {TotalStructs}
         Skipped Non-Blitable: {SkippedStructReferenceType}
@@ -79,7 +95,7 @@ Functions:
         Generated: {GeneratedFunctionRatio:P}
         Skipped: {SkippedFunctions}
     Classes Missing: {ClassesMissingFunctions}
-    Classes Missing NoExport: {ClassesMissingFunctionsNoExport}
+    Reflected: {ReflectedFunctions} (in {ClassesWithReflectedFunctions} classes without API access)
 ";
         }
     }
@@ -0,0 +1,138 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System.Linq;
+using Unreal.Marshalling;
+using Unreal.Metadata;
+
+namespace Unreal.Generation
+{
+    /// <summary>
+    /// Binds a native function through its reflection data.
+    /// </summary>
+    /// <remarks>
+    /// Used for classes that do not export their functions from their module. Instead of calling the method the
+    /// native thunk fills a parameter struct that mirrors the UFunction's frame and invokes the UFunction with it, the
+    /// function is resolved once per call site. The managed side is the same as for <see cref="NativeFunctionBinder"/>.
+    /// </remarks>
+    public class ReflectedFunctionBinder : NativeFunctionBinder
+    {
+        private const string ReturnValueName = "ReturnValue";
+
+        /// <summary>
+        /// Full path of the UFunction.
+        /// </summary>
+        public string FunctionPath { get; }
+
+        private string InvokerName => Member.EntryPointName + "_Invoke";
+
+        public ReflectedFunctionBinder(FunctionDefinition function, string functionPath)
+            : base(function)
+        {
+            FunctionPath = functionPath;
+            AdditionalHeaders.Add("DotNetReflectedCall.h");
+        }
+
+        public override void Write(CodeWriter writer, MemberCodeComponent component)
+        {
+            if (component == MemberCodeComponent.NativeImplementation)
+            {
+                WriteInvoker(writer);
+                writer.WriteLine();
+            }
+
+            base.Write(writer, component);
+        }
+
+        protected override void WriteTargetCall(CodeWriter writer, Codespace space, string arguments)
+        {
+            writer.Write(InvokerName);
+
+            using (writer.OpenParenthesis(";\n"))
+            {
+                writer.Write(IsStatic ? "nullptr" : Marshalling.Parameters[0].Name);
+                if (arguments.Length > 0)
+                    writer.Write(", " + arguments);
+            }
+        }
+
+        /// <summary>
+        /// Write the function that packs the arguments into the parameter frame and invokes the UFunction.
+        /// </summary>
+        /// <remarks>Locals are prefixed so they can't collide with parameter names.</remarks>
+        private void WriteInvoker(CodeWriter writer)
+        {
+            var returnType = Member.Return.Type;
+            bool hasFrame = Member.Parameters.Length > 0 || !returnType.IsVoid;
+
+            writer.Write($"static {returnType.FormatNative()} {InvokerName}");
+
+            using (writer.OpenParenthesis("\n"))
+            {
+                writer.Write($"{Member.EnclosingType.FormatName(Codespace.Native)}* ReflectedSelf");
+                if (Member.Parameters.Length > 0)
+                    writer.Write(", " + FormatArgumentList(false, Codespace.Native));
+            }
+
+            using (writer.OpenBlock())
+            {
+                if (!hasFrame)
+                {
+                    WriteLookup(writer, "0", "");
+                    writer.WriteLine("FDotNetReflectedCall::Invoke(ReflectedSelf, ReflectedFunction, nullptr);");
+                    return;
+                }
+
+                writer.WriteLine("struct FParms");
+                using (writer.OpenBlock(";"))
+                {
+                    foreach (var parameter in Member.Parameters)
+                        writer.WriteLine($"{parameter.Type.TypeInfo.FormatName(Codespace.Native)} {parameter.Name};");
+
+                    if (!returnType.IsVoid)
+                        writer.WriteLine($"{returnType.TypeInfo.FormatName(Codespace.Native)} {ReturnValueName};");
+                }
+
+                writer.WriteLine();
+
+                var names = Member.Parameters.Select(x => x.Name).ToList();
+                if (!returnType.IsVoid)
+                    names.Add(ReturnValueName);
+
+                var layout = string.Join(", ",
+                    names.Select(x => $"{{STRUCT_OFFSET(FParms, {x}), sizeof(FParms::{x})}}"));
+                WriteLookup(writer, "sizeof(FParms)", layout);
+                writer.WriteLine();
+
+                writer.WriteLine($"FParms ReflectedParms{{{FormatArgumentList(true, Codespace.Native)}}};");
+                writer.WriteLine("FDotNetReflectedCall::Invoke(ReflectedSelf, ReflectedFunction, &ReflectedParms);");
+
+                foreach (var parameter in Member.Parameters)
+                {
+                    if (parameter.Type.TransferType.IsOut())
+                        writer.WriteLine($"{parameter.Name} = MoveTemp(ReflectedParms.{parameter.Name});");
+                }
+
+                if (!returnType.IsVoid)
+                    writer.WriteLine($"return MoveTemp(ReflectedParms.{ReturnValueName});");
+            }
+        }
+
+        /// <summary>
+        /// Write the lookup of the UFunction.
+        /// </summary>
+        /// <remarks>
+        /// Only a resolved function is cached, a failed lookup is reported and retried by the next call instead of
+        /// leaving the binding broken for the rest of the session.
+        /// </remarks>
+        private void WriteLookup(CodeWriter writer, string parmsSize, string layout)
+        {
+            writer.WriteLine("static UFunction* ReflectedFunction = nullptr;");
+            writer.WriteLine("if (!ReflectedFunction)");
+            writer.PushIndent();
+            writer.WriteLine(
+                $"ReflectedFunction = FDotNetReflectedCall::FindFunction(TEXT(\"{FunctionPath}\"), {parmsSize}, {{{layout}}});");
+            writer.PopIndent();
+        }
+    }
+}
@@ -2,152 +2,264 @@
 // Licensed under the MIT license.
 
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Linq;
+using System.Linq.Expressions;
 using System.Reflection;
-using System.Text.RegularExpressions;
+using System.Text;
 
 namespace Unreal.Generation
 {
+    /// <summary>
+    /// Replaces {Name} placeholders in a template with the values of members of model objects.
+    /// </summary>
+    /// <remarks>
+    /// Templates are parsed once into a list of literal and placeholder segments. Placeholders are bound to compiled
+    /// member accessors once per combination of model types, so writing a template only costs evaluating the members
+    /// and concatenating the output. Placeholders no model provides a value for are left as is.
+    /// </remarks>
     public static class TemplateWriter
     {
-        private static readonly Dictionary<Type, Model> Models = new();
+        private static readonly ConcurrentDictionary<Type, Model> Models = new();
 
+        private static readonly ConcurrentDictionary<string, Template> Templates = new();
+
+        /// <summary>
+        /// Write a template with the values of the members of the provided models.
+        /// </summary>
+        /// <param name="template">The template, parsed templates are cached so this should be a constant.</param>
+        /// <param name="arguments">Models providing the values, earlier models take precedence.</param>
+        /// <returns></returns>
         public static string WriteTemplate(string template, params object[] arguments)
         {
-            var models = arguments.Select(x => (Model: GetModel(x), Values: x)).ToList();
-
-            var patterns = models.SelectMany(x => x.Model.Values).Select(x => @$"\{{{x.Name}\}}");
-            var regex = new Regex(string.Join("|", patterns));
-
-            var evaluator = new Evaluator(models);
-
-            return regex.Replace(template, evaluator.MatchEvaluator);
+            var parsed = Templates.GetOrAdd(template, x => new Template(x));
+            return parsed.Write(arguments);
         }
 
-        private static Model GetModel(object instance)
+        private static Model GetModel(Type type)
         {
-            var type = instance.GetType();
-            if (!Models.TryGetValue(type, out var model))
-                Models[type] = model = new Model(type);
-
-            return model;
+            return Models.GetOrAdd(type, x => new Model(x));
         }
 
-        private class Model : Dictionary<string, IValueProvider>
+        /// <summary>
+        /// A template split into its literal text and placeholders.
+        /// </summary>
+        private class Template
         {
-            public Model(Type type)
+            private readonly string m_text;
+
+            // Literal text between placeholders, one more than there are placeholders.
+            private readonly string[] m_literals;
+
+            // Names of the placeholders, without braces.
+            private readonly string[] m_placeholders;
+
+            private readonly ConcurrentDictionary<BindingKey, Accessor?[]> m_bindings = new();
+
+            public Template(string text)
             {
-                var bindingFlags = BindingFlags.Instance
-                                   | BindingFlags.Static
-                                   | BindingFlags.Public
-                                   | BindingFlags.NonPublic;
+                m_text = text;
 
-                // TODO: This ignores values from parent types.
+                var literals = new List<string>();
+                var placeholders = new List<string>();
 
-                foreach (var property in type.GetProperties(bindingFlags))
+                int literalStart = 0;
+                for (int i = 0; i < text.Length; ++i)
                 {
-                    if (property.GetMethod != null)
-                        Add(new PropertyGetter(property));
-                }
+                    if (text[i] != '{')
+                        continue;
 
-                foreach (var field in type.GetFields(bindingFlags))
-                {
-                    Add(new FieldGetter(field));
-                }
+                    int end = i + 1;
+                    while (end < text.Length && IsNameCharacter(text[end]))
+                        ++end;
 
-                foreach (var method in type.GetMethods(bindingFlags))
-                {
-                    if (method.ReturnType != typeof(void) && method.GetParameters().Length == 0)
-                        Add(new MethodGetter(method));
+                    if (end == i + 1 || end == text.Length || text[end] != '}')
+                        continue;
+
+                    literals.Add(text.Substring(literalStart, i - literalStart));
+                    placeholders.Add(text.Substring(i + 1, end - i - 1));
+
+                    literalStart = end + 1;
+                    i = end;
                 }
-            }
 
-            private void Add(IValueProvider provider)
-            {
-                var key = $"{{{provider.Name}}}";
-                base.Add(key, provider);
+                literals.Add(text.Substring(literalStart));
+
+                m_literals = literals.ToArray();
+                m_placeholders = placeholders.ToArray();
             }
-        }
 
-        private class Evaluator
-        {
-            private readonly List<(Model Model, object Instance)> m_models;
+            private static bool IsNameCharacter(char c) => char.IsLetterOrDigit(c) || c == '_';
 
-            public Evaluator(List<(Model Model, object Instance)> models)
+            public string Write(object[] arguments)
             {
-                m_models = models;
+                if (m_placeholders.Length == 0)
+                    return m_text;
+
+                var accessors = m_bindings.GetOrAdd(new BindingKey(arguments), Bind);
+
+                var builder = new StringBuilder(m_text.Length * 2);
+                for (int i = 0; i < m_placeholders.Length; ++i)
+                {
+                    builder.Append(m_literals[i]);
+
+                    if (accessors[i] is { } accessor)
+                        builder.Append(accessor.Get(arguments[accessor.Argument]));
+                    else
+                        builder.Append('{').Append(m_placeholders[i]).Append('}');
+                }
+
+                builder.Append(m_literals[m_literals.Length - 1]);
+
+                return builder.ToString();
             }
 
-            public string MatchEvaluator(Match match)
+            /// <summary>
+            /// Find the accessor for each placeholder, the first model that has a member with the name wins.
+            /// </summary>
+            private Accessor?[] Bind(BindingKey key)
             {
-                foreach (var (model, instance) in m_models)
+                var models = key.Types.Select(GetModel).ToArray();
+
+                var accessors = new Accessor?[m_placeholders.Length];
+                for (int i = 0; i < m_placeholders.Length; ++i)
                 {
-                    if (model.TryGetValue(match.Value, out var value))
-                        return value.Get(instance);
+                    for (int j = 0; j < models.Length; ++j)
+                    {
+                        if (models[j].TryGetAccessor(m_placeholders[i], out var get))
+                        {
+                            accessors[i] = new Accessor(j, get);
+                            break;
+                        }
+                    }
                 }
 
-                // Not found, do nothing.
-                return match.Value;
+                return accessors;
             }
         }
 
-        private interface IValueProvider
+        private class Accessor
         {
-            string Name { get; }
+            public readonly int Argument;
 
-            string Get(object instance);
+            public readonly Func<object, string> Get;
+
+            public Accessor(int argument, Func<object, string> get)
+            {
+                Argument = argument;
+                Get = get;
+            }
         }
 
-        private class PropertyGetter : IValueProvider
+        /// <summary>
+        /// The types of the arguments a template is written with.
+        /// </summary>
+        private readonly struct BindingKey : IEquatable<BindingKey>
         {
-            private readonly PropertyInfo m_property;
+            public readonly Type[] Types;
 
-            public string Name => m_property.Name;
-
-            public PropertyGetter(PropertyInfo property)
+            public BindingKey(object[] arguments)
             {
-                m_property = property;
+                Types = new Type[arguments.Length];
+                for (int i = 0; i < arguments.Length; ++i)
+                    Types[i] = arguments[i].GetType();
             }
 
-            public string Get(object instance)
+            public bool Equals(BindingKey other) => Types.SequenceEqual(other.Types);
+
+            public override bool Equals(object? obj) => obj is BindingKey other && Equals(other);
+
+            public override int GetHashCode()
             {
-                return m_property.GetValue(instance)?.ToString() ?? string.Empty;
+                int hash = Types.Length;
+                foreach (var type in Types)
+                    hash = hash * 31 + type.GetHashCode();
+
+                return hash;
             }
         }
 
-        private class FieldGetter : IValueProvider
+        /// <summary>
+        /// The members of a type that can be used in templates.
+        /// </summary>
+        private class Model
         {
-            private readonly FieldInfo m_field;
+            private readonly Type m_type;
+
+            private readonly Dictionary<string, MemberInfo> m_members = new();
 
-            public string Name => m_field.Name;
+            // Accessors are only compiled for members that are actually used.
+            private readonly ConcurrentDictionary<string, Func<object, string>> m_accessors = new();
 
-            public FieldGetter(FieldInfo field)
+            public Model(Type type)
             {
-                m_field = field;
+                m_type = type;
+
+                var bindingFlags = BindingFlags.Instance
+                                   | BindingFlags.Static
+                                   | BindingFlags.Public
+                                   | BindingFlags.NonPublic;
+
+                // TODO: This ignores values from parent types.
+
+                foreach (var property in type.GetProperties(bindingFlags))
+                {
+                    if (property.GetMethod != null && property.GetIndexParameters().Length == 0)
+                        m_members.Add(property.Name, property);
+                }
+
+                foreach (var field in type.GetFields(bindingFlags))
+                {
+                    m_members.Add(field.Name, field);
+                }
+
+                foreach (var method in type.GetMethods(bindingFlags))
+                {
+                    if (method.ReturnType != typeof(void) && method.GetParameters().Length == 0
+                                                          && !method.ContainsGenericParameters)
+                        m_members.Add(method.Name, method);
+                }
             }
 
-            public string Get(object instance)
+            public bool TryGetAccessor(string name, out Func<object, string> accessor)
             {
-                return m_field.GetValue(instance)?.ToString() ?? string.Empty;
+                if (!m_members.TryGetValue(name, out var member))
+                {
+                    accessor = null!;
+                    return false;
+                }
+
+                accessor = m_accessors.GetOrAdd(name, _ => Compile(member));
+                return true;
             }
-        }
 
-        private class MethodGetter : IValueProvider
-        {
-            private readonly MethodInfo m_method;
+            /// <summary>
+            /// Compile <c>instance => Format(((T) instance).Member)</c>.
+            /// </summary>
+            private Func<object, string> Compile(MemberInfo member)
+            {
+                var instance = Expression.Parameter(typeof(object), "instance");
+                var typed = Expression.Convert(instance, m_type);
+
+                Expression value = member switch
+                {
+                    PropertyInfo property => Expression.Property(property.GetMethod!.IsStatic ? null : typed, property),
+                    FieldInfo field => Expression.Field(field.IsStatic ? null : typed, field),
+                    MethodInfo method => Expression.Call(method.IsStatic ? null : typed, method),
+                    _ => throw new ArgumentOutOfRangeException(nameof(member))
+                };
 
-            public string Name => m_method.Name;
+                var format = Expression.Call(typeof(Model).GetMethod(nameof(Format), BindingFlags.NonPublic | BindingFlags.Static)!,
+                    Expression.Convert(value, typeof(object)));
 
-            public MethodGetter(MethodInfo method)
-            {
-                m_method = method;
+                return Expression.Lambda<Func<object, string>>(format, instance).Compile();
             }
 
-            public string Get(object instance)
+            private static string Format(object? value)
             {
-                return m_method.Invoke(instance, null)?.ToString() ?? string.Empty;
+                return value?.ToString() ?? string.Empty;
             }
         }
     }
-}
\ No newline at end of file
+}
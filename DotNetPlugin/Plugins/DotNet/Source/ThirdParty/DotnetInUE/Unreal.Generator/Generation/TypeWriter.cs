@@ -135,7 +135,44 @@ namespace Unreal.Generation
 
         protected virtual void WriteNativeImplementation(CodeWriter writer, List<MemberWriter> members)
         {
-            writer.WriteLine($"#include \"{Member.Header}\"\n");
+            foreach (var header in GetNativeImplementationHeaders())
+                writer.WriteLine($"#include \"{header}\"");
+
+            writer.WriteLine();
+
+            WriteNativeImplementationMembers(writer);
+        }
+
+        /// <summary>
+        /// Headers required by the native implementation of this type.
+        /// </summary>
+        /// <returns></returns>
+        public IEnumerable<string> GetNativeImplementationHeaders()
+        {
+            var headers = new HashSet<string>();
+
+            // The type's own header first, it brings in the engine headers the members rely on.
+            if (!string.IsNullOrWhiteSpace(Member.Header) && headers.Add(Member.Header))
+                yield return Member.Header;
+
+            if (!MembersByComponent.TryGetValue(MemberCodeComponent.NativeImplementation, out var members))
+                yield break;
+
+            foreach (var header in members.SelectMany(x => x.AdditionalHeaders).OrderBy(x => x, StringComparer.Ordinal))
+            {
+                if (!string.IsNullOrWhiteSpace(header) && headers.Add(header))
+                    yield return header;
+            }
+        }
+
+        /// <summary>
+        /// Write the native implementation of the members of this type, without the file header and includes.
+        /// </summary>
+        /// <param name="writer"></param>
+        public void WriteNativeImplementationMembers(CodeWriter writer)
+        {
+            if (!MembersByComponent.TryGetValue(MemberCodeComponent.NativeImplementation, out var members))
+                return;
 
             for (var i = 0; i < members.Count; i++)
             {
@@ -147,6 +184,14 @@ namespace Unreal.Generation
             }
         }
 
+        /// <summary>
+        /// Number of members with a native implementation.
+        /// </summary>
+        public int NativeImplementationCount
+            => MembersByComponent.TryGetValue(MemberCodeComponent.NativeImplementation, out var members)
+                ? members.Count
+                : 0;
+
         protected virtual void WriteManagedPart(CodeWriter writer, List<MemberWriter> members)
         {
             WriteNamespaces(writer, members);
@@ -0,0 +1,75 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System.Collections.Generic;
+using Unreal.Marshalling;
+using Unreal.Metadata;
+
+namespace Unreal.Generation
+{
+    /// <summary>
+    /// Writes the native implementation of several types into a single translation unit.
+    /// </summary>
+    /// <remarks>
+    /// Includes are deduplicated across the types. All types are written with the same code writer so helpers
+    /// numbered per file, such as the JIT entry point stubs, stay unique.
+    /// </remarks>
+    public class UnityFileWriter : AbstractWriter
+    {
+        private readonly int m_index;
+
+        /// <summary>
+        /// Types written to this file.
+        /// </summary>
+        public readonly List<TypeWriter> Types = new();
+
+        /// <summary>
+        /// Number of native members in this file, used to balance the files.
+        /// </summary>
+        public int Weight;
+
+        /// <inheritdoc />
+        public override string Name => $"{Module.ModuleId}.Unity{m_index}";
+
+        /// <inheritdoc />
+        public override Module Module { get; }
+
+        /// <inheritdoc />
+        protected override string CustomFileName => $"{Name}.cpp";
+
+        public UnityFileWriter(Module module, int index)
+        {
+            Components = MemberCodeComponentFlags.Custom;
+
+            Module = module;
+            m_index = index;
+        }
+
+        /// <inheritdoc />
+        public override void Write(CodeWriter writer, MemberCodeComponent component)
+        {
+            WriteFileHeader(writer, component);
+
+            var headers = new HashSet<string>();
+            foreach (var type in Types)
+            {
+                foreach (var header in type.GetNativeImplementationHeaders())
+                {
+                    if (headers.Add(header))
+                        writer.WriteLine($"#include \"{header}\"");
+                }
+            }
+
+            foreach (var type in Types)
+            {
+                writer.WriteLine();
+                writer.WriteLine($"// {type.Member.GetManagedFullName()}");
+                writer.WriteLine();
+
+                type.WriteNativeImplementationMembers(writer);
+            }
+
+            WriteFileFooter(writer, component);
+        }
+    }
+}
@@ -161,10 +161,13 @@ namespace Unreal.Metadata
         /// <returns></returns>
         public static ITypeInfo GetType(Type type)
         {
-            if (!Types.TryGetValue(type, out var info))
-                Types[type] = info = new ManagedTypeInfo(type);
+            lock (Types)
+            {
+                if (!Types.TryGetValue(type, out var info))
+                    Types[type] = info = new ManagedTypeInfo(type);
 
-            return info;
+                return info;
+            }
         }
 
         /// <summary>
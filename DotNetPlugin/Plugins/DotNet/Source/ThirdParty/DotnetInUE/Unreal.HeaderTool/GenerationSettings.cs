@@ -0,0 +1,279 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using System.Text.RegularExpressions;
+using Unreal.NativeMetadata;
+
+namespace Unreal
+{
+    /// <summary>
+    /// Include or exclude rule for module and type names.
+    /// </summary>
+    /// <remarks>
+    /// Rules are written one per line or separated by commas. A rule is a glob pattern (<c>*</c> and <c>?</c>
+    /// wildcards) or a regular expression when surrounded by slashes, which may itself contain commas as a rule only
+    /// ends at a closing slash followed by a comma or the end of the line. Rules prefixed with <c>-</c> exclude matching
+    /// names, an optional <c>+</c> prefix marks an include rule. Must match the behaviour of FNamePattern in the binder.
+    /// </remarks>
+    public readonly struct NamePattern
+    {
+        public readonly Regex Pattern;
+
+        public readonly bool IsExclude;
+
+        public NamePattern(Regex pattern, bool isExclude)
+        {
+            Pattern = pattern;
+            IsExclude = isExclude;
+        }
+
+        /// <summary>
+        /// Parse a list of rules.
+        /// </summary>
+        /// <param name="rules">Rules separated by new lines or commas.</param>
+        /// <returns></returns>
+        public static List<NamePattern> Parse(string rules)
+        {
+            var patterns = new List<NamePattern>();
+
+            foreach (var rule in SplitRules(rules))
+            {
+                var line = rule;
+
+                bool exclude = false;
+                if (line[0] == '-' || line[0] == '+')
+                {
+                    exclude = line[0] == '-';
+                    line = line.Substring(1).TrimStart();
+                }
+
+                var regex = line.Length > 1 && line.StartsWith("/") && line.EndsWith("/")
+                    ? line.Substring(1, line.Length - 2)
+                    : GlobToRegex(line);
+
+                patterns.Add(new NamePattern(new Regex(regex, RegexOptions.CultureInvariant), exclude));
+            }
+
+            return patterns;
+        }
+
+        /// <summary>
+        /// Split rules on line breaks and commas, keeping the commas of regular expressions and skipping comments.
+        /// </summary>
+        /// <param name="rules"></param>
+        /// <returns>The trimmed rules.</returns>
+        private static IEnumerable<string> SplitRules(string rules)
+        {
+            foreach (var rawLine in rules.Split(new[] {'\n', '\r'}, StringSplitOptions.RemoveEmptyEntries))
+            {
+                var line = rawLine.Trim();
+                if (line.StartsWith(";") || line.StartsWith("#"))
+                    continue;
+
+                int start = 0;
+                while (start < line.Length)
+                {
+                    var end = FindRuleEnd(line, start);
+
+                    var rule = line.Substring(start, end - start).Trim();
+                    if (rule.Length > 0)
+                        yield return rule;
+
+                    start = end + 1;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Find the comma that ends the rule starting at an index, or the end of the line.
+        /// </summary>
+        private static int FindRuleEnd(string line, int start)
+        {
+            var index = start;
+            while (index < line.Length && (char.IsWhiteSpace(line[index]) || line[index] == '-' || line[index] == '+'))
+                ++index;
+
+            if (index < line.Length && line[index] == '/')
+            {
+                for (var slash = line.IndexOf('/', index + 1); slash >= 0; slash = line.IndexOf('/', slash + 1))
+                {
+                    var next = slash + 1;
+                    while (next < line.Length && char.IsWhiteSpace(line[next]))
+                        ++next;
+
+                    if (next == line.Length || line[next] == ',')
+                        return next;
+                }
+            }
+
+            var comma = line.IndexOf(',', start);
+            return comma < 0 ? line.Length : comma;
+        }
+
+        /// <summary>
+        /// Match a name against a list of patterns, the last matching pattern wins.
+        /// </summary>
+        /// <param name="patterns">Patterns in the order they were declared.</param>
+        /// <param name="name">Name to match.</param>
+        /// <param name="defaultValue">Result when no pattern matches.</param>
+        /// <returns></returns>
+        public static bool IsMatch(List<NamePattern> patterns, string name, bool defaultValue = false)
+        {
+            for (int i = patterns.Count - 1; i >= 0; --i)
+            {
+                if (patterns[i].Pattern.IsMatch(name))
+                    return !patterns[i].IsExclude;
+            }
+
+            return defaultValue;
+        }
+
+        private static string GlobToRegex(string glob)
+        {
+            var builder = new StringBuilder("^");
+            foreach (var c in glob)
+            {
+                builder.Append(c switch
+                {
+                    '*' => ".*",
+                    '?' => ".",
+                    _ => Regex.Escape(c.ToString())
+                });
+            }
+
+            return builder.Append('$').ToString();
+        }
+    }
+
+    /// <summary>
+    /// Generation rules shared with the native binder, read from DotNetGenerator.ini.
+    /// </summary>
+    public class GenerationSettings
+    {
+        public const string FileName = "DotNetGenerator.ini";
+
+        private const string GenerationSection = "Generation";
+        private const string ModuleSectionPrefix = "Generation.Module.";
+
+        // Engine modules exported when no rules are configured.
+        private const string DefaultEngineModules = "CoreUObject, Engine";
+
+        /// <summary>
+        /// Whether the file declared any generation rules.
+        /// </summary>
+        public bool HasRules { get; private set; }
+
+        public List<NamePattern> EngineModules { get; private set; } = NamePattern.Parse(DefaultEngineModules);
+
+        public List<NamePattern> GameModules { get; private set; } = NamePattern.Parse("*");
+
+        /// <summary>
+        /// Type rules for specific modules.
+        /// </summary>
+        public Dictionary<string, List<NamePattern>> ModuleTypes { get; } = new();
+
+        public bool ShouldGenerateModule(string module, BuildModuleType moduleType)
+        {
+            return NamePattern.IsMatch(IsGame(moduleType) ? GameModules : EngineModules, module);
+        }
+
+        public bool ShouldGenerateType(string module, string type)
+        {
+            return !ModuleTypes.TryGetValue(module, out var patterns) || NamePattern.IsMatch(patterns, type);
+        }
+
+        private static bool IsGame(BuildModuleType type)
+        {
+            return type is BuildModuleType.GameRuntime or BuildModuleType.GameUncooked
+                or BuildModuleType.GameDeveloper or BuildModuleType.GameEditor or BuildModuleType.GameThirdParty;
+        }
+
+        /// <summary>
+        /// Load the settings from the contents of an ini file.
+        /// </summary>
+        /// <param name="contents"></param>
+        /// <returns></returns>
+        public static GenerationSettings Load(string contents)
+        {
+            var settings = new GenerationSettings();
+
+            foreach (var pair in ReadIni(contents))
+            {
+                var section = pair.Key;
+                var values = pair.Value;
+
+                if (section == GenerationSection)
+                {
+                    if (values.TryGetValue("Modules", out var modules))
+                        settings.EngineModules = NamePattern.Parse(modules);
+
+                    if (values.TryGetValue("GameModules", out var gameModules))
+                        settings.GameModules = NamePattern.Parse(gameModules);
+
+                    settings.HasRules = true;
+                }
+                else if (section.StartsWith(ModuleSectionPrefix))
+                {
+                    values.TryGetValue("Generate", out var types);
+                    settings.ModuleTypes[section.Substring(ModuleSectionPrefix.Length)] =
+                        NamePattern.Parse(types ?? "*");
+
+                    settings.HasRules = true;
+                }
+            }
+
+            return settings;
+        }
+
+        /// <summary>
+        /// Minimal ini reader supporting the multi-line values (<c>Key=&lt;&lt;&lt;TAG</c> ... <c>TAG</c>) used by the binder.
+        /// </summary>
+        private static Dictionary<string, Dictionary<string, string>> ReadIni(string contents)
+        {
+            var sections = new Dictionary<string, Dictionary<string, string>>();
+            Dictionary<string, string>? current = null;
+
+            using var reader = new StringReader(contents);
+            while (reader.ReadLine() is { } line)
+            {
+                line = line.Trim().TrimStart('\uFEFF');
+                if (line.Length == 0 || line[0] == ';' || line[0] == '#')
+                    continue;
+
+                if (line[0] == '[' && line.EndsWith("]"))
+                {
+                    var name = line.Substring(1, line.Length - 2).Trim();
+                    if (!sections.TryGetValue(name, out current))
+                        sections[name] = current = new Dictionary<string, string>();
+                    continue;
+                }
+
+                var separator = line.IndexOf('=');
+                if (separator < 0 || current == null)
+                    continue;
+
+                var key = line.Substring(0, separator).Trim();
+                var value = line.Substring(separator + 1).Trim();
+
+                if (value.StartsWith("<<<"))
+                {
+                    var tag = value.Substring(3).Trim();
+                    var builder = new StringBuilder();
+
+                    while (reader.ReadLine() is { } valueLine && valueLine.Trim() != tag)
+                        builder.AppendLine(valueLine);
+
+                    value = builder.ToString();
+                }
+
+                current[key] = value;
+            }
+
+            return sections;
+        }
+    }
+}
@@ -23,8 +23,14 @@ namespace Unreal
         /// <param name="path"></param>
         public MetadataCollector(string path)
         {
+            var databases = Directory.GetFiles(path, "*" + MetadataDatabase.Extension, SearchOption.AllDirectories);
+            var databaseModules = MetadataDatabase.GetDatabaseModules(databases);
+
             foreach (var file in Directory.EnumerateFiles(path, "*.umeta", SearchOption.AllDirectories))
             {
+                if (MetadataDatabase.IsSuperseded(file, databaseModules))
+                    continue;
+
                 var meta = LoadFromString(File.ReadAllText(file));
 
                 if (meta is UEModule module)
@@ -54,6 +60,14 @@ namespace Unreal
                     }
                 }
             }
+
+            foreach (var file in databases)
+            {
+                using var database = MetadataDatabase.Open(file);
+
+                Modules.Add(database.Module);
+                Types.AddRange(database.ReadTypes());
+            }
         }
 
         public IEnumerable<UEProperty> GetAllProperties()
@@ -0,0 +1,520 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+using System.Text;
+using Unreal.NativeMetadata;
+
+namespace Unreal
+{
+    /// <summary>
+    /// Reader for the binary metadata database exported by the native binder, one per module.
+    /// </summary>
+    /// <remarks>
+    /// The database is mapped into memory and records are read in place. Strings are only decoded the first
+    /// time they are used. The layout must be kept in sync with DotNetNativeBinder/Public/MetadataDatabase.h.
+    /// </remarks>
+    public sealed unsafe class MetadataDatabase : IDisposable
+    {
+        public const string Extension = ".umdb";
+
+        internal const uint Magic = 0x42444D55; // UMDB
+        internal const uint Version = 2;
+        internal const uint InvalidIndex = 0xFFFFFFFF;
+
+        private readonly MemoryMappedFile m_file;
+        private readonly MemoryMappedViewAccessor m_view;
+        private readonly byte* m_base;
+        private readonly long m_length;
+
+        private readonly string?[] m_strings;
+
+        private ref Header FileHeader => ref *(Header*) m_base;
+
+        /// <summary>
+        /// The module described by this database.
+        /// </summary>
+        public UEModule Module { get; }
+
+        /// <summary>
+        /// Number of types in the database.
+        /// </summary>
+        public int TypeCount => (int) FileHeader.Types.Count;
+
+        private MetadataDatabase(string path)
+        {
+            m_length = new FileInfo(path).Length;
+            if (m_length < sizeof(Header))
+                throw new InvalidDataException($"Metadata database {path} is truncated.");
+
+            m_file = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            m_view = m_file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+            byte* pointer = null;
+            m_view.SafeMemoryMappedViewHandle.AcquirePointer(ref pointer);
+            m_base = pointer + m_view.PointerOffset;
+
+            m_strings = Array.Empty<string?>();
+
+            try
+            {
+                Validate(path);
+
+                m_strings = new string?[FileHeader.Strings.Count];
+
+                ref var module = ref FileHeader.Module;
+                Module = new UEModule
+                {
+                    Kind = UETypeKind.UPackage,
+                    Name = GetString(module.Name),
+                    LongName = GetString(module.LongName),
+                    Folder = GetString(module.Folder),
+                    File = GetString(module.File),
+                    PackageType = (BuildModuleType) module.PackageType
+                };
+            }
+            catch
+            {
+                Dispose();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Open a metadata database file.
+        /// </summary>
+        /// <param name="path">Path to the file.</param>
+        /// <returns></returns>
+        /// <exception cref="InvalidDataException">If the file is not a valid database.</exception>
+        public static MetadataDatabase Open(string path) => new(path);
+
+        /// <summary>
+        /// Get the modules exported as databases among a set of metadata files.
+        /// </summary>
+        /// <param name="paths">Paths of all metadata files.</param>
+        /// <returns>Database paths without the extension, to be used with <see cref="IsSuperseded"/>.</returns>
+        public static HashSet<string> GetDatabaseModules(IEnumerable<string> paths)
+        {
+            var modules = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+            foreach (var path in paths)
+            {
+                if (path.EndsWith(Extension))
+                    modules.Add(Path.ChangeExtension(path, null));
+            }
+
+            return modules;
+        }
+
+        /// <summary>
+        /// Whether a json metadata file was left over from an export of a module that now has a database.
+        /// </summary>
+        /// <remarks>
+        /// The module file sits next to the database and type files in a folder named after the module.
+        /// </remarks>
+        public static bool IsSuperseded(string jsonPath, HashSet<string> databaseModules)
+        {
+            return databaseModules.Contains(Path.ChangeExtension(jsonPath, null))
+                   || databaseModules.Contains(Path.GetDirectoryName(jsonPath) ?? "");
+        }
+
+        public void Dispose()
+        {
+            m_view.SafeMemoryMappedViewHandle.ReleasePointer();
+            m_view.Dispose();
+            m_file.Dispose();
+        }
+
+        #region Reading
+
+        /// <summary>
+        /// Read all types in the database.
+        /// </summary>
+        /// <returns></returns>
+        public IEnumerable<UEField> ReadTypes()
+        {
+            for (int i = 0; i < TypeCount; ++i)
+                yield return ReadType(i);
+        }
+
+        /// <summary>
+        /// Read a single type from the database.
+        /// </summary>
+        /// <param name="index"></param>
+        /// <returns></returns>
+        public UEField ReadType(int index)
+        {
+            ref var record = ref GetRecord<TypeRecord>(FileHeader.Types, (uint) index);
+            var kind = (UETypeKind) record.Kind;
+
+            UEField field;
+            switch (kind)
+            {
+                case UETypeKind.UEnum:
+                {
+                    var @enum = new UEEnum
+                    {
+                        Form = (UEnumCppForm) record.EnumForm,
+                        CppName = GetString(record.CppName),
+                        IsFlags = record.IsFlags != 0,
+                        MaxValue = record.MaxValue
+                    };
+
+                    for (uint i = 0; i < record.EnumValues.Count; ++i)
+                    {
+                        ref var value = ref GetRecord<EnumValueRecord>(FileHeader.EnumValues,
+                            record.EnumValues.Start + i);
+                        @enum.Values.Add(new UEEnumValue(GetString(value.Name), value.Value));
+                    }
+
+                    field = @enum;
+                    break;
+                }
+                case UETypeKind.UObject:
+                case UETypeKind.UInterface:
+                {
+                    var @class = new UEClass {Flags = (ClassFlags) record.Flags};
+
+                    for (uint i = 0; i < record.Interfaces.Count; ++i)
+                        @class.Interfaces.Add(GetString(GetRecord<uint>(FileHeader.Indices,
+                            record.Interfaces.Start + i)));
+
+                    for (uint i = 0; i < record.Functions.Count; ++i)
+                    {
+                        var function = ReadFunction(record.Functions.Start + i);
+                        function.Class = @class;
+                        foreach (var parameter in function.Parameters)
+                            parameter.Struct = @class;
+
+                        @class.Functions.Add(function);
+                    }
+
+                    field = @class;
+                    break;
+                }
+                case UETypeKind.UStruct:
+                    field = new UEStruct();
+                    break;
+                default:
+                    throw new InvalidDataException($"Unexpected type kind {kind} in metadata database.");
+            }
+
+            field.Kind = kind;
+            field.Name = GetString(record.Name);
+            field.Module = GetString(record.Module);
+            ReadMeta(record.Meta, field.Meta);
+
+            if (field is UEStruct @struct)
+            {
+                @struct.CppName = GetString(record.CppName);
+                @struct.Size = record.Size;
+                @struct.Parent = ReadTypeName(record.Parent);
+
+                for (uint i = 0; i < record.Properties.Count; ++i)
+                {
+                    var property = ReadProperty(record.Properties.Start + i);
+                    property.Struct = @struct;
+                    @struct.Properties.Add(property);
+                }
+            }
+
+            return field;
+        }
+
+        private UEFunction ReadFunction(uint index)
+        {
+            ref var record = ref GetRecord<FunctionRecord>(FileHeader.Functions, index);
+
+            var function = new UEFunction
+            {
+                Kind = UETypeKind.UFunction,
+                Name = GetString(record.Name),
+                Flags = (FunctionFlags) record.Flags,
+                ParmsSize = record.ParmsSize,
+                ReturnValueOffset = record.ReturnValueOffset,
+            };
+
+            ReadMeta(record.Meta, function.Meta);
+
+            for (uint i = 0; i < record.Parameters.Count; ++i)
+            {
+                var parameter = ReadProperty(record.Parameters.Start + i);
+                parameter.Function = function;
+                function.Parameters.Add(parameter);
+            }
+
+            if (record.Return != InvalidIndex)
+            {
+                function.Return = ReadProperty(record.Return);
+                function.Return.Function = function;
+            }
+
+            return function;
+        }
+
+        private UEProperty ReadProperty(uint index)
+        {
+            ref var record = ref GetRecord<PropertyRecord>(FileHeader.Properties, index);
+
+            var property = new UEProperty(GetString(record.Name), GetString(record.RawType))
+            {
+                PropertyType = GetString(record.PropertyType),
+                Offset = record.Offset,
+                Flags = (PropertyFlags) record.Flags,
+                ArrayDim = record.ArrayDim,
+                Type = ReadTypeName(record.Type),
+                IsUnknown = record.IsUnknown != 0
+            };
+
+            ReadMeta(record.Meta, property.Meta);
+
+            for (uint i = 0; i < record.GenericArguments.Count; ++i)
+            {
+                var argumentIndex = record.GenericArguments.Start + i;
+                ref var argument = ref GetRecord<TypeRefRecord>(FileHeader.TypeRefs, argumentIndex);
+
+                if (argument.Kind == TypeRefKind.Property)
+                {
+                    property.GenericTypeParameters.Add(new TypePropertyReference
+                        {Property = ReadProperty(argument.Property)});
+                }
+                else
+                {
+                    property.GenericTypeParameters.Add(ReadTypeName(argumentIndex)!);
+                }
+            }
+
+            return property;
+        }
+
+        private TypeNameReference? ReadTypeName(uint index)
+        {
+            if (index == InvalidIndex)
+                return null;
+
+            ref var record = ref GetRecord<TypeRefRecord>(FileHeader.TypeRefs, index);
+
+            return new TypeNameReference
+            {
+                Module = GetString(record.Module),
+                Name = GetString(record.Name),
+                CppName = GetString(record.CppName)
+            };
+        }
+
+        private void ReadMeta(Range range, Dictionary<string, string> meta)
+        {
+            for (uint i = 0; i < range.Count; ++i)
+            {
+                ref var record = ref GetRecord<MetaRecord>(FileHeader.Meta, range.Start + i);
+                meta[GetString(record.Key)] = GetString(record.Value);
+            }
+        }
+
+        /// <summary>
+        /// Get a string from the string table.
+        /// </summary>
+        /// <param name="index"></param>
+        /// <returns></returns>
+        /// <exception cref="InvalidDataException">If the index or the string record is out of range.</exception>
+        internal string GetString(uint index)
+        {
+            if (index >= m_strings.Length)
+                throw new InvalidDataException($"Metadata database string index {index} is out of range.");
+
+            var cached = m_strings[index];
+            if (cached != null)
+                return cached;
+
+            ref var record = ref GetRecord<StringRecord>(FileHeader.Strings, index);
+            if ((ulong) record.Offset + record.Length > FileHeader.StringData.Count)
+                throw new InvalidDataException($"Metadata database string {index} is outside of the string data.");
+
+            var data = m_base + FileHeader.StringData.Offset + record.Offset;
+
+            return m_strings[index] = Encoding.UTF8.GetString(data, (int) record.Length);
+        }
+
+        private ref T GetRecord<T>(in TableRef table, uint index)
+            where T : unmanaged
+        {
+            if (index >= table.Count)
+                throw new InvalidDataException("Metadata database record index is out of range.");
+
+            return ref *((T*) (m_base + table.Offset) + index);
+        }
+
+        private void Validate(string path)
+        {
+            ref var header = ref FileHeader;
+
+            if (header.Magic != Magic)
+                throw new InvalidDataException($"File {path} is not a metadata database.");
+
+            if (header.Version != Version)
+                throw new InvalidDataException(
+                    $"Metadata database {path} has version {header.Version}, expected {Version}. Re-run the header tool to update it.");
+
+            ValidateTable<StringRecord>(header.Strings);
+            ValidateTable<byte>(header.StringData);
+            ValidateTable<TypeRecord>(header.Types);
+            ValidateTable<FunctionRecord>(header.Functions);
+            ValidateTable<PropertyRecord>(header.Properties);
+            ValidateTable<TypeRefRecord>(header.TypeRefs);
+            ValidateTable<MetaRecord>(header.Meta);
+            ValidateTable<EnumValueRecord>(header.EnumValues);
+            ValidateTable<uint>(header.Indices);
+
+            void ValidateTable<T>(in TableRef table)
+                where T : unmanaged
+            {
+                if (table.Offset + (long) table.Count * sizeof(T) > m_length)
+                    throw new InvalidDataException($"Metadata database {path} is truncated.");
+            }
+        }
+
+        #endregion
+
+        #region File Layout
+
+        // ReSharper disable NotAccessedField.Global
+        // ReSharper disable FieldCanBeMadeReadOnly.Global
+
+        internal enum TypeRefKind : uint
+        {
+            TypeName,
+            Property
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Range
+        {
+            public uint Start;
+            public uint Count;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct TableRef
+        {
+            public uint Offset;
+            public uint Count;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct StringRecord
+        {
+            public uint Offset;
+            public uint Length;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct MetaRecord
+        {
+            public uint Key;
+            public uint Value;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct TypeRefRecord
+        {
+            public TypeRefKind Kind;
+            public uint Property;
+            public uint Module;
+            public uint Name;
+            public uint CppName;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct EnumValueRecord
+        {
+            public long Value;
+            public uint Name;
+            public uint Padding;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct PropertyRecord
+        {
+            public ulong Flags;
+            public uint Name;
+            public uint RawType;
+            public uint PropertyType;
+            public Range Meta;
+            public int Offset;
+            public int ArrayDim;
+            public uint Type;
+            public Range GenericArguments;
+            public uint IsUnknown;
+            public uint Padding;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct FunctionRecord
+        {
+            public ulong Flags;
+            public uint Name;
+            public Range Meta;
+            public Range Parameters;
+            public uint Return;
+            public int ParmsSize;
+            public int ReturnValueOffset;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct TypeRecord
+        {
+            public ulong Flags;
+            public long MaxValue;
+            public uint Name;
+            public uint CppName;
+            public uint Module;
+            public Range Meta;
+            public uint Parent;
+            public int Size;
+            public Range Properties;
+            public Range Functions;
+            public Range Interfaces;
+            public Range EnumValues;
+            public byte Kind;
+            public byte EnumForm;
+            public byte IsFlags;
+            public fixed byte Padding[9];
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct ModuleRecord
+        {
+            public uint Name;
+            public uint LongName;
+            public uint Folder;
+            public uint File;
+            public uint PackageType;
+            public uint Padding;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Header
+        {
+            public uint Magic;
+            public uint Version;
+            public TableRef Strings;
+            public TableRef StringData;
+            public TableRef Types;
+            public TableRef Functions;
+            public TableRef Properties;
+            public TableRef TypeRefs;
+            public TableRef Meta;
+            public TableRef EnumValues;
+            public TableRef Indices;
+            public ModuleRecord Module;
+        }
+
+        // ReSharper restore FieldCanBeMadeReadOnly.Global
+        // ReSharper restore NotAccessedField.Global
+
+        #endregion
+    }
+}
@@ -0,0 +1,276 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using Unreal.NativeMetadata;
+using static Unreal.MetadataDatabase;
+using Range = Unreal.MetadataDatabase.Range;
+
+namespace Unreal
+{
+    /// <summary>
+    /// Managed counterpart of the native database writer, used to convert existing metadata to the binary format.
+    /// </summary>
+    public sealed unsafe class MetadataDatabaseWriter
+    {
+        private readonly ModuleRecord m_module;
+
+        private readonly List<StringRecord> m_strings = new();
+        private readonly List<byte> m_stringData = new();
+        private readonly Dictionary<string, uint> m_stringIndex = new();
+
+        private readonly List<TypeRecord> m_types = new();
+        private readonly List<FunctionRecord> m_functions = new();
+        private readonly List<PropertyRecord> m_properties = new();
+        private readonly List<TypeRefRecord> m_typeRefs = new();
+        private readonly List<MetaRecord> m_meta = new();
+        private readonly List<EnumValueRecord> m_enumValues = new();
+        private readonly List<uint> m_indices = new();
+
+        public MetadataDatabaseWriter(UEModule module)
+        {
+            // Index 0 is always the empty string.
+            AddString("");
+
+            m_module = new ModuleRecord
+            {
+                Name = AddString(module.Name),
+                LongName = AddString(module.LongName),
+                Folder = AddString(module.Folder),
+                File = AddString(module.File),
+                PackageType = (uint) module.PackageType
+            };
+        }
+
+        public void AddType(UEField type)
+        {
+            var index = m_types.Count;
+            m_types.Add(default);
+
+            var record = new TypeRecord
+            {
+                Kind = (byte) type.Kind,
+                Name = AddString(type.Name),
+                Module = AddString(type.Module),
+                Meta = AddMeta(type.Meta),
+                Parent = InvalidIndex
+            };
+
+            if (type is UEStruct @struct)
+            {
+                record.CppName = AddString(@struct.CppName);
+                record.Size = @struct.Size;
+
+                if (@struct.Parent != null)
+                    record.Parent = AddTypeName(@struct.Parent);
+
+                record.Properties = Reserve(m_properties, @struct.Properties.Count);
+                for (int i = 0; i < @struct.Properties.Count; ++i)
+                    WriteProperty(record.Properties.Start + (uint) i, @struct.Properties[i]);
+            }
+
+            if (type is UEClass @class)
+            {
+                record.Flags = (ulong) @class.Flags;
+
+                record.Functions = Reserve(m_functions, @class.Functions.Count);
+                for (int i = 0; i < @class.Functions.Count; ++i)
+                    WriteFunction(record.Functions.Start + (uint) i, @class.Functions[i]);
+
+                record.Interfaces = new Range {Start = (uint) m_indices.Count, Count = (uint) @class.Interfaces.Count};
+                foreach (var @interface in @class.Interfaces)
+                    m_indices.Add(AddString(@interface));
+            }
+            else if (type is UEEnum @enum)
+            {
+                record.CppName = AddString(@enum.CppName);
+                record.MaxValue = @enum.MaxValue;
+                record.EnumForm = (byte) @enum.Form;
+                record.IsFlags = @enum.IsFlags ? (byte) 1 : (byte) 0;
+
+                record.EnumValues = new Range {Start = (uint) m_enumValues.Count, Count = (uint) @enum.Values.Count};
+                foreach (var value in @enum.Values)
+                    m_enumValues.Add(new EnumValueRecord {Name = AddString(value.Name), Value = value.Value});
+            }
+
+            m_types[index] = record;
+        }
+
+        /// <summary>
+        /// Write the database to a stream.
+        /// </summary>
+        /// <param name="stream"></param>
+        public void Write(Stream stream)
+        {
+            var output = new MemoryStream();
+            var header = new Header {Magic = MetadataDatabase.Magic, Version = MetadataDatabase.Version, Module = m_module};
+
+            output.SetLength(sizeof(Header));
+            output.Position = output.Length;
+
+            header.Strings = AppendTable(output, m_strings);
+            header.Types = AppendTable(output, m_types);
+            header.Functions = AppendTable(output, m_functions);
+            header.Properties = AppendTable(output, m_properties);
+            header.TypeRefs = AppendTable(output, m_typeRefs);
+            header.Meta = AppendTable(output, m_meta);
+            header.EnumValues = AppendTable(output, m_enumValues);
+            header.Indices = AppendTable(output, m_indices);
+            header.StringData = AppendTable(output, m_stringData);
+
+            output.Position = 0;
+            WriteRecord(output, header);
+
+            output.Position = 0;
+            output.CopyTo(stream);
+        }
+
+        public byte[] ToArray()
+        {
+            var stream = new MemoryStream();
+            Write(stream);
+            return stream.ToArray();
+        }
+
+        private uint AddString(string value)
+        {
+            if (m_stringIndex.TryGetValue(value, out var existing))
+                return existing;
+
+            var bytes = Encoding.UTF8.GetBytes(value);
+
+            var index = (uint) m_strings.Count;
+            m_strings.Add(new StringRecord {Offset = (uint) m_stringData.Count, Length = (uint) bytes.Length});
+            m_stringData.AddRange(bytes);
+            m_stringIndex.Add(value, index);
+
+            return index;
+        }
+
+        private Range AddMeta(Dictionary<string, string> meta)
+        {
+            var range = new Range {Start = (uint) m_meta.Count, Count = (uint) meta.Count};
+
+            foreach (var pair in meta)
+                m_meta.Add(new MetaRecord {Key = AddString(pair.Key), Value = AddString(pair.Value)});
+
+            return range;
+        }
+
+        private uint AddTypeName(TypeNameReference reference)
+        {
+            m_typeRefs.Add(CreateTypeName(reference));
+            return (uint) m_typeRefs.Count - 1;
+        }
+
+        private TypeRefRecord CreateTypeName(TypeNameReference reference)
+        {
+            return new()
+            {
+                Kind = TypeRefKind.TypeName,
+                Property = InvalidIndex,
+                Module = AddString(reference.Module ?? ""),
+                Name = AddString(reference.Name ?? ""),
+                CppName = AddString(reference.CppName ?? "")
+            };
+        }
+
+        private uint AddProperty(UEProperty property)
+        {
+            var index = (uint) m_properties.Count;
+            m_properties.Add(default);
+            WriteProperty(index, property);
+            return index;
+        }
+
+        private void WriteProperty(uint index, UEProperty property)
+        {
+            var record = new PropertyRecord
+            {
+                Flags = (ulong) property.Flags,
+                Name = AddString(property.Name ?? ""),
+                RawType = AddString(property.RawType ?? ""),
+                PropertyType = AddString(property.PropertyType),
+                Meta = AddMeta(property.Meta),
+                Offset = property.Offset,
+                ArrayDim = property.ArrayDim,
+                Type = property.Type != null ? AddTypeName(property.Type) : InvalidIndex,
+                IsUnknown = property.IsUnknown ? 1u : 0u
+            };
+
+            // Reserve the argument range first so it stays contiguous when arguments contain generic arguments themselves.
+            record.GenericArguments = Reserve(m_typeRefs, property.GenericTypeParameters.Count);
+            for (int i = 0; i < property.GenericTypeParameters.Count; ++i)
+            {
+                m_typeRefs[(int) record.GenericArguments.Start + i] = property.GenericTypeParameters[i] switch
+                {
+                    TypePropertyReference reference => new TypeRefRecord
+                    {
+                        Kind = TypeRefKind.Property,
+                        Property = AddProperty(reference.Property)
+                    },
+                    TypeNameReference reference => CreateTypeName(reference),
+                    var other => throw new ArgumentException($"Unsupported type reference {other.GetType()}.")
+                };
+            }
+
+            m_properties[(int) index] = record;
+        }
+
+        private void WriteFunction(uint index, UEFunction function)
+        {
+            var record = new FunctionRecord
+            {
+                Flags = (ulong) function.Flags,
+                Name = AddString(function.Name),
+                Meta = AddMeta(function.Meta),
+                Parameters = Reserve(m_properties, function.Parameters.Count),
+                ParmsSize = function.ParmsSize,
+                ReturnValueOffset = function.ReturnValueOffset,
+            };
+
+            for (int i = 0; i < function.Parameters.Count; ++i)
+                WriteProperty(record.Parameters.Start + (uint) i, function.Parameters[i]);
+
+            record.Return = function.Return != null ? AddProperty(function.Return) : InvalidIndex;
+
+            m_functions[(int) index] = record;
+        }
+
+        private static Range Reserve<T>(List<T> table, int count)
+            where T : struct
+        {
+            var range = new Range {Start = (uint) table.Count, Count = (uint) count};
+            for (int i = 0; i < count; ++i)
+                table.Add(default);
+
+            return range;
+        }
+
+        private static TableRef AppendTable<T>(MemoryStream output, List<T> table)
+            where T : unmanaged
+        {
+            // Keep every table 8 byte aligned so records can be read in place.
+            output.SetLength((output.Length + 7) & ~7L);
+            output.Position = output.Length;
+
+            var reference = new TableRef {Offset = (uint) output.Position, Count = (uint) table.Count};
+
+            foreach (var record in table)
+                WriteRecord(output, record);
+
+            return reference;
+        }
+
+        private static unsafe void WriteRecord<T>(MemoryStream output, T record)
+            where T : unmanaged
+        {
+            var bytes = (byte*) &record;
+            for (int i = 0; i < sizeof(T); ++i)
+                output.WriteByte(bytes[i]);
+        }
+    }
+}
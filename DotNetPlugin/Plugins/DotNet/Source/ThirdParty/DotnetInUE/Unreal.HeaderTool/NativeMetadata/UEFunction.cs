@@ -12,6 +12,16 @@ namespace Unreal.NativeMetadata
         public UEProperty? Return { get; set; }
         public List<UEProperty> Parameters { get; set; } = new();
 
+        /// <summary>
+        /// Size of the parameter frame used to invoke the function through reflection.
+        /// </summary>
+        public int ParmsSize { get; set; }
+
+        /// <summary>
+        /// Offset of the return value in the parameter frame, -1 if the function does not return a value.
+        /// </summary>
+        public int ReturnValueOffset { get; set; } = -1;
+
         [JsonIgnore]
         public UEClass Class { get; set; }
 
@@ -0,0 +1,703 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+// Stand-in for the engine side of the bindings, so the managed runtime can be exercised headless.
+//
+// Exports the same C ABI as NativeHelper.cpp and Bindings.cpp in the DotNet plugin, backed by minimal objects that
+// only reproduce the parts of the UObject layout the managed runtime reads. Objects live in a chunked array with
+// serial numbers like GUObjectArray, so lifetime code sees indices being reused. The StandIn_* thunks have the same
+// shape as the ones the generator writes for each kind of marshalled parameter. Parts of the plugin that do not depend
+// on the engine, like the event ring and the frame arena, are included from the plugin sources rather than copied.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Engine-independent parts of the plugin, built as they ship.
+#include "DotNetEventRing.h"
+#include "DotNetThreadArena.h"
+
+#if defined(_WIN32)
+#define STANDIN_API extern "C" __declspec(dllexport)
+#else
+#define STANDIN_API extern "C" __attribute__((visibility("default")))
+#endif
+
+using int32 = int32_t;
+using int64 = int64_t;
+using uint8 = uint8_t;
+using uint64 = uint64_t;
+using UCS2CHAR = char16_t;
+
+struct UClass;
+
+struct FManagedObject
+{
+	void* Handle = nullptr;
+};
+
+struct UObject
+{
+	void* VTable = nullptr;
+	int32 ObjectFlags = 0;
+	int32 InternalIndex = -1;
+	UClass* ClassPrivate = nullptr;
+	void* NamePrivate = nullptr;
+	UObject* OuterPrivate = nullptr;
+
+	// Only used by objects of managed classes, stands in for IManagedObject.
+	FManagedObject Managed;
+};
+
+struct UClass : UObject
+{
+	std::u16string Name;
+	UClass* SuperClass = nullptr;
+	bool bManaged = false;
+};
+
+struct FVector
+{
+	float X, Y, Z;
+};
+
+namespace
+{
+	/** Slot of the object array, see FUObjectItem. */
+	struct FObjectItem
+	{
+		std::atomic<UObject*> Object{nullptr};
+		std::atomic<int32> Flags{0};
+		std::atomic<int32> SerialNumber{0};
+	};
+
+	/** Flag of objects marked for destruction, see EInternalObjectFlags::PendingKill. */
+	constexpr int32 PendingKillFlag = 1 << 29;
+
+	/**
+	 * Array of all live objects, see FChunkedFixedUObjectArray. Chunks are never moved or freed, so slots can be read
+	 * without a lock while other threads create objects.
+	 */
+	class FObjectArray
+	{
+	public:
+		static constexpr int32 ChunkSize = 64 * 1024;
+		static constexpr int32 MaxChunks = 1024;
+
+		~FObjectArray()
+		{
+			for (auto& Chunk : Chunks)
+				delete[] Chunk.load();
+		}
+
+		FObjectItem* IndexToItem(int32 Index) const
+		{
+			if (Index < 0 || Index >= ChunkSize * MaxChunks)
+				return nullptr;
+
+			FObjectItem* Chunk = Chunks[Index / ChunkSize].load(std::memory_order_acquire);
+			return Chunk ? &Chunk[Index % ChunkSize] : nullptr;
+		}
+
+		bool Add(UObject* Object)
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+
+			int32 Index;
+			if (!FreeIndices.empty())
+			{
+				Index = FreeIndices.back();
+				FreeIndices.pop_back();
+			}
+			else
+			{
+				if (Count == ChunkSize * MaxChunks)
+					return false;
+
+				Index = Count++;
+				auto& Chunk = Chunks[Index / ChunkSize];
+				if (!Chunk.load(std::memory_order_relaxed))
+					Chunk.store(new FObjectItem[ChunkSize], std::memory_order_release);
+			}
+
+			Object->InternalIndex = Index;
+			IndexToItem(Index)->Object.store(Object, std::memory_order_release);
+			++Live;
+			return true;
+		}
+
+		void Remove(UObject* Object)
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+
+			FObjectItem* Item = IndexToItem(Object->InternalIndex);
+			Item->Object.store(nullptr, std::memory_order_release);
+			Item->Flags.store(0, std::memory_order_release);
+			Item->SerialNumber.store(0, std::memory_order_release);
+
+			FreeIndices.push_back(Object->InternalIndex);
+			--Live;
+		}
+
+		int32 AllocateSerialNumber(int32 Index)
+		{
+			FObjectItem* Item = IndexToItem(Index);
+
+			int32 SerialNumber = Item->SerialNumber.load(std::memory_order_acquire);
+			if (SerialNumber != 0)
+				return SerialNumber;
+
+			// Another thread may allocate one at the same time, keep whichever was stored first.
+			const int32 New = NextSerialNumber.fetch_add(1) + 1;
+			return Item->SerialNumber.compare_exchange_strong(SerialNumber, New) ? New : SerialNumber;
+		}
+
+		int32 GetLiveCount() const
+		{
+			return Live;
+		}
+
+		int32 GetSerialNumberCount() const
+		{
+			return NextSerialNumber;
+		}
+
+		const std::atomic<FObjectItem*>* GetChunks() const
+		{
+			return Chunks;
+		}
+
+	private:
+		std::atomic<FObjectItem*> Chunks[MaxChunks] = {};
+
+		std::mutex Mutex;
+		std::vector<int32> FreeIndices;
+		int32 Count = 0;
+		std::atomic<int32> Live{0};
+
+		std::atomic<int32> NextSerialNumber{0};
+	};
+
+	FObjectArray Objects;
+
+	std::mutex ClassesMutex;
+	std::vector<UClass*> Classes;
+
+	UClass* CreateClass(const UCS2CHAR* Name, UClass* SuperClass, bool bManaged)
+	{
+		UClass* Class = new UClass();
+		Class->Name = Name;
+		Class->SuperClass = SuperClass;
+		Class->bManaged = bManaged;
+		Class->ClassPrivate = Classes.empty() ? Class : Classes.front();
+
+		if (!Objects.Add(Class))
+		{
+			delete Class;
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> Lock(ClassesMutex);
+		Classes.push_back(Class);
+		return Class;
+	}
+
+	struct FInit
+	{
+		FInit()
+		{
+			// Must be first, it is the class of classes.
+			UClass* ObjectClass = CreateClass(u"Object", nullptr, false);
+			UClass* StandInObjectClass = CreateClass(u"StandInObject", ObjectClass, false);
+			CreateClass(u"StandInManagedObject", StandInObjectClass, true);
+		}
+	} Init;
+}
+
+// NativeHelper.cpp
+// ================
+
+STANDIN_API FManagedObject* NativeHelper_Cast_UObject_IManagedObject(UObject* Object)
+{
+	return Object->ClassPrivate->bManaged ? &Object->Managed : nullptr;
+}
+
+STANDIN_API size_t UObject_GetFieldOffset_UClass()
+{
+	return offsetof(UObject, ClassPrivate);
+}
+
+STANDIN_API UClass* UClass_GetSuperClass(UClass* Class)
+{
+	return Class->SuperClass;
+}
+
+STANDIN_API UObject* UClass_Find(const UCS2CHAR* PackageName, const UCS2CHAR* ClassName)
+{
+	std::lock_guard<std::mutex> Lock(ClassesMutex);
+
+	for (UClass* Class : Classes)
+	{
+		if (Class->Name == ClassName)
+			return Class;
+	}
+
+	return nullptr;
+}
+
+STANDIN_API size_t IManagedObject_GetFieldOffset_Handle()
+{
+	return offsetof(FManagedObject, Handle);
+}
+
+STANDIN_API UObject* NativeHelper_CreateUObject(UClass* Class, UObject* Outer)
+{
+	UObject* Object = new UObject();
+	Object->ClassPrivate = Class;
+	Object->OuterPrivate = Outer;
+
+	if (!Objects.Add(Object))
+	{
+		delete Object;
+		return nullptr;
+	}
+
+	return Object;
+}
+
+STANDIN_API int32 NativeHelper_GetObjectSerialNumber(UObject* Object, int32* OutIndex)
+{
+	*OutIndex = Object->InternalIndex;
+	return Objects.AllocateSerialNumber(Object->InternalIndex);
+}
+
+struct FObjectArrayLayout
+{
+	const void* Chunks;
+	int32 ElementsPerChunk;
+	int32 MaxElements;
+	int32 ItemSize;
+	int32 ObjectOffset;
+	int32 FlagsOffset;
+	int32 SerialNumberOffset;
+	int32 DeadFlags;
+	int32 InternalIndexOffset;
+};
+
+STANDIN_API FObjectItem* NativeHelper_GetObjectItem(int32 Index)
+{
+	return Objects.IndexToItem(Index);
+}
+
+STANDIN_API void NativeHelper_GetObjectArrayLayout(FObjectArrayLayout* OutLayout)
+{
+	OutLayout->Chunks = Objects.GetChunks();
+	OutLayout->ElementsPerChunk = FObjectArray::ChunkSize;
+	OutLayout->MaxElements = FObjectArray::ChunkSize * FObjectArray::MaxChunks;
+	OutLayout->ItemSize = sizeof(FObjectItem);
+	OutLayout->ObjectOffset = offsetof(FObjectItem, Object);
+	OutLayout->FlagsOffset = offsetof(FObjectItem, Flags);
+	OutLayout->SerialNumberOffset = offsetof(FObjectItem, SerialNumber);
+	OutLayout->DeadFlags = PendingKillFlag;
+	OutLayout->InternalIndexOffset = offsetof(UObject, InternalIndex);
+}
+
+// Bindings.cpp
+// ============
+
+/** Messages logged by managed code, kept for the tests to check. */
+struct FLog
+{
+	std::mutex Mutex;
+	std::vector<std::pair<uint8, std::u16string>> Messages;
+	int32 Batches = 0;
+	uint8 Verbosity = 5; // ELogVerbosity::Log
+};
+
+static FLog Log;
+
+STANDIN_API void UeLog_Log(uint8 Verbosity, const UCS2CHAR* Msg)
+{
+	std::lock_guard<std::mutex> Lock(Log.Mutex);
+	Log.Messages.emplace_back(Verbosity, Msg);
+}
+
+STANDIN_API void UeLog_LogBatch(int32 Count, const uint8* Verbosities, const UCS2CHAR* Messages)
+{
+	std::lock_guard<std::mutex> Lock(Log.Mutex);
+	++Log.Batches;
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Log.Messages.emplace_back(Verbosities[i], Messages);
+		Messages += Log.Messages.back().second.size() + 1;
+	}
+}
+
+STANDIN_API const uint8* UeLog_GetVerbosity()
+{
+	return &Log.Verbosity;
+}
+
+/** Change the verbosity of the log category, like the log console command does. */
+STANDIN_API void StandIn_SetLogVerbosity(uint8 Verbosity)
+{
+	Log.Verbosity = Verbosity;
+}
+
+/** Number of log batches submitted so far. */
+STANDIN_API int32 StandIn_GetLogBatchCount()
+{
+	std::lock_guard<std::mutex> Lock(Log.Mutex);
+	return Log.Batches;
+}
+
+/** Number of messages logged so far. */
+STANDIN_API int32 StandIn_GetLogCount()
+{
+	std::lock_guard<std::mutex> Lock(Log.Mutex);
+	return static_cast<int32>(Log.Messages.size());
+}
+
+/** A logged message, valid until the next message is logged. */
+STANDIN_API const UCS2CHAR* StandIn_GetLog(int32 Index, uint8* OutVerbosity)
+{
+	std::lock_guard<std::mutex> Lock(Log.Mutex);
+	*OutVerbosity = Log.Messages[Index].first;
+	return Log.Messages[Index].second.c_str();
+}
+
+// DotNetScheduling.cpp
+// ====================
+
+/** Stands in for the workers of the task graph. */
+class FWorkerPool
+{
+public:
+	using FTask = std::pair<void (*)(void*), void*>;
+
+	FWorkerPool()
+	{
+		const unsigned NumWorkers = std::max(2u, std::thread::hardware_concurrency());
+		for (unsigned i = 0; i < NumWorkers; ++i)
+			std::thread(&FWorkerPool::Run, this).detach();
+	}
+
+	void Dispatch(const FTask Task)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			Tasks.push_back(Task);
+		}
+		Ready.notify_one();
+	}
+
+	static thread_local bool bIsWorker;
+
+private:
+	void Run()
+	{
+		bIsWorker = true;
+
+		for (;;)
+		{
+			FTask Task;
+			{
+				std::unique_lock<std::mutex> Lock(Mutex);
+				Ready.wait(Lock, [this] { return !Tasks.empty(); });
+				Task = Tasks.front();
+				Tasks.pop_front();
+			}
+
+			Task.first(Task.second);
+		}
+	}
+
+	std::mutex Mutex;
+	std::condition_variable Ready;
+	std::deque<FTask> Tasks;
+};
+
+thread_local bool FWorkerPool::bIsWorker = false;
+
+STANDIN_API void TaskGraph_Dispatch(void (*Execute)(void*), void* Task)
+{
+	// Workers are never joined, like the task graph they live until the process exits.
+	static FWorkerPool* Workers = new FWorkerPool();
+	Workers->Dispatch({Execute, Task});
+}
+
+/** Whether the calling thread is one of the stand-in workers. */
+STANDIN_API bool StandIn_IsWorkerThread()
+{
+	return FWorkerPool::bIsWorker;
+}
+
+// DotNetFrameArena.cpp
+// ====================
+
+static std::atomic<uint64> ArenaFrame{1};
+
+/** Chunks and oversized blocks taken from the system allocator. */
+static std::atomic<int32> ArenaMallocs{0};
+
+/** Memory of the thread arenas, counting every trip to the system allocator. */
+struct FArenaMemory
+{
+	static constexpr int64 ChunkSize = 256 * 1024;
+	static constexpr int64 MaxChunkAllocation = ChunkSize / 4;
+
+	static void* AllocateChunk()
+	{
+		++ArenaMallocs;
+		return std::aligned_alloc(64, ChunkSize);
+	}
+
+	static void FreeChunk(void* Chunk)
+	{
+		std::free(Chunk);
+	}
+
+	static void* AllocateLarge(const int64 Size, int32)
+	{
+		++ArenaMallocs;
+		return std::aligned_alloc(64, (Size + 63) & ~int64(63));
+	}
+
+	static void FreeLarge(void* Allocation)
+	{
+		std::free(Allocation);
+	}
+};
+
+STANDIN_API void* FrameArena_Allocate(int64 Size, int32 Alignment)
+{
+	static thread_local TDotNetThreadArena<FArenaMemory> Arena;
+	return Arena.Allocate(Size, Alignment, ArenaFrame.load(std::memory_order_relaxed));
+}
+
+STANDIN_API const uint64* FrameArena_GetFrame()
+{
+	return reinterpret_cast<const uint64*>(&ArenaFrame);
+}
+
+/** End the frame, like FCoreDelegates::OnEndFrame. */
+STANDIN_API void StandIn_EndFrame()
+{
+	++ArenaFrame;
+}
+
+/** Number of times the frame arenas went to the system allocator. */
+STANDIN_API int32 StandIn_GetFrameArenaMallocs()
+{
+	return ArenaMallocs;
+}
+
+// DotNetEventQueue.cpp
+// ====================
+
+struct FEventRecord
+{
+	static constexpr int32 MaxPayloadSize = 56;
+
+	int32 Type;
+	int32 Size;
+	alignas(8) uint8 Payload[MaxPayloadSize];
+};
+
+static_assert(sizeof(FEventRecord) == 64, "Event records must match the layout of NativeEvent.");
+
+static constexpr int32 EventQueueCapacity = 8192;
+
+/** The ring of FDotNetEventQueue, with it's capacity. */
+using FEventRing = TDotNetEventRing<FEventRecord, EventQueueCapacity>;
+
+static FEventRing* const EventRing = new FEventRing();
+
+static std::atomic<int32> EventsDropped{0};
+
+static int32 EventQueueHighWater = 0;
+
+/** Queue an event from any thread, like FDotNetEventQueue::Enqueue. */
+STANDIN_API bool StandIn_EnqueueEvent(int32 Type, const void* Payload, int32 Size)
+{
+	if (!EventRing->Enqueue(Type, Payload, Size))
+	{
+		EventsDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Hand the queued events to a dispatch function in a single call, like FDotNetEventQueue::Drain.
+ * @return Number of events dispatched, the events dropped since the last drain are written to OutDropped.
+ */
+STANDIN_API int32 StandIn_DrainEvents(void (*Dispatch)(const FEventRecord*, int32), int32* OutDropped)
+{
+	static std::vector<FEventRecord> Buffer(EventQueueCapacity);
+
+	*OutDropped = EventsDropped.exchange(0, std::memory_order_relaxed);
+
+	const int32 Count = EventRing->Dequeue(Buffer.data(), EventQueueCapacity);
+	EventQueueHighWater = std::max(EventQueueHighWater, Count);
+
+	if (Count > 0)
+		Dispatch(Buffer.data(), Count);
+
+	return Count;
+}
+
+/** Most events drained at once. */
+STANDIN_API int32 StandIn_GetEventQueueHighWater()
+{
+	return EventQueueHighWater;
+}
+
+// Thunks
+// ======
+
+/** Primitives are passed as is. */
+STANDIN_API int32 StandIn_AddInts(UObject* Self, int32 A, int32 B)
+{
+	return A + B;
+}
+
+/** Structs are passed by pointer. */
+STANDIN_API float StandIn_LengthSquared(UObject* Self, FVector* Vector)
+{
+	return Vector->X * Vector->X + Vector->Y * Vector->Y + Vector->Z * Vector->Z;
+}
+
+/** Returned structs are inverted into a trailing pointer. */
+STANDIN_API void StandIn_MakeVector(UObject* Self, float X, float Y, float Z, FVector* Return)
+{
+	*Return = FVector{X, Y, Z};
+}
+
+/** Objects of native classes, wrapped on the managed side. */
+STANDIN_API UObject* StandIn_EchoObject(UObject* Self, UObject* Object)
+{
+	return Object;
+}
+
+/** Objects of managed classes, resolved through their handle on the managed side. */
+STANDIN_API UObject* StandIn_EchoManagedObject(UObject* Self, UObject* Object)
+{
+	return Object;
+}
+
+/** TSubclassOf is passed as the class pointer. */
+STANDIN_API UClass* StandIn_GetSuperClass(UObject* Self, UClass* Class)
+{
+	return Class->SuperClass ? Class->SuperClass : Class;
+}
+
+/** Out parameters are passed by pointer. */
+STANDIN_API int32 StandIn_Divide(UObject* Self, int32 A, int32 B, int32* Remainder)
+{
+	*Remainder = A % B;
+	return A / B;
+}
+
+/** Empty call, the cost of the transition alone. */
+STANDIN_API void StandIn_Nop()
+{ }
+
+// Module
+// ======
+
+/** Create a class, classes are never destroyed. */
+STANDIN_API UClass* StandIn_CreateClass(const UCS2CHAR* Name, UClass* SuperClass, bool bManaged)
+{
+	return CreateClass(Name, SuperClass, bManaged);
+}
+
+/** Destroy an object, like the garbage collector would. The managed handle must have been released already. */
+STANDIN_API void StandIn_DestroyObject(UObject* Object)
+{
+	Objects.Remove(Object);
+	delete Object;
+}
+
+/** Mark an object for destruction, like MarkPendingKill. */
+STANDIN_API void StandIn_MarkPendingKill(UObject* Object)
+{
+	Objects.IndexToItem(Object->InternalIndex)->Flags.fetch_or(PendingKillFlag);
+}
+
+/** Number of serial numbers allocated so far. */
+STANDIN_API int32 StandIn_GetSerialNumberCount()
+{
+	return Objects.GetSerialNumberCount();
+}
+
+/** Number of objects alive, including classes. */
+STANDIN_API int32 StandIn_GetObjectCount()
+{
+	return Objects.GetLiveCount();
+}
+
+/** Set the managed handle of an object of a managed class, done by the generated constructor in the plugin. */
+STANDIN_API void StandIn_SetManagedHandle(UObject* Object, void* Handle)
+{
+	Object->Managed.Handle = Handle;
+}
+
+/** Entry point getter handed to the managed runtime, like the one of FDotNetModule. */
+STANDIN_API void* StandIn_GetEntryPoint(const UCS2CHAR* Name)
+{
+	struct FEntry
+	{
+		const UCS2CHAR* Name;
+		void* Function;
+	};
+
+#define ENTRY(Name) {u## #Name, reinterpret_cast<void*>(&Name)}
+	static const FEntry Entries[] = {
+		ENTRY(NativeHelper_Cast_UObject_IManagedObject),
+		ENTRY(UObject_GetFieldOffset_UClass),
+		ENTRY(UClass_GetSuperClass),
+		ENTRY(UClass_Find),
+		ENTRY(IManagedObject_GetFieldOffset_Handle),
+		ENTRY(NativeHelper_CreateUObject),
+		ENTRY(NativeHelper_GetObjectSerialNumber),
+		ENTRY(NativeHelper_GetObjectItem),
+		ENTRY(NativeHelper_GetObjectArrayLayout),
+		ENTRY(UeLog_Log),
+		ENTRY(UeLog_LogBatch),
+		ENTRY(UeLog_GetVerbosity),
+		ENTRY(TaskGraph_Dispatch),
+		ENTRY(FrameArena_Allocate),
+		ENTRY(FrameArena_GetFrame),
+		ENTRY(StandIn_AddInts),
+		ENTRY(StandIn_LengthSquared),
+		ENTRY(StandIn_MakeVector),
+		ENTRY(StandIn_EchoObject),
+		ENTRY(StandIn_EchoManagedObject),
+		ENTRY(StandIn_GetSuperClass),
+		ENTRY(StandIn_Divide),
+		ENTRY(StandIn_Nop),
+	};
+#undef ENTRY
+
+	for (const FEntry& Entry : Entries)
+	{
+		if (std::u16string_view(Entry.Name) == Name)
+			return Entry.Function;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+using Unreal.Core;
+using Xunit;
+
+namespace Unreal.Tests
+{
+    /// <summary>
+    /// Headless stand-in for the plugin exports the managed runtime depends on, see Native/BindingStandIn.cpp.
+    /// </summary>
+    /// <remarks>
+    /// The library is built with the tests on Linux only. Tests that need it are marked with
+    /// <see cref="StandInFactAttribute"/> and belong to the <see cref="StandInCollection"/>.
+    /// </remarks>
+    internal static unsafe class StandInRuntime
+    {
+        internal const string LibraryFileName = "libUnrealBindingStandIn.so";
+
+        private static readonly IntPtr Library = Load();
+
+        // ReSharper disable InconsistentNaming
+        private static readonly delegate* unmanaged<char*, IntPtr, byte, IntPtr> StandIn_CreateClass =
+            (delegate* unmanaged<char*, IntPtr, byte, IntPtr>) GetExport("StandIn_CreateClass");
+
+        private static readonly delegate* unmanaged<IntPtr, void> StandIn_DestroyObject =
+            (delegate* unmanaged<IntPtr, void>) GetExport("StandIn_DestroyObject");
+
+        private static readonly delegate* unmanaged<int> StandIn_GetObjectCount =
+            (delegate* unmanaged<int>) GetExport("StandIn_GetObjectCount");
+
+        private static readonly delegate* unmanaged<IntPtr, void> StandIn_MarkPendingKill =
+            (delegate* unmanaged<IntPtr, void>) GetExport("StandIn_MarkPendingKill");
+
+        private static readonly delegate* unmanaged<int> StandIn_GetSerialNumberCount =
+            (delegate* unmanaged<int>) GetExport("StandIn_GetSerialNumberCount");
+
+        private static readonly delegate* unmanaged<IntPtr, IntPtr, void> StandIn_SetManagedHandle =
+            (delegate* unmanaged<IntPtr, IntPtr, void>) GetExport("StandIn_SetManagedHandle");
+
+        private static readonly delegate* unmanaged<char*, char*, IntPtr> UClass_Find =
+            (delegate* unmanaged<char*, char*, IntPtr>) GetExport("UClass_Find");
+
+        private static readonly delegate* unmanaged<IntPtr, IntPtr, IntPtr> NativeHelper_CreateUObject =
+            (delegate* unmanaged<IntPtr, IntPtr, IntPtr>) GetExport("NativeHelper_CreateUObject");
+        // ReSharper restore InconsistentNaming
+
+        /// <summary>
+        /// Load the library and route the plugin functions of the runtime to it.
+        /// </summary>
+        private static IntPtr Load()
+        {
+            var path = Path.Combine(AppContext.BaseDirectory, LibraryFileName);
+            if (!NativeLibrary.TryLoad(path, out var library))
+                return IntPtr.Zero;
+
+            NativeHelpers.Init(
+                (delegate* unmanaged<char*, void*>) NativeLibrary.GetExport(library, "StandIn_GetEntryPoint"));
+
+            return library;
+        }
+
+        private static IntPtr GetExport(string name)
+        {
+            return Library == IntPtr.Zero ? IntPtr.Zero : NativeLibrary.GetExport(Library, name);
+        }
+
+        /// <summary>
+        /// Get an export of the library.
+        /// </summary>
+        /// <param name="name"></param>
+        /// <returns></returns>
+        public static void* GetFunction(string name)
+        {
+            return (void*) NativeLibrary.GetExport(Library, name);
+        }
+
+        /// <summary>
+        /// Number of native objects alive, including classes.
+        /// </summary>
+        public static int ObjectCount => StandIn_GetObjectCount();
+
+        /// <summary>
+        /// Number of serial numbers allocated so far.
+        /// </summary>
+        public static int SerialNumberCount => StandIn_GetSerialNumberCount();
+
+        /// <summary>
+        /// Find a class by name.
+        /// </summary>
+        /// <param name="name"></param>
+        /// <returns></returns>
+        public static IntPtr FindClass(string name)
+        {
+            fixed (char* chars = name)
+                return UClass_Find(null, chars);
+        }
+
+        /// <summary>
+        /// Create a native class, classes are never destroyed.
+        /// </summary>
+        /// <param name="name">Name of the class, should be unique since the classes are shared by all tests.</param>
+        /// <param name="superClass">The parent class, or zero for none.</param>
+        /// <param name="isManaged">Whether objects of the class implement IManagedObject.</param>
+        /// <returns></returns>
+        public static IntPtr CreateClass(string name, IntPtr superClass, bool isManaged = false)
+        {
+            fixed (char* chars = name)
+                return StandIn_CreateClass(chars, superClass, (byte) (isManaged ? 1 : 0));
+        }
+
+        /// <summary>
+        /// Create a native object without a managed counterpart.
+        /// </summary>
+        /// <param name="nativeClass"></param>
+        /// <returns></returns>
+        public static IntPtr CreateObject(IntPtr nativeClass)
+        {
+            return NativeHelper_CreateUObject(nativeClass, IntPtr.Zero);
+        }
+
+        /// <summary>
+        /// Create a native object of a managed class along with it's managed counterpart, the way the plugin does.
+        /// </summary>
+        /// <param name="nativeClass"></param>
+        /// <param name="factory">Constructor of the managed object.</param>
+        /// <typeparam name="TObject"></typeparam>
+        /// <returns></returns>
+        public static TObject CreateManagedObject<TObject>(IntPtr nativeClass, Func<IntPtr, TObject> factory)
+            where TObject : UObjectBase
+        {
+            var nativeInstance = CreateObject(nativeClass);
+            var managed = factory(nativeInstance);
+            StandIn_SetManagedHandle(nativeInstance, GCHandle.ToIntPtr(GCHandle.Alloc(managed)));
+
+            return managed;
+        }
+
+        /// <summary>
+        /// Mark a native object for destruction, like MarkPendingKill.
+        /// </summary>
+        /// <param name="nativeInstance"></param>
+        public static void MarkPendingKill(IntPtr nativeInstance)
+        {
+            StandIn_MarkPendingKill(nativeInstance);
+        }
+
+        /// <summary>
+        /// Destroy a native object, like the garbage collector would. Any managed counterpart must have been
+        /// unregistered already.
+        /// </summary>
+        /// <param name="nativeInstance"></param>
+        public static void DestroyObject(IntPtr nativeInstance)
+        {
+            StandIn_DestroyObject(nativeInstance);
+        }
+    }
+
+    /// <summary>
+    /// Test that runs against the stand-in library, skipped when the library was not built for this platform.
+    /// </summary>
+    /// <remarks>Only looks for the file, so discovering the tests does not load the library.</remarks>
+    public sealed class StandInFactAttribute : FactAttribute
+    {
+        public StandInFactAttribute()
+        {
+            if (!File.Exists(Path.Combine(AppContext.BaseDirectory, StandInRuntime.LibraryFileName)))
+                Skip = "The stand-in library was not built for this platform.";
+        }
+    }
+
+    /// <summary>
+    /// Tests that share the runtime globals the stand-in is plugged into, like the type registry and the native helper
+    /// functions, and assert on the state of the stand-in. They are not run in parallel with any other test.
+    /// </summary>
+    [CollectionDefinition(Name, DisableParallelization = true)]
+    public class StandInCollection
+    {
+        public const string Name = "StandIn";
+    }
+}
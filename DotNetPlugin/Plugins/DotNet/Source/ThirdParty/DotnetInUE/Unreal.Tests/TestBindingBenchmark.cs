@@ -0,0 +1,318 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Unreal.Core;
+using Unreal.Generation;
+using Unreal.Marshalling;
+using Unreal.Metadata;
+using Xunit;
+using Xunit.Abstractions;
+using Module = Unreal.Generation.Module;
+using TypeKind = Unreal.Metadata.TypeKind;
+
+namespace Unreal.Tests
+{
+    /// <summary>
+    /// Cost of managed to native calls through generated bindings, measured against a native library that stands in
+    /// for the engine (Native/BindingStandIn.cpp).
+    /// </summary>
+    /// <remarks>
+    /// The bindings are written by the generator and compiled on the fly, so the numbers follow any change to the
+    /// marshalling code. The stand-in library is only built with the tests on Linux, elsewhere the benchmark is
+    /// skipped.
+    /// </remarks>
+    [Collection(StandInCollection.Name)]
+    public class TestBindingBenchmark
+    {
+        private const int Iterations = 1000000;
+
+        private static readonly Module Module = new("StandIn");
+
+        private readonly ITestOutputHelper m_output;
+
+        public TestBindingBenchmark(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        #region Bindings
+
+        /// <summary>
+        /// Handwritten parts of the benchmark module, the generated methods are added to these types.
+        /// </summary>
+        private const string ModuleSource = @"
+using System;
+using System.Diagnostics;
+using Unreal.Core;
+
+namespace Unreal.Bench
+{
+    internal static class ModuleHelper
+    {
+        public static unsafe void* GetFunction(string functionName) => NativeHelpers.GetPluginFunction(functionName);
+    }
+
+    public struct FStandInVector
+    {
+        public float X, Y, Z;
+    }
+
+    public struct StandInSubclassOf
+    {
+        public readonly IntPtr ClassHandle;
+
+        public StandInSubclassOf(IntPtr classHandle)
+        {
+            ClassHandle = classHandle;
+        }
+    }
+
+    public partial class UStandInObject : UObjectBase
+    {
+        protected UStandInObject(IntPtr nativeInstance)
+            : base(nativeInstance)
+        { }
+    }
+
+    public partial class UStandInManagedObject : UStandInObject
+    {
+        protected UStandInManagedObject(IntPtr nativeInstance)
+            : base(nativeInstance)
+        { }
+    }
+
+    public static class Loops
+    {
+        public static void Nop(UStandInObject self, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                UStandInObject.Nop();
+        }
+
+        public static int Primitives(UStandInObject self, int count)
+        {
+            int result = 0;
+            for (int i = 0; i < count; ++i)
+                result = self.AddInts(result, 1);
+            return result;
+        }
+
+        public static float StructByReference(UStandInObject self, int count)
+        {
+            var vector = new FStandInVector {X = 1, Y = 2, Z = 3};
+            float result = 0;
+            for (int i = 0; i < count; ++i)
+                result += self.LengthSquared(vector);
+            return result;
+        }
+
+        public static float StructReturn(UStandInObject self, int count)
+        {
+            float result = 0;
+            for (int i = 0; i < count; ++i)
+                result += self.MakeVector(i, 1, 2).X;
+            return result;
+        }
+
+        public static UStandInObject? NativeObject(UStandInObject self, int count)
+        {
+            var result = self;
+            for (int i = 0; i < count; ++i)
+                result = self.EchoObject(result);
+            return result;
+        }
+
+        public static UStandInManagedObject? ManagedObject(UStandInObject self, UStandInManagedObject managed,
+            int count)
+        {
+            var result = managed;
+            for (int i = 0; i < count; ++i)
+                result = self.EchoManagedObject(result);
+            return result;
+        }
+
+        public static IntPtr SubclassOf(UStandInObject self, IntPtr classHandle, int count)
+        {
+            var result = new StandInSubclassOf(classHandle);
+            for (int i = 0; i < count; ++i)
+                result = self.GetSuperClass(result);
+            return result.ClassHandle;
+        }
+
+        public static int OutParameter(UStandInObject self, int count)
+        {
+            int result = 0;
+            for (int i = 0; i < count; ++i)
+                result += self.Divide(i, 7, out var remainder) + remainder;
+            return result;
+        }
+    }
+}";
+
+        private static TypeDefinition CreateClass(string name, ITypeMarshaller marshaller)
+        {
+            return TypeDefinition.CreateBuilder(Module, name)
+                .WithNamespace("Unreal.Bench")
+                .WithTypicalArgumentType(NativeTransferType.ByPointer)
+                .WithDefaultMarshaller(marshaller)
+                .Build();
+        }
+
+        private static string WriteBindings()
+        {
+            var nativeObject = CreateClass("UStandInObject", NativeUObjectMarshaller.Instance);
+            var managedObject = CreateClass("UStandInManagedObject", ManagedUObjectMarshaller.Instance);
+
+            var vector = TypeDefinition.CreateBuilder(Module, "FStandInVector")
+                .WithNamespace("Unreal.Bench")
+                .WithKind(TypeKind.Struct)
+                .WithDefaultMarshaller(PassByReferenceMarshaller.Instance)
+                .Build();
+
+            var subclassOf = TypeDefinition.CreateBuilder(Module, "StandInSubclassOf")
+                .WithNamespace("Unreal.Bench")
+                .WithKind(TypeKind.Struct)
+                .Build();
+
+            // Same formats as SubclassOf<T>.
+            var subclassOfMarshaller = new CustomTypeMarshaller(new MarshalFormats(
+                    fromManagedToIntermediate: "{0}.ClassHandle", fromIntermediateToManaged: "new ({0})",
+                    fromNativeToIntermediate: "{0}.Get()", fromIntermediateToNative: "{0}"),
+                ManagedTypeInfo.GetType<IntPtr>());
+
+            FunctionDefinitionBuilder Function(string name) => FunctionDefinition.CreateBuilder(nativeObject, name)
+                .WithEntryPointName($"StandIn_{name}");
+
+            var functions = new[]
+            {
+                Function("Nop").WithAttribute(SymbolAttribute.Static).Build(),
+                Function("AddInts").WithParameter<int>("a").WithParameter<int>("b").WithReturn<int>().Build(),
+                Function("LengthSquared").WithParameter("vector", vector).WithReturn<float>().Build(),
+                Function("MakeVector").WithParameter<float>("x").WithParameter<float>("y").WithParameter<float>("z")
+                    .WithReturn(vector).Build(),
+                Function("EchoObject").WithParameter("obj", nativeObject).WithReturn(nativeObject).Build(),
+                Function("EchoManagedObject").WithParameter("obj", managedObject).WithReturn(managedObject).Build(),
+                Function("GetSuperClass").WithParameter("cls", subclassOf, customMarshaller: subclassOfMarshaller)
+                    .WithReturn(subclassOf, customMarshaller: subclassOfMarshaller).Build(),
+                Function("Divide").WithParameter<int>("a").WithParameter<int>("b")
+                    .WithParameter<int>("remainder", ManagedTransferType.Out).WithReturn<int>().Build(),
+            };
+
+            var str = new StringWriter {NewLine = "\n"};
+            var writer = new CodeWriter(str);
+
+            writer.WriteLine("using System;");
+            writer.WriteLine("using Unreal.Core;");
+            writer.WriteLine("namespace Unreal.Bench");
+            using (writer.OpenBlock())
+            {
+                writer.WriteLine("public unsafe partial class UStandInObject");
+                using (writer.OpenBlock())
+                {
+                    foreach (var function in functions)
+                        new NativeFunctionBinder(function).Write(writer, MemberCodeComponent.ManagedPart);
+                }
+            }
+
+            return str.ToString();
+        }
+
+        private static Assembly CompileBindings(string bindings)
+        {
+            var references = ((string) AppContext.GetData("TRUSTED_PLATFORM_ASSEMBLIES")!)
+                .Split(Path.PathSeparator)
+                .Concat(new[] {typeof(UObjectBase).Assembly.Location, typeof(UClassAttribute).Assembly.Location})
+                .Distinct()
+                .Select(x => MetadataReference.CreateFromFile(x));
+
+            var compilation = CSharpCompilation.Create("Unreal.Bench",
+                new[] {CSharpSyntaxTree.ParseText(ModuleSource), CSharpSyntaxTree.ParseText(bindings)}, references,
+                new CSharpCompilationOptions(OutputKind.DynamicallyLinkedLibrary, allowUnsafe: true,
+                    optimizationLevel: OptimizationLevel.Release, nullableContextOptions: NullableContextOptions.Enable));
+
+            using var stream = new MemoryStream();
+            var result = compilation.Emit(stream);
+
+            var errors = result.Diagnostics.Where(x => x.Severity == DiagnosticSeverity.Error).ToList();
+            Assert.True(errors.Count == 0, string.Join("\n", errors));
+
+            return Assembly.Load(stream.ToArray());
+        }
+
+        #endregion
+
+        [StandInFact]
+        public void BenchmarkBindingCalls()
+        {
+            var bindings = WriteBindings();
+            var assembly = CompileBindings(bindings);
+
+            var objectType = assembly.GetType("Unreal.Bench.UStandInObject")!;
+            var managedType = assembly.GetType("Unreal.Bench.UStandInManagedObject")!;
+            var loops = assembly.GetType("Unreal.Bench.Loops")!;
+
+            var objectClass = StandInRuntime.FindClass("StandInObject");
+            var managedClass = StandInRuntime.FindClass("StandInManagedObject");
+
+            UObjectReflection.Instance.RegisterType(objectClass, objectType, TypeImplementation.Native);
+            UObjectReflection.Instance.RegisterType(managedClass, managedType, TypeImplementation.Managed);
+
+            var self = UObjectUtil.Create<UObjectBase>(objectClass, TypeImplementation.Native, IntPtr.Zero);
+            var managed = StandInRuntime.CreateManagedObject(managedClass,
+                x => (UObjectBase) Activator.CreateInstance(managedType, BindingFlags.Instance | BindingFlags.NonPublic,
+                    null, new object[] {x}, null)!);
+
+            void Measure(string name, params object[] arguments)
+            {
+                var loop = loops.GetMethod(name)!;
+                var args = arguments.Prepend(self).Append(Iterations).ToArray();
+
+                // Warm up, so the timed run uses optimized code.
+                args[^1] = Iterations / 10;
+                loop.Invoke(null, args);
+
+                args[^1] = Iterations;
+                var watch = Stopwatch.StartNew();
+                loop.Invoke(null, args);
+                var time = watch.Elapsed.TotalMilliseconds * 1e6 / Iterations;
+
+                m_output.WriteLine($"{name,-20} {time,8:F2}ns/call");
+            }
+
+            m_output.WriteLine($"{Iterations:N0} calls per kind of binding:");
+            Measure("Nop");
+            Measure("Primitives");
+            Measure("StructByReference");
+            Measure("StructReturn");
+            Measure("NativeObject");
+            Measure("ManagedObject", managed);
+            Measure("SubclassOf", managedClass);
+            Measure("OutParameter");
+
+            // Check the results, so the bindings are known to marshal correctly.
+            object? Run(string name, params object[] arguments) => loops.GetMethod(name)!.Invoke(null, arguments);
+
+            Assert.Equal(10, (int) Run("Primitives", self, 10)!);
+            Assert.Equal(140.0f, (float) Run("StructByReference", self, 10)!);
+            Assert.Equal(6.0f, (float) Run("StructReturn", self, 4)!);
+            Assert.Same(self, Run("NativeObject", self, 10));
+            Assert.Same(managed, Run("ManagedObject", self, managed, 10));
+            Assert.Equal(objectClass, (IntPtr) Run("SubclassOf", self, managedClass, 1)!);
+            Assert.Equal(27, (int) Run("OutParameter", self, 10)!);
+
+            ManagedUObjectRegistration.Unregister(managed);
+            NativeUObjectRegistration.Unregister(managed);
+            StandInRuntime.DestroyObject(UObjectUtil.GetNativeInstance(managed));
+
+            NativeUObjectRegistration.Unregister(self);
+            StandInRuntime.DestroyObject(UObjectUtil.GetNativeInstance(self));
+        }
+    }
+}
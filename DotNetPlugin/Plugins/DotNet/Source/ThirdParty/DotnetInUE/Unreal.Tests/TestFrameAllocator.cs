@@ -0,0 +1,94 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Runtime.InteropServices;
+using Unreal.Core;
+using Xunit;
+
+namespace Unreal.Tests
+{
+    [Collection(StandInCollection.Name)]
+    public unsafe class TestFrameAllocator
+    {
+        [StructLayout(LayoutKind.Sequential)]
+        private struct Vector4
+        {
+            public float X, Y, Z, W;
+        }
+
+        private static void EndFrame() =>
+            ((delegate* unmanaged<void>) StandInRuntime.GetFunction("StandIn_EndFrame"))();
+
+        private static int Mallocs =>
+            ((delegate* unmanaged<int>) StandInRuntime.GetFunction("StandIn_GetFrameArenaMallocs"))();
+
+        [StandInFact]
+        public void TestAllocate()
+        {
+            EndFrame();
+
+            var bytes = FrameAllocator.Allocate(3, 1);
+            var longs = FrameAllocator.Allocate<long>(4);
+            var aligned = FrameAllocator.Allocate(100, 64);
+            var large = FrameAllocator.Allocate(100 * 1024);
+
+            bytes.Fill(1);
+            longs.Fill(-1);
+            aligned.Fill(2);
+            large.Fill(3);
+
+            fixed (long* pointer = longs)
+                Assert.Equal(0, (long) pointer % 8);
+            fixed (byte* pointer = aligned)
+                Assert.Equal(0, (long) pointer % 64);
+
+            // Structs the size of a vector register are aligned for it, others can ask for their alignment.
+            FrameAllocator.Allocate(1, 1);
+            fixed (Vector4* pointer = FrameAllocator.Allocate<Vector4>(2))
+                Assert.Equal(0, (long) pointer % 16);
+            FrameAllocator.Allocate(1, 1);
+            fixed (long* pointer = FrameAllocator.Allocate<long>(2, 32))
+                Assert.Equal(0, (long) pointer % 32);
+            FrameAllocator.Allocate(1, 1);
+            Assert.Equal(0, (long) FrameAllocator.Copy<int>(new[] {1}, 16) % 16);
+
+            // Allocations don't overlap.
+            Assert.Equal(1, bytes[2]);
+            Assert.Equal(-1L, longs[0]);
+            Assert.Equal(2, aligned[99]);
+            Assert.Equal(3, large[large.Length - 1]);
+
+            var values = FrameAllocator.Copy<int>(new[] {1, 2, 3});
+            Assert.Equal(3, values[2]);
+
+            var chars = FrameAllocator.CopyString("Frame");
+            Assert.Equal("Frame", new string(chars));
+            Assert.Equal('\0', chars[5]);
+            Assert.True(FrameAllocator.CopyString(null) == null);
+
+            Assert.Throws<ArgumentOutOfRangeException>(() => FrameAllocator.Allocate(8, 3));
+
+            // Memory of the previous frame is reused.
+            EndFrame();
+            var first = FrameAllocator.AllocateUnsafe(16);
+            EndFrame();
+            Assert.True(first == FrameAllocator.AllocateUnsafe(16));
+
+            // Once the arena has grown, frames no longer go to the system allocator.
+            int mallocs = 0;
+            for (int frame = 0; frame < 10; ++frame)
+            {
+                if (frame == 1)
+                    mallocs = Mallocs;
+
+                for (int i = 0; i < 1000; ++i)
+                    FrameAllocator.CopyString("A string of a few dozen characters, copied for a call.");
+
+                EndFrame();
+            }
+
+            Assert.Equal(mallocs, Mallocs);
+        }
+    }
+}
@@ -77,5 +77,128 @@ namespace Unreal.Tests
 
             m_output.WriteLine(str.ToString());
         }
+
+        [Fact]
+        public void TestExecThunk()
+        {
+            var enclosingType = TypeDefinition.CreateBuilder(m_module, "UTest")
+                .WithTypicalArgumentType(NativeTransferType.ByPointer)
+                .Build();
+
+            var function = FunctionDefinition.CreateBuilder(enclosingType, "Add")
+                .WithMetaAttribute(ManagedFunctionBinder.CustomThunk)
+                .WithParameter<int>("lhs")
+                .WithParameter<int>("rhs")
+                .WithParameter<bool>("Stack", ManagedTransferType.Out)
+                .WithReturn<int>()
+                .Build();
+
+            var binder = new ManagedFunctionBinder(function);
+            Assert.True(binder.HasExecThunk);
+
+            GetCodeWriter(out var str, out var writer);
+
+            binder.Write(writer, MemberCodeComponent.NativeClassDeclaration);
+            binder.Write(writer, MemberCodeComponent.NativeImplementation);
+
+            var code = str.ToString();
+            m_output.WriteLine(code);
+
+            Assert.Contains("UFUNCTION(CustomThunk)", code);
+            Assert.Contains("DECLARE_FUNCTION(execAdd);", code);
+            Assert.Contains("DEFINE_FUNCTION(UTest::execAdd)", code);
+            Assert.Contains("int32& ThunkParam_lhs = FDotNetExecThunk::StepParameter(Stack, ThunkTemp_lhs);", code);
+            Assert.Contains("bool& ThunkParam_Stack = FDotNetExecThunk::StepOutParameter(Stack, ThunkTemp_Stack);",
+                code);
+            Assert.DoesNotContain("__temp", code);
+
+            // Parameters are only named inside the native scope, after the frame was read.
+            var thunk = code.Substring(code.IndexOf("DEFINE_FUNCTION"));
+            var nativeScope = thunk.Substring(thunk.IndexOf("P_NATIVE_BEGIN;"));
+            Assert.DoesNotContain("bool& Stack", thunk.Substring(0, thunk.IndexOf("P_NATIVE_BEGIN;")));
+            Assert.Contains("bool& Stack = ThunkParam_Stack;", nativeScope);
+            Assert.Contains("UTest* __self = ThunkSelf;", nativeScope);
+            Assert.Contains($"{function.EntryPointName}(__self, lhs, rhs, Stack__marshalled);", nativeScope);
+            Assert.Contains("*ThunkResult = __return;", nativeScope);
+        }
+
+        [Fact]
+        public void TestReflectedCall()
+        {
+            var enclosingType = TypeDefinition.CreateBuilder(m_module, "UTest")
+                .WithTypicalArgumentType(NativeTransferType.ByPointer)
+                .Build();
+
+            var function = FunctionDefinition.CreateBuilder(enclosingType, "Add")
+                .WithParameter<int>("lhs")
+                .WithParameter<int>("rhs")
+                .WithReturn<int>()
+                .Build();
+
+            var binder = new ReflectedFunctionBinder(function, "/Script/Test.Test:Add");
+
+            GetCodeWriter(out var str, out var writer);
+            binder.Write(writer, MemberCodeComponent.NativeImplementation);
+
+            var code = str.ToString();
+            m_output.WriteLine(code);
+
+            // A failed lookup must not be cached.
+            Assert.DoesNotContain("UFunction* const", code);
+            Assert.Contains("static UFunction* ReflectedFunction = nullptr;\n", code);
+            Assert.Contains("if (!ReflectedFunction)\n", code);
+            Assert.Contains("FDotNetReflectedCall::FindFunction(TEXT(\"/Script/Test.Test:Add\"), sizeof(FParms), "
+                            + "{{STRUCT_OFFSET(FParms, lhs), sizeof(FParms::lhs)}, "
+                            + "{STRUCT_OFFSET(FParms, rhs), sizeof(FParms::rhs)}, "
+                            + "{STRUCT_OFFSET(FParms, ReturnValue), sizeof(FParms::ReturnValue)}});", code);
+            Assert.Contains("FDotNetReflectedCall::Invoke(ReflectedSelf, ReflectedFunction, &ReflectedParms);", code);
+
+            var empty = FunctionDefinition.CreateBuilder(enclosingType, "Reset").Build();
+            GetCodeWriter(out str, out writer);
+            new ReflectedFunctionBinder(empty, "/Script/Test.Test:Reset").Write(writer,
+                MemberCodeComponent.NativeImplementation);
+
+            Assert.Contains("FindFunction(TEXT(\"/Script/Test.Test:Reset\"), 0, {});", str.ToString());
+        }
+
+        [Fact]
+        public void TestInstrumentation()
+        {
+            var enclosingType = TypeDefinition.CreateBuilder(m_module, "UTest")
+                .WithTypicalArgumentType(NativeTransferType.ByPointer)
+                .Build();
+
+            var function = FunctionDefinition.CreateBuilder(enclosingType, "Add")
+                .WithParameter<int>("lhs")
+                .WithParameter<int>("rhs")
+                .WithReturn<int>()
+                .Build();
+
+            string Write(FunctionWriterBase binder, MemberCodeComponent component)
+            {
+                GetCodeWriter(out var str, out var writer);
+                binder.Write(writer, component);
+                return str.ToString();
+            }
+
+            const string scope = "DOTNET_BINDING_SCOPE(\"UTest::Add\");";
+
+            var native = new NativeFunctionBinder(function);
+            Assert.DoesNotContain(scope, Write(native, MemberCodeComponent.NativeImplementation));
+            Assert.DoesNotContain(FunctionWriterBase.InstrumentationHeader, native.AdditionalHeaders);
+
+            native.IsInstrumented = true;
+            Assert.Contains(scope, Write(native, MemberCodeComponent.NativeImplementation));
+            Assert.Contains(FunctionWriterBase.InstrumentationHeader, native.AdditionalHeaders);
+
+            var managed = new ManagedFunctionBinder(function) {IsInstrumented = true};
+            var code = Write(managed, MemberCodeComponent.NativeClassDeclaration);
+            m_output.WriteLine(code);
+            Assert.Contains(scope, code);
+
+            managed.IsInstrumented = false;
+            Assert.DoesNotContain(scope, Write(managed, MemberCodeComponent.NativeClassDeclaration));
+            Assert.DoesNotContain(FunctionWriterBase.InstrumentationHeader, managed.AdditionalHeaders);
+        }
     }
-}
\ No newline at end of file
+}
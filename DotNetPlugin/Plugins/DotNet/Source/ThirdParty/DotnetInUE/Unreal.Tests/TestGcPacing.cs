@@ -0,0 +1,164 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Runtime;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    /// <summary>
+    /// Tests that assert on the collections made by the runtime, allocations of other tests would make them unreliable.
+    /// </summary>
+    [CollectionDefinition(Name, DisableParallelization = true)]
+    public class GcCollection
+    {
+        public const string Name = "GC";
+    }
+
+    [Collection(GcCollection.Name)]
+    public class TestGcPacing
+    {
+        private const int RegionSize = 1024 * 1024;
+
+        private readonly ITestOutputHelper m_output;
+
+        public TestGcPacing(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        private static void Allocate(int bytes)
+        {
+            for (int i = 0; i < bytes / 1024; ++i)
+                GC.KeepAlive(new byte[1024]);
+        }
+
+        [Fact]
+        public void TestPacedCollection()
+        {
+            // Start from a fresh gen0, the allocations below are well under any gen0 budget of the runtime.
+            GC.Collect();
+
+            GcPacing.IsEnabled = true;
+            GcPacing.AllocationBudget = 128 * 1024;
+
+            try
+            {
+                GcPacing.Tick();
+
+                // A frame that allocates most of the budget leads to a collection, as the next one would exceed it.
+                Allocate(96 * 1024);
+                var paced = GcPacing.PacedCollections;
+                var stats = GcPacing.Tick();
+
+                m_output.WriteLine($"Allocated {stats.AllocatedBytes} bytes, paced: {stats.Paced}.");
+
+                // The runtime counts allocations per allocation context, the last one may not be included yet.
+                Assert.True(stats.AllocatedBytes >= 64 * 1024);
+                Assert.Equal(stats.AllocatedBytes, GcPacing.LastFrameAllocatedBytes);
+                Assert.Equal(0, stats.UnpacedCollections);
+                Assert.Equal(0, stats.UnderMemoryPressure);
+
+                Assert.Equal(1, stats.Paced);
+                Assert.Equal(paced + 1, GcPacing.PacedCollections);
+
+                // Nothing was allocated since, no need to collect again.
+                Assert.Equal(0, GcPacing.Tick().Paced);
+            }
+            finally
+            {
+                GcPacing.IsEnabled = false;
+                GcPacing.AllocationBudget = 8 * 1024 * 1024;
+            }
+        }
+
+        [Fact]
+        public void TestNoGcRegion()
+        {
+            Assert.True(GcPacing.TryEnterNoGcRegion(16 * 1024 * 1024));
+            Assert.Equal(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+
+            GcPacing.IsEnabled = true;
+            GcPacing.AllocationBudget = 1024;
+
+            try
+            {
+                // Nested regions share the outermost one.
+                using (var region = GcPacing.NoGcRegionScope(1024))
+                {
+                    Assert.True(region.IsEntered);
+
+                    // No paced collections in a region.
+                    var collections = GC.CollectionCount(0);
+                    Allocate(1024 * 1024);
+                    Assert.Equal(0, GcPacing.Tick().Paced);
+                    Assert.Equal(collections, GC.CollectionCount(0));
+                }
+
+                Assert.Equal(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+            }
+            finally
+            {
+                GcPacing.IsEnabled = false;
+                GcPacing.AllocationBudget = 8 * 1024 * 1024;
+                Assert.True(GcPacing.ExitNoGcRegion());
+            }
+
+            Assert.NotEqual(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+            Assert.Throws<InvalidOperationException>(() => GcPacing.ExitNoGcRegion());
+        }
+
+        [Fact]
+        public void TestNoGcRegionEndedEarly()
+        {
+            Assert.True(GcPacing.TryEnterNoGcRegion(RegionSize));
+
+            // Allocating past the region makes the runtime collect and leave it.
+            Allocate(64 * RegionSize);
+            Assert.NotEqual(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+            Assert.False(GcPacing.ExitNoGcRegion());
+
+            // The region was still ended, so a new one can start.
+            Assert.True(GcPacing.TryEnterNoGcRegion(RegionSize));
+            Assert.Equal(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+            Assert.True(GcPacing.ExitNoGcRegion());
+        }
+
+        [Fact]
+        public void TestFrameNoGcRegion()
+        {
+            GcPacing.FrameNoGcRegionSize = 16 * RegionSize;
+
+            try
+            {
+                Assert.Equal(1, GcPacing.Tick().InNoGcRegion);
+                Assert.Equal(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+
+                // Scopes within the frame do not collect to enter.
+                var collections = GC.CollectionCount(0);
+                using (var region = GcPacing.NoGcRegionScope(RegionSize))
+                {
+                    Assert.True(region.IsEntered);
+                    Allocate(RegionSize);
+                }
+
+                Assert.Equal(collections, GC.CollectionCount(0));
+                Assert.Equal(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+
+                // The next tick ends the region of the frame before entering its own.
+                Assert.Equal(1, GcPacing.Tick().InNoGcRegion);
+                Assert.Equal(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+            }
+            finally
+            {
+                GcPacing.FrameNoGcRegionSize = 0;
+            }
+
+            Assert.Equal(0, GcPacing.Tick().InNoGcRegion);
+            Assert.NotEqual(GCLatencyMode.NoGCRegion, GCSettings.LatencyMode);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Diagnostics;
+using System.Threading;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    public class TestGcTelemetry
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestGcTelemetry(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        [Fact]
+        public void TestCollectionRecorded()
+        {
+            GcTelemetry.Enable();
+
+            try
+            {
+                var events = new GcEvent[GcTelemetry.Capacity];
+                var index = GC.CollectionCount(0);
+
+                // Events are dispatched asynchronously, keep collecting until one shows up.
+                var watch = Stopwatch.StartNew();
+                while (watch.Elapsed < TimeSpan.FromSeconds(30))
+                {
+                    GC.Collect(2, GCCollectionMode.Forced, true);
+                    Thread.Sleep(100);
+
+                    var count = GcTelemetry.Drain(events);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        var gcEvent = events[i];
+                        if (gcEvent.Index <= index || gcEvent.Generation != 2)
+                            continue;
+
+                        m_output.WriteLine(
+                            $"GC #{gcEvent.Index}: gen{gcEvent.Generation}, paused {gcEvent.Pause.TotalMilliseconds:F3}ms, promoted {gcEvent.PromotedBytes} bytes, heap {gcEvent.HeapSizeBytes} bytes.");
+
+                        Assert.True(gcEvent.PauseTicks >= 0);
+                        Assert.True(gcEvent.HeapSizeBytes > 0);
+                        return;
+                    }
+                }
+
+                Assert.True(false, "No collection was recorded.");
+            }
+            finally
+            {
+                GcTelemetry.Disable();
+            }
+        }
+    }
+}
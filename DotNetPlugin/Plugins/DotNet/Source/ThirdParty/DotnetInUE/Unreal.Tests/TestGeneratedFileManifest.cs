@@ -0,0 +1,62 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.IO;
+using Unreal.Generation;
+using Xunit;
+
+namespace Unreal.Tests
+{
+    public class TestGeneratedFileManifest
+    {
+        [Fact]
+        public void TestWriteIfChanged()
+        {
+            var root = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(root);
+
+            try
+            {
+                var first = Path.Combine("Public", "First.h");
+                var second = Path.Combine("Private", "Second.cpp");
+                var leftover = Path.Combine(root, "Private", "Leftover.cpp");
+
+                var manifest = GeneratedFileManifest.Load(root);
+                Assert.True(manifest.WriteIfChanged(first, "// First"));
+                Assert.True(manifest.WriteIfChanged(second, "// Second"));
+                File.WriteAllText(leftover, "// Not generated");
+                manifest.Finish();
+
+                Assert.True(GeneratedFileManifest.Exists(root));
+                Assert.False(File.Exists(leftover));
+                Assert.Equal(1, manifest.Removed);
+
+                var stamp = new DateTime(2020, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+                File.SetLastWriteTimeUtc(Path.Combine(root, first), stamp);
+
+                // Same contents for the first file, the second one is no longer generated.
+                manifest = GeneratedFileManifest.Load(root);
+                Assert.False(manifest.WriteIfChanged(first, "// First"));
+                manifest.Finish();
+
+                Assert.Equal(0, manifest.Written);
+                Assert.Equal(1, manifest.Unchanged);
+                Assert.Equal(1, manifest.Removed);
+                Assert.Equal(stamp, File.GetLastWriteTimeUtc(Path.Combine(root, first)));
+                Assert.False(File.Exists(Path.Combine(root, second)));
+
+                // Changed contents are written.
+                manifest = GeneratedFileManifest.Load(root);
+                Assert.True(manifest.WriteIfChanged(first, "// First, changed"));
+                manifest.Finish();
+
+                Assert.Equal("// First, changed", File.ReadAllText(Path.Combine(root, first)));
+            }
+            finally
+            {
+                Directory.Delete(root, true);
+            }
+        }
+    }
+}
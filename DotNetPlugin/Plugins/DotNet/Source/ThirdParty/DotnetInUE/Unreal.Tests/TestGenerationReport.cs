@@ -0,0 +1,78 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System.IO;
+using System.Linq;
+using System.Text.Json;
+using System.Threading;
+using Unreal.Generation;
+using Unreal.Metadata;
+using Xunit;
+
+namespace Unreal.Tests
+{
+    public class TestGenerationReport
+    {
+        private static readonly Module Module = new("Test");
+
+        [Fact]
+        public void TestNestedPhases()
+        {
+            var report = new GenerationReport(Module, 10);
+
+            using (report.Measure(GenerationPhase.TypeResolution))
+            {
+                Thread.Sleep(10);
+
+                using (report.Measure(GenerationPhase.MetadataLoad))
+                    Thread.Sleep(100);
+            }
+
+            var resolution = report.GetPhaseTime(GenerationPhase.TypeResolution);
+            var load = report.GetPhaseTime(GenerationPhase.MetadataLoad);
+
+            // The nested phase is not counted for the outer one.
+            Assert.True(load.TotalMilliseconds >= 90);
+            Assert.True(resolution.TotalMilliseconds >= 5);
+            Assert.True(resolution < load);
+        }
+
+        [Fact]
+        public void TestWrite()
+        {
+            var report = new GenerationReport(Module, 1);
+
+            var small = TypeDefinition.CreateBuilder(Module, "Small").WithNamespace("Unreal.Test").Build();
+            var large = TypeDefinition.CreateBuilder(Module, "Large").WithNamespace("Unreal.Test").Build();
+
+            report.AddOutput(new StructWriter(small), 1, 100);
+            report.AddOutput(new StructWriter(large), 2, 1000);
+            report.AddOutput(new ModuleWriter(Module), 3, 50);
+
+            var path = Path.GetTempFileName();
+            try
+            {
+                report.Write(path);
+
+                using var document = JsonDocument.Parse(File.ReadAllText(path));
+                var root = document.RootElement;
+
+                Assert.Equal("Test", root.GetProperty("Module").GetString());
+                Assert.Equal(5, root.GetProperty("PhaseMilliseconds").EnumerateObject().Count());
+
+                var module = root.GetProperty("Modules").EnumerateArray().Single();
+                Assert.Equal(2, module.GetProperty("Types").GetInt32());
+                Assert.Equal(6, module.GetProperty("Files").GetInt32());
+                Assert.Equal(1150, module.GetProperty("Bytes").GetInt64());
+
+                var largest = root.GetProperty("LargestTypes").EnumerateArray().Single();
+                Assert.Equal("Unreal.Test.Large", largest.GetProperty("Name").GetString());
+                Assert.Equal(1000, largest.GetProperty("Bytes").GetInt64());
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+    }
+}
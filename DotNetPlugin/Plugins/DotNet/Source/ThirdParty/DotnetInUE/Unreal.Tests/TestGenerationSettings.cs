@@ -0,0 +1,80 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using Unreal.NativeMetadata;
+using Xunit;
+
+namespace Unreal.Tests
+{
+    public class TestGenerationSettings
+    {
+        [Theory]
+        [InlineData("Actor", true)]
+        [InlineData("ActorComponent", true)]
+        [InlineData("SceneComponent", true)]
+        [InlineData("DeprecatedComponent", false)]
+        [InlineData("Pawn", false)]
+        [InlineData("Character", true)]
+        public void TestPatterns(string name, bool expected)
+        {
+            var patterns = NamePattern.Parse("Actor*, *Component\n-Deprecated*\n/^Char.*r$/");
+
+            Assert.Equal(expected, NamePattern.IsMatch(patterns, name));
+        }
+
+        [Theory]
+        [InlineData("Ab", true)]
+        [InlineData("Abbb", true)]
+        [InlineData("Abbbb", false)]
+        [InlineData("Actor", true)]
+        [InlineData("Pawn", false)]
+        [InlineData("Vector2", false)]
+        public void TestRegexWithCommas(string name, bool expected)
+        {
+            // Commas of a quantifier belong to the regular expression, those after it separate rules.
+            var patterns = NamePattern.Parse("/^Ab{1,3}$/, Actor\n# Pawn, Vector\n+ /^V.{2,}$/ , -Vector?");
+
+            Assert.Equal(4, patterns.Count);
+            Assert.Equal(expected, NamePattern.IsMatch(patterns, name));
+        }
+
+        [Fact]
+        public void TestLoad()
+        {
+            const string ini = @"[Settings]
+MainModule=DotNetPlugin
+
+[Generation]
+Modules= <<<$EndModules
+CoreUObject
+Engine
+$EndModules
+
+[Generation.Module.CoreUObject]
+Generate= <<<$EndGenerate
+Object
+Class
+$EndGenerate";
+
+            var settings = GenerationSettings.Load(ini);
+
+            Assert.True(settings.HasRules);
+
+            Assert.True(settings.ShouldGenerateModule("Engine", BuildModuleType.EngineRuntime));
+            Assert.False(settings.ShouldGenerateModule("UMG", BuildModuleType.EngineRuntime));
+            Assert.True(settings.ShouldGenerateModule("MyGame", BuildModuleType.GameRuntime));
+
+            Assert.True(settings.ShouldGenerateType("CoreUObject", "Object"));
+            Assert.False(settings.ShouldGenerateType("CoreUObject", "Package"));
+            Assert.True(settings.ShouldGenerateType("Engine", "Actor"));
+        }
+
+        [Fact]
+        public void TestNoRules()
+        {
+            var settings = GenerationSettings.Load("[Settings]\nMainModule=DotNetPlugin");
+
+            Assert.False(settings.HasRules);
+        }
+    }
+}
@@ -0,0 +1,359 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text.RegularExpressions;
+using System.Threading;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.Diagnostics;
+using Microsoft.CodeAnalysis.Text;
+using Unreal.Core;
+using Unreal.Generation;
+using Unreal.NativeMetadata;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    public class TestGenerator
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestGenerator(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        private class OptionsProvider : AnalyzerConfigOptionsProvider
+        {
+            private class Options : AnalyzerConfigOptions
+            {
+                public readonly Dictionary<string, string> Values = new();
+
+                public override bool TryGetValue(string key, out string value)
+                {
+                    return Values.TryGetValue(key, out value!);
+                }
+            }
+
+            private static readonly Options Empty = new();
+
+            private readonly Options m_global = new();
+
+            public override AnalyzerConfigOptions GlobalOptions => m_global;
+
+            public OptionsProvider(IEnumerable<(string Name, string Value)> properties)
+            {
+                foreach (var (name, value) in properties)
+                    m_global.Values[$"build_property.{name}"] = value;
+            }
+
+            public override AnalyzerConfigOptions GetOptions(SyntaxTree tree) => Empty;
+
+            public override AnalyzerConfigOptions GetOptions(AdditionalText textFile) => Empty;
+        }
+
+        private class FileText : AdditionalText
+        {
+            public override string Path { get; }
+
+            public FileText(string path)
+            {
+                Path = path;
+            }
+
+            public override SourceText GetText(CancellationToken cancellationToken = default)
+            {
+                return SourceText.From(File.ReadAllText(Path));
+            }
+        }
+
+        private static readonly UEModule Module = new()
+        {
+            Kind = UETypeKind.UPackage,
+            Name = "BenchModule",
+            LongName = "/Script/BenchModule",
+            Folder = "Source/BenchModule",
+            File = "BenchModule.Build.cs",
+            PackageType = BuildModuleType.EngineRuntime
+        };
+
+        private static UEProperty CreateProperty(string name, int offset)
+        {
+            return new(name, "int32")
+            {
+                PropertyType = "IntProperty",
+                Offset = offset,
+                ArrayDim = 1,
+                Flags = PropertyFlags.Edit | PropertyFlags.BlueprintVisible
+            };
+        }
+
+        /// <summary>
+        /// Create a module with a fixed set of classes, structs and enums.
+        /// </summary>
+        private static IEnumerable<UEField> CreateTypes(int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                var @class = new UEClass
+                {
+                    Kind = UETypeKind.UObject,
+                    Name = $"BenchClass{i}",
+                    CppName = $"UBenchClass{i}",
+                    Module = Module.Name,
+                    Size = 64,
+                    Flags = ClassFlags.Native | ClassFlags.RequiredAPI,
+                    Meta = {["ModuleRelativePath"] = $"Public/BenchClass{i}.h"}
+                };
+
+                for (int j = 0; j < 8; ++j)
+                {
+                    @class.Functions.Add(new UEFunction
+                    {
+                        Kind = UETypeKind.UFunction,
+                        Name = $"Function{j}",
+                        Flags = FunctionFlags.Native | FunctionFlags.Public | FunctionFlags.BlueprintCallable,
+                        Parameters = {CreateProperty("A", 0), CreateProperty("B", 4)},
+                        Return = CreateProperty("ReturnValue", 8),
+                        ParmsSize = 12,
+                        ReturnValueOffset = 8
+                    });
+                }
+
+                yield return @class;
+
+                var @struct = new UEStruct
+                {
+                    Kind = UETypeKind.UStruct,
+                    Name = $"BenchStruct{i}",
+                    CppName = $"FBenchStruct{i}",
+                    Module = Module.Name,
+                    Size = 32,
+                    Meta = {["ModuleRelativePath"] = $"Public/BenchStruct{i}.h"}
+                };
+
+                for (int j = 0; j < 8; ++j)
+                    @struct.Properties.Add(CreateProperty($"Value{j}", j * 4));
+
+                yield return @struct;
+
+                yield return new UEEnum
+                {
+                    Kind = UETypeKind.UEnum,
+                    Name = $"EBenchEnum{i}",
+                    CppName = $"EBenchEnum{i}",
+                    Module = Module.Name,
+                    Form = UEnumCppForm.EnumClass,
+                    MaxValue = 3,
+                    Values = {new UEEnumValue("First", 1), new UEEnumValue("Second", 2)}
+                };
+            }
+        }
+
+        private static CSharpCompilation CreateCompilation()
+        {
+            var platformAssemblies = ((string) AppContext.GetData("TRUSTED_PLATFORM_ASSEMBLIES")!)
+                .Split(Path.PathSeparator);
+
+            var references = platformAssemblies
+                .Concat(new[] {typeof(UObjectBase).Assembly.Location, typeof(UClassAttribute).Assembly.Location})
+                .Distinct()
+                .Select(x => MetadataReference.CreateFromFile(x));
+
+            // Stand ins for the engine types the generator expects.
+            var engineTypes = CSharpSyntaxTree.ParseText(@"
+namespace Unreal.CoreUObject
+{
+    [Unreal.UClass, Unreal.Module(""CoreUObject"")]
+    public partial class UObject : Unreal.Core.UObjectBase { }
+
+    [Unreal.UClass, Unreal.Module(""CoreUObject"")]
+    public partial class UClass : UObject { }
+}");
+
+            return CSharpCompilation.Create("Unreal.BenchModule", new[] {engineTypes}, references,
+                new CSharpCompilationOptions(OutputKind.DynamicallyLinkedLibrary, allowUnsafe: true));
+        }
+
+        private static (TimeSpan Time, ImmutableArray<SyntaxTree> Trees) Run(CSharpCompilation compilation,
+            AdditionalText database, params (string Name, string Value)[] properties)
+        {
+            var options = new OptionsProvider(properties.Append(("UnrealNativeBindingsMissingSymbolHandling", "Skip")));
+
+            GeneratorDriver driver = CSharpGeneratorDriver.Create(new ISourceGenerator[] {new Generator()},
+                new[] {database}, (CSharpParseOptions) CSharpParseOptions.Default, options);
+
+            var watch = Stopwatch.StartNew();
+            driver = driver.RunGenerators(compilation);
+            var time = watch.Elapsed;
+
+            return (time, driver.GetRunResult().GeneratedTrees);
+        }
+
+        /// <summary>
+        /// Contents of a generated file without the banner and the module ticket, which change with every generation.
+        /// </summary>
+        private static string GetContents(SyntaxTree tree)
+        {
+            return string.Join("\n", tree.ToString().Split('\n')
+                .Where(x => !x.StartsWith("//==") && !x.Contains("icket")));
+        }
+
+        private static string WriteDatabase(int typeCount)
+        {
+            var writer = new MetadataDatabaseWriter(Module);
+            foreach (var type in CreateTypes(typeCount / 3))
+                writer.AddType(type);
+
+            var path = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName() + MetadataDatabase.Extension);
+            File.WriteAllBytes(path, writer.ToArray());
+
+            return path;
+        }
+
+        [Fact]
+        public void BenchmarkParallelGeneration()
+        {
+            const int typeCount = 600;
+
+            var path = WriteDatabase(typeCount);
+
+            try
+            {
+                var compilation = CreateCompilation();
+                var database = new FileText(path);
+
+                // Warm up.
+                Run(compilation, database, ("UnrealGeneratorMaxParallelism", "1"));
+
+                var sequential = Run(compilation, database, ("UnrealGeneratorMaxParallelism", "1"));
+                var parallel = Run(compilation, database, ("UnrealGeneratorMaxParallelism", "-1"));
+
+                // The output must not depend on scheduling.
+                Assert.True(sequential.Trees.Length > typeCount / 3);
+                Assert.Equal(sequential.Trees.Select(x => x.FilePath), parallel.Trees.Select(x => x.FilePath));
+                Assert.Equal(sequential.Trees.Select(GetContents), parallel.Trees.Select(GetContents));
+
+                m_output.WriteLine($"Generated bindings for {typeCount} types in "
+                                   + $"{sequential.Time.TotalMilliseconds:F2}ms on one thread and "
+                                   + $"{parallel.Time.TotalMilliseconds:F2}ms on {Environment.ProcessorCount}.");
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestTrimmingRoots()
+        {
+            const int typeCount = 9;
+
+            var path = WriteDatabase(typeCount);
+
+            try
+            {
+                var (_, trees) = Run(CreateCompilation(), new FileText(path));
+
+                var module = trees.Select(x => x.ToString()).Single(x => x.Contains("class ModuleHelper"));
+                m_output.WriteLine(module);
+
+                Assert.Contains("[ModuleInitializer]", module);
+                Assert.Contains("[DynamicDependency(nameof(Init))]", module);
+
+                // Every bound class keeps its native instance constructor.
+                for (int i = 0; i < typeCount / 3; ++i)
+                {
+                    Assert.Contains(
+                        $"[DynamicDependency(\"#ctor(System.IntPtr)\", typeof(Unreal.BenchModule.UBenchClass{i}))]",
+                        module);
+                }
+
+                // Managed classes keep their entry points.
+                var entryPoints = new Regex(@"\[UnmanagedCallersOnly\(EntryPoint = ""(\w+)""\)\]");
+                var exported = trees.Where(x => !x.ToString().Contains("class ModuleHelper"))
+                    .SelectMany(x => entryPoints.Matches(x.ToString()).Select(m => m.Groups[1].Value))
+                    .ToList();
+
+                Assert.True(exported.Count > 0);
+                foreach (var entryPoint in exported)
+                    Assert.Contains($"[DynamicDependency(\"{entryPoint}\", typeof(", module);
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        /// <summary>
+        /// Count the translation units and the include directives the compiler has to process for them.
+        /// </summary>
+        private static (int TranslationUnits, int Includes) CountNativeSources(string root)
+        {
+            var units = Directory.GetFiles(Path.Combine(root, "Private"), "*.cpp", SearchOption.AllDirectories);
+            var includes = units.Sum(x => File.ReadLines(x).Count(line => line.StartsWith("#include")));
+
+            return (units.Length, includes);
+        }
+
+        [Fact]
+        public void BenchmarkUnityOutput()
+        {
+            const int typeCount = 600;
+            const int unityFiles = 8;
+
+            var path = WriteDatabase(typeCount);
+            var output = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+
+            try
+            {
+                var compilation = CreateCompilation();
+                var database = new FileText(path);
+
+                var perTypeRoot = Path.Combine(output, "PerType");
+                Run(compilation, database, ("UnrealForceNativeOutput", "true"),
+                    ("UnrealNativeOutputPath", perTypeRoot));
+
+                var unityRoot = Path.Combine(output, "Unity");
+                Run(compilation, database, ("UnrealForceNativeOutput", "true"),
+                    ("UnrealNativeOutputPath", unityRoot), ("UnrealNativeUnityFiles", unityFiles.ToString()));
+
+                var perType = CountNativeSources(perTypeRoot);
+                var unity = CountNativeSources(unityRoot);
+
+                // Module source plus the unity files.
+                Assert.Equal(unityFiles + 1, unity.TranslationUnits);
+                Assert.True(unity.Includes < perType.Includes);
+
+                // Every thunk is written exactly once.
+                string ReadSources(string root) => string.Join("\n",
+                    Directory.GetFiles(Path.Combine(root, "Private"), "*.cpp", SearchOption.AllDirectories)
+                        .Select(File.ReadAllText));
+
+                var thunk = new Regex(@"^extern ""C"" \w+ [\w\*]+ (\w+)\(", RegexOptions.Multiline);
+                var perTypeThunks = thunk.Matches(ReadSources(perTypeRoot)).Select(x => x.Groups[1].Value).ToList();
+                var unityThunks = thunk.Matches(ReadSources(unityRoot)).Select(x => x.Groups[1].Value).ToList();
+
+                Assert.True(perTypeThunks.Count > 0);
+                Assert.True(perTypeThunks.OrderBy(x => x).SequenceEqual(unityThunks.OrderBy(x => x)));
+
+                m_output.WriteLine($"Per type: {perType.TranslationUnits} translation units with "
+                                   + $"{perType.Includes} includes.");
+                m_output.WriteLine($"Unity: {unity.TranslationUnits} translation units with {unity.Includes} includes.");
+            }
+            finally
+            {
+                File.Delete(path);
+                if (Directory.Exists(output))
+                    Directory.Delete(output, true);
+            }
+        }
+    }
+}
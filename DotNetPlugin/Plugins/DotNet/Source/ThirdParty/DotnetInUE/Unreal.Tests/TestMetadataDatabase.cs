@@ -0,0 +1,393 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Text.Json;
+using System.Text.Json.Serialization;
+using Unreal.Converters;
+using Unreal.NativeMetadata;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    public class TestMetadataDatabase
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestMetadataDatabase(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        private static readonly UEModule Module = new()
+        {
+            Kind = UETypeKind.UPackage,
+            Name = "TestModule",
+            LongName = "/Script/TestModule",
+            Folder = "Source/TestModule",
+            File = "TestModule.Build.cs",
+            PackageType = BuildModuleType.EngineRuntime
+        };
+
+        private static UEProperty CreateProperty(string name, string rawType, int offset)
+        {
+            return new(name, rawType)
+            {
+                PropertyType = "IntProperty",
+                Offset = offset,
+                ArrayDim = 1,
+                Flags = PropertyFlags.Edit | PropertyFlags.BlueprintVisible,
+                Meta = {["Category"] = "Test"}
+            };
+        }
+
+        private static List<UEField> CreateTypes(int count)
+        {
+            var types = new List<UEField>();
+
+            for (int i = 0; i < count; ++i)
+            {
+                var array = CreateProperty("Items", "TArray<UObject*>", 8);
+                array.PropertyType = "ArrayProperty";
+                array.GenericTypeParameters.Add(new TypePropertyReference
+                {
+                    Property = new UEProperty("Items_Inner", "UObject*")
+                    {
+                        PropertyType = "ObjectProperty",
+                        Type = new TypeNameReference {Module = "CoreUObject", Name = "Object", CppName = "UObject"}
+                    }
+                });
+
+                var @class = new UEClass
+                {
+                    Kind = UETypeKind.UObject,
+                    Name = $"TestClass{i}",
+                    CppName = $"UTestClass{i}",
+                    Module = Module.Name,
+                    Size = 64,
+                    Flags = ClassFlags.Native,
+                    Parent = new TypeNameReference {Module = "CoreUObject", Name = "Object", CppName = "UObject"},
+                    Meta = {["ModuleRelativePath"] = $"Public/TestClass{i}.h", ["BlueprintType"] = "true"},
+                    Interfaces = {"UTestInterface"},
+                    Properties = {CreateProperty("Value", "int32", 4), array},
+                };
+
+                @class.Functions.Add(new UEFunction
+                {
+                    Kind = UETypeKind.UFunction,
+                    Name = "GetValue",
+                    Flags = FunctionFlags.Native | FunctionFlags.BlueprintCallable,
+                    Parameters = {CreateProperty("Scale", "int32", 0)},
+                    Return = CreateProperty("ReturnValue", "int32", 4),
+                    ParmsSize = 8,
+                    ReturnValueOffset = 4
+                });
+
+                types.Add(@class);
+
+                types.Add(new UEEnum
+                {
+                    Kind = UETypeKind.UEnum,
+                    Name = $"ETestEnum{i}",
+                    CppName = $"ETestEnum{i}",
+                    Module = Module.Name,
+                    Form = UEnumCppForm.EnumClass,
+                    MaxValue = 3,
+                    Values = {new UEEnumValue("First", 1), new UEEnumValue("Second", 2)}
+                });
+            }
+
+            return types;
+        }
+
+        private static string WriteDatabase(IEnumerable<UEField> types)
+        {
+            var writer = new MetadataDatabaseWriter(Module);
+            foreach (var type in types)
+                writer.AddType(type);
+
+            var path = Path.GetTempFileName();
+            File.WriteAllBytes(path, writer.ToArray());
+            return path;
+        }
+
+        [Fact]
+        public void TestRoundTrip()
+        {
+            var types = CreateTypes(2);
+            var path = WriteDatabase(types);
+
+            try
+            {
+                using var database = MetadataDatabase.Open(path);
+
+                Assert.Equal(Module.Name, database.Module.Name);
+                Assert.Equal(Module.LongName, database.Module.LongName);
+                Assert.Equal(Module.PackageType, database.Module.PackageType);
+
+                var read = database.ReadTypes().ToList();
+                Assert.Equal(types.Count, read.Count);
+
+                var @class = Assert.IsType<UEClass>(read[0]);
+                var expected = (UEClass) types[0];
+                Assert.Equal(expected.CppName, @class.CppName);
+                Assert.Equal(expected.Flags, @class.Flags);
+                Assert.Equal("UObject", @class.Parent!.CppName);
+                Assert.Equal(expected.Meta.Count, @class.Meta.Count);
+                Assert.Equal("true", @class.Meta["BlueprintType"]);
+                Assert.Equal("UTestInterface", @class.Interfaces.Single());
+
+                Assert.Equal(2, @class.Properties.Count);
+                Assert.Same(@class, @class.Properties[0].Struct);
+                Assert.Equal(PropertyFlags.Edit | PropertyFlags.BlueprintVisible, @class.Properties[0].Flags);
+
+                var inner = Assert.IsType<TypePropertyReference>(@class.Properties[1].GenericTypeParameters.Single());
+                Assert.Equal("Items_Inner", inner.Property.Name);
+                Assert.Equal("UObject", inner.Property.Type!.CppName);
+
+                var function = @class.Functions.Single();
+                Assert.Same(@class, function.Class);
+                Assert.Equal("Scale", function.Parameters.Single().Name);
+                Assert.Same(function, function.Parameters.Single().Function);
+                Assert.Equal("ReturnValue", function.GetReturn().Name);
+                Assert.Equal(8, function.ParmsSize);
+                Assert.Equal(4, function.ReturnValueOffset);
+
+                var @enum = Assert.IsType<UEEnum>(read[1]);
+                Assert.Equal(UEnumCppForm.EnumClass, @enum.Form);
+                Assert.Equal(3, @enum.MaxValue);
+                Assert.Equal(new[] {"First", "Second"}, @enum.Values.Select(x => x.Name));
+                Assert.Equal(new[] {1L, 2L}, @enum.Values.Select(x => x.Value));
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestRoundTripLargeValues()
+        {
+            // Values past 2^53 that a double would round, with the low bits set so rounding shows.
+            const PropertyFlags flags = PropertyFlags.Edit | PropertyFlags.NativeAccessSpecifierPrivate
+                | PropertyFlags.SkipSerialization;
+            const long value = (1L << 60) + 1;
+
+            var types = CreateTypes(1);
+            var @class = (UEClass) types[0];
+            @class.Properties[0].Flags = flags;
+
+            var @enum = (UEEnum) types[1];
+            @enum.MaxValue = value + 1;
+            @enum.Values.Add(new UEEnumValue("Large", value));
+
+            var path = WriteDatabase(types);
+
+            try
+            {
+                using var database = MetadataDatabase.Open(path);
+                var read = database.ReadTypes().ToList();
+
+                Assert.Equal(flags, ((UEClass) read[0]).Properties[0].Flags);
+
+                var readEnum = (UEEnum) read[1];
+                Assert.Equal(value + 1, readEnum.MaxValue);
+                Assert.Equal(value, readEnum.Values.Last().Value);
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestRejectsInvalidFile()
+        {
+            var path = Path.GetTempFileName();
+
+            try
+            {
+                File.WriteAllBytes(path, new byte[256]);
+                Assert.Throws<InvalidDataException>(() => MetadataDatabase.Open(path));
+
+                File.WriteAllBytes(path, new byte[4]);
+                Assert.Throws<InvalidDataException>(() => MetadataDatabase.Open(path));
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestRejectsStringOutOfRange()
+        {
+            var path = WriteDatabase(CreateTypes(1));
+
+            try
+            {
+                // Point every string past the end of the string data.
+                var bytes = File.ReadAllBytes(path);
+                var strings = BitConverter.ToInt32(bytes, 8);
+                var count = BitConverter.ToInt32(bytes, 12);
+                for (int i = 0; i < count; ++i)
+                    BitConverter.TryWriteBytes(bytes.AsSpan(strings + i * 8 + 4), int.MaxValue);
+                File.WriteAllBytes(path, bytes);
+
+                Assert.Throws<InvalidDataException>(() => MetadataDatabase.Open(path));
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void TestDatabaseSupersedesJson()
+        {
+            var types = CreateTypes(1);
+
+            var options = new JsonSerializerOptions
+            {
+                Converters =
+                {
+                    new UEMetaConverter(),
+                    new TypeReferenceBaseConverter(),
+                    new JsonStringEnumConverter()
+                }
+            };
+
+            var directory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(directory);
+
+            try
+            {
+                // Json files left over from an earlier export of the same module.
+                var typeDirectory = Directory.CreateDirectory(Path.Combine(directory, Module.Name)).FullName;
+                File.WriteAllText(Path.Combine(directory, Module.Name + ".umeta"), ToJson(Module, options));
+                foreach (var type in types)
+                    File.WriteAllText(Path.Combine(typeDirectory, type.Name + ".umeta"), ToJson(type, options));
+
+                var writer = new MetadataDatabaseWriter(Module);
+                foreach (var type in types)
+                    writer.AddType(type);
+                File.WriteAllBytes(Path.Combine(directory, Module.Name + MetadataDatabase.Extension),
+                    writer.ToArray());
+
+                var collector = new MetadataCollector(directory);
+
+                Assert.Equal(1, collector.Modules.Count);
+                Assert.Equal(types.Count, collector.Types.Count);
+            }
+            finally
+            {
+                Directory.Delete(directory, true);
+            }
+        }
+
+        /// <summary>
+        /// Serialize a type the way the native binder does, with the type discriminators as the first properties.
+        /// </summary>
+        private static string ToJson(UEMeta meta, JsonSerializerOptions options)
+        {
+            using var document = JsonDocument.Parse(JsonSerializer.Serialize(meta, options));
+
+            var stream = new MemoryStream();
+            using (var writer = new Utf8JsonWriter(stream))
+                WriteElement(writer, document.RootElement);
+
+            return Encoding.UTF8.GetString(stream.ToArray());
+
+            static void WriteElement(Utf8JsonWriter writer, JsonElement element)
+            {
+                switch (element.ValueKind)
+                {
+                    case JsonValueKind.Object:
+                        writer.WriteStartObject();
+                        foreach (var property in element.EnumerateObject()
+                            .OrderBy(x => x.Name is not (nameof(UEMeta.Kind) or nameof(TypeReferenceBase.FieldType))))
+                        {
+                            writer.WritePropertyName(property.Name);
+                            WriteElement(writer, property.Value);
+                        }
+
+                        writer.WriteEndObject();
+                        break;
+                    case JsonValueKind.Array:
+                        writer.WriteStartArray();
+                        foreach (var item in element.EnumerateArray())
+                            WriteElement(writer, item);
+                        writer.WriteEndArray();
+                        break;
+                    default:
+                        element.WriteTo(writer);
+                        break;
+                }
+            }
+        }
+
+        [Fact]
+        public void BenchmarkLoad()
+        {
+            const int typeCount = 2000;
+
+            var types = CreateTypes(typeCount / 2);
+
+            var options = new JsonSerializerOptions
+            {
+                Converters =
+                {
+                    new UEMetaConverter(),
+                    new TypeReferenceBaseConverter(),
+                    new JsonStringEnumConverter()
+                }
+            };
+
+            var directory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(directory);
+
+            try
+            {
+                var jsonDirectory = Directory.CreateDirectory(Path.Combine(directory, "Json")).FullName;
+                File.WriteAllText(Path.Combine(jsonDirectory, "Module.umeta"), ToJson(Module, options));
+                foreach (var type in types)
+                    File.WriteAllText(Path.Combine(jsonDirectory, type.Name + ".umeta"), ToJson(type, options));
+
+                var binaryDirectory = Directory.CreateDirectory(Path.Combine(directory, "Binary")).FullName;
+                var writer = new MetadataDatabaseWriter(Module);
+                foreach (var type in types)
+                    writer.AddType(type);
+                File.WriteAllBytes(Path.Combine(binaryDirectory, Module.Name + MetadataDatabase.Extension),
+                    writer.ToArray());
+
+                // Warm up both paths.
+                new MetadataCollector(jsonDirectory);
+                new MetadataCollector(binaryDirectory);
+
+                var watch = Stopwatch.StartNew();
+                var json = new MetadataCollector(jsonDirectory);
+                var jsonTime = watch.Elapsed;
+
+                watch.Restart();
+                var binary = new MetadataCollector(binaryDirectory);
+                var binaryTime = watch.Elapsed;
+
+                Assert.Equal(json.Types.Count, binary.Types.Count);
+                Assert.Equal(json.GetAllProperties().Count(), binary.GetAllProperties().Count());
+
+                m_output.WriteLine($"Loaded {typeCount} types from json in {jsonTime.TotalMilliseconds:F2}ms "
+                                   + $"and from the binary database in {binaryTime.TotalMilliseconds:F2}ms.");
+            }
+            finally
+            {
+                Directory.Delete(directory, true);
+            }
+        }
+    }
+}
@@ -0,0 +1,246 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Threading;
+using Unreal.Core;
+using Xunit;
+
+namespace Unreal.Tests
+{
+    [Collection(StandInCollection.Name)]
+    public unsafe class TestNativeEvents
+    {
+        private const int RingCapacity = 8192;
+
+        private const int QueuedType = 1100;
+        [StructLayout(LayoutKind.Sequential)]
+        private struct TraceDone
+        {
+            public int Handle;
+            public float X, Y, Z;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct Queued
+        {
+            public int Producer;
+            public int Sequence;
+        }
+
+        [UnmanagedCallersOnly]
+        private static void DispatchQueued(NativeEvent* events, int count)
+        {
+            NativeEvents.Dispatch(new ReadOnlySpan<NativeEvent>(events, count));
+        }
+
+        private static bool Enqueue(in Queued payload)
+        {
+            fixed (Queued* pointer = &payload)
+                return ((delegate* unmanaged<int, void*, int, bool>) StandInRuntime.GetFunction("StandIn_EnqueueEvent"))(
+                    QueuedType, pointer, sizeof(Queued));
+        }
+
+        private static int Drain(out int dropped)
+        {
+            int droppedEvents;
+            var count = ((delegate* unmanaged<delegate* unmanaged<NativeEvent*, int, void>, int*, int>)
+                StandInRuntime.GetFunction("StandIn_DrainEvents"))(&DispatchQueued, &droppedEvents);
+            dropped = droppedEvents;
+            return count;
+        }
+
+        /// <summary>
+        /// Run producers that each try to queue a number of events, return how many each one queued.
+        /// </summary>
+        private static int[] Produce(int producers, int eventsPerProducer, Action? whileProducing = null)
+        {
+            var queued = new int[producers];
+            var start = new Barrier(producers);
+
+            var threads = Enumerable.Range(0, producers).Select(producer => new Thread(() =>
+            {
+                start.SignalAndWait();
+                for (var i = 0; i < eventsPerProducer; ++i)
+                {
+                    if (Enqueue(new Queued {Producer = producer, Sequence = i}))
+                        ++queued[producer];
+                }
+            })).ToList();
+
+            threads.ForEach(t => t.Start());
+            while (threads.Any(t => t.IsAlive))
+            {
+                if (whileProducing != null)
+                    whileProducing();
+                else
+                    Thread.Yield();
+            }
+
+            threads.ForEach(t => t.Join());
+            return queued;
+        }
+
+        /// <summary>
+        /// Check that each producer's events arrived in the order it queued them, without duplicates.
+        /// </summary>
+        private static void AssertProducerOrder(List<Queued> received, int producers)
+        {
+            var last = Enumerable.Repeat(-1, producers).ToArray();
+            foreach (var queued in received)
+            {
+                Assert.True(queued.Sequence > last[queued.Producer],
+                    $"Producer {queued.Producer} event {queued.Sequence} arrived after {last[queued.Producer]}.");
+                last[queued.Producer] = queued.Sequence;
+            }
+        }
+
+        [Fact]
+        public void TestDispatch()
+        {
+            const int traceType = 1001;
+            const int loadType = 1002;
+            const int unknownType = 1003;
+
+            var traces = new List<TraceDone>();
+            var loads = new List<long>();
+
+            NativeEvents.Handler onTrace = (in NativeEvent e) => traces.Add(e.GetPayload<TraceDone>());
+            NativeEvents.Handler onLoad = (in NativeEvent e) => loads.Add(e.GetPayload<long>());
+
+            NativeEvents.Subscribe(traceType, onTrace);
+            NativeEvents.Subscribe(loadType, onLoad);
+
+            try
+            {
+                var unhandled = NativeEvents.Unhandled;
+
+                var events = new[]
+                {
+                    NativeEvent.Create(traceType, new TraceDone {Handle = 1, X = 1, Y = 2, Z = 3}),
+                    NativeEvent.Create(loadType, 42L),
+                    NativeEvent.Create(unknownType, 0),
+                    NativeEvent.Create(traceType, new TraceDone {Handle = 2}),
+                };
+
+                NativeEvents.Dispatch(events);
+
+                Assert.Equal(2, traces.Count);
+                Assert.Equal(1, traces[0].Handle);
+                Assert.Equal(3.0f, traces[0].Z);
+                Assert.Equal(2, traces[1].Handle);
+                Assert.Equal(1, loads.Count);
+                Assert.Equal(42L, loads[0]);
+                Assert.Equal(unhandled + 1, NativeEvents.Unhandled);
+
+                // Payloads are checked against their size.
+                Assert.Throws<InvalidOperationException>(() => events[1].GetPayload<TraceDone>());
+
+                NativeEvents.Unsubscribe(traceType, onTrace);
+                NativeEvents.Dispatch(events);
+
+                Assert.Equal(2, traces.Count);
+                Assert.Equal(2, loads.Count);
+            }
+            finally
+            {
+                NativeEvents.Unsubscribe(traceType, onTrace);
+                NativeEvents.Unsubscribe(loadType, onLoad);
+            }
+        }
+
+        [StandInFact]
+        public void TestQueueFull()
+        {
+            const int producers = 4;
+            const int eventsPerProducer = RingCapacity / 2;
+
+            var received = new List<Queued>();
+            NativeEvents.Handler onQueued = (in NativeEvent e) => received.Add(e.GetPayload<Queued>());
+
+            Drain(out _);
+            NativeEvents.Subscribe(QueuedType, onQueued);
+
+            try
+            {
+                var queued = Produce(producers, eventsPerProducer);
+
+                Assert.Equal(RingCapacity, queued.Sum());
+                Assert.Equal(RingCapacity, Drain(out var dropped));
+                Assert.Equal(producers * eventsPerProducer - RingCapacity, dropped);
+                Assert.Equal(RingCapacity, received.Count);
+
+                // Nothing is freed while the ring is full, so each producer queued a prefix of its events.
+                AssertProducerOrder(received, producers);
+                for (var producer = 0; producer < producers; ++producer)
+                {
+                    var sequences = received.Where(e => e.Producer == producer).Select(e => e.Sequence).ToList();
+                    Assert.Equal(queued[producer], sequences.Count);
+                    Assert.Equal(Enumerable.Range(0, queued[producer]), sequences);
+                }
+
+                Assert.Equal(RingCapacity,
+                    ((delegate* unmanaged<int>) StandInRuntime.GetFunction("StandIn_GetEventQueueHighWater"))());
+
+                // The ring is usable again once drained.
+                Assert.True(Enqueue(new Queued {Producer = 0, Sequence = eventsPerProducer}));
+                Assert.Equal(1, Drain(out dropped));
+                Assert.Equal(0, dropped);
+            }
+            finally
+            {
+                NativeEvents.Unsubscribe(QueuedType, onQueued);
+            }
+        }
+
+        [StandInFact]
+        public void TestDrainWhileProducing()
+        {
+            const int producers = 8;
+            const int eventsPerProducer = RingCapacity;
+
+            var received = new List<Queued>();
+            NativeEvents.Handler onQueued = (in NativeEvent e) => received.Add(e.GetPayload<Queued>());
+
+            Drain(out _);
+            NativeEvents.Subscribe(QueuedType, onQueued);
+
+            try
+            {
+                var drained = 0;
+                var dropped = 0;
+
+                var queued = Produce(producers, eventsPerProducer, () =>
+                {
+                    drained += Drain(out var frameDropped);
+                    dropped += frameDropped;
+                });
+
+                drained += Drain(out var lastDropped);
+                dropped += lastDropped;
+
+                Assert.Equal(producers * eventsPerProducer, drained + dropped);
+                Assert.Equal(queued.Sum(), drained);
+                Assert.Equal(drained, received.Count);
+
+                AssertProducerOrder(received, producers);
+                for (var producer = 0; producer < producers; ++producer)
+                    Assert.Equal(queued[producer], received.Count(e => e.Producer == producer));
+            }
+            finally
+            {
+                NativeEvents.Unsubscribe(QueuedType, onQueued);
+            }
+        }
+
+        [Fact]
+        public void TestLayout()
+        {
+            Assert.Equal(64, sizeof(NativeEvent));
+            Assert.Equal(8, (int) Marshal.OffsetOf<NativeEvent>("m_payload"));
+        }
+    }
+}
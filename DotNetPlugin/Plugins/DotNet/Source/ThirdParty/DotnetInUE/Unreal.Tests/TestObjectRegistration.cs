@@ -0,0 +1,132 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Diagnostics;
+using System.Threading;
+using System.Threading.Tasks;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    public class TestObjectRegistration
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestObjectRegistration(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        /// <summary>
+        /// Stand in for a native object wrapper, there is no native object behind the pointers used here.
+        /// </summary>
+        private class FakeObject : UObjectBase
+        {
+            public static int Constructed;
+
+            public FakeObject(IntPtr nativeInstance)
+                : base(nativeInstance)
+            {
+                Interlocked.Increment(ref Constructed);
+            }
+
+            public void Release() => Unregister();
+        }
+
+        // Each test uses it's own range of fake addresses since the registry is shared.
+        private static IntPtr GetFakeAddress(int range, int index) => new((range << 20) + index * 16);
+
+        private static FakeObject Resolve(IntPtr handle)
+        {
+            return NativeUObjectRegistration.GetUObject<FakeObject>(handle)
+                   ?? NativeUObjectRegistration.GetOrCreate(handle, x => new FakeObject(x));
+        }
+
+        [Fact]
+        public void TestDuplicateBindThrows()
+        {
+            var handle = GetFakeAddress(1, 0);
+            var first = new FakeObject(handle);
+
+#pragma warning disable 618
+            Assert.Throws<ExecutionEngineException>(() => new FakeObject(handle));
+#pragma warning restore 618
+
+            Assert.Same(first, NativeUObjectRegistration.GetUObject<FakeObject>(handle));
+            first.Release();
+            Assert.Null(NativeUObjectRegistration.GetUObject<FakeObject>(handle));
+        }
+
+        [Fact]
+        public void TestConcurrentCreation()
+        {
+            const int objects = 256;
+            const int rounds = 20;
+            const int range = 2;
+            int threads = Math.Max(4, Environment.ProcessorCount);
+
+            var results = new FakeObject[threads, objects];
+            var constructed = FakeObject.Constructed;
+
+            for (int round = 0; round < rounds; ++round)
+            {
+                using var barrier = new Barrier(threads);
+
+                Parallel.For(0, threads, new ParallelOptions {MaxDegreeOfParallelism = threads}, thread =>
+                {
+                    barrier.SignalAndWait();
+                    for (int i = 0; i < objects; ++i)
+                        results[thread, i] = Resolve(GetFakeAddress(range, i));
+                });
+
+                for (int i = 0; i < objects; ++i)
+                {
+                    var published = NativeUObjectRegistration.GetUObject<FakeObject>(GetFakeAddress(range, i));
+                    Assert.NotNull(published);
+
+                    for (int thread = 0; thread < threads; ++thread)
+                        Assert.Same(published, results[thread, i]);
+
+                    published!.Release();
+                }
+            }
+
+            m_output.WriteLine(
+                $"Constructed {FakeObject.Constructed - constructed} wrappers for {rounds * objects} objects on {threads} threads.");
+        }
+
+        [Fact]
+        public void BenchmarkLookup()
+        {
+            const int objects = 1024;
+            const int iterations = 2000;
+            const int range = 3;
+
+            var sw = Stopwatch.StartNew();
+            for (int i = 0; i < objects; ++i)
+                Resolve(GetFakeAddress(range, i));
+            var create = sw.Elapsed;
+
+            int threads = Environment.ProcessorCount;
+            sw.Restart();
+            Parallel.For(0, threads, _ =>
+            {
+                for (int j = 0; j < iterations; ++j)
+                for (int i = 0; i < objects; ++i)
+                    Resolve(GetFakeAddress(range, i));
+            });
+            var lookup = sw.Elapsed;
+
+            var lookups = (double) threads * iterations * objects;
+            m_output.WriteLine($"Created {objects} wrappers in {create.TotalMilliseconds:F2}ms.");
+            m_output.WriteLine(
+                $"{lookups:N0} lookups on {threads} threads in {lookup.TotalMilliseconds:F2}ms ({lookup.TotalMilliseconds * 1e6 / lookups:F2}ns/lookup).");
+
+            for (int i = 0; i < objects; ++i)
+                NativeUObjectRegistration.GetUObject<FakeObject>(GetFakeAddress(range, i))!.Release();
+        }
+    }
+}
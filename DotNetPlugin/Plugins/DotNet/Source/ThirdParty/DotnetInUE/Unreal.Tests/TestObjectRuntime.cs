@@ -0,0 +1,264 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Diagnostics;
+using System.Threading.Tasks;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    /// <summary>
+    /// Tests of the object runtime against the headless stand-in for the plugin, see <see cref="StandInRuntime"/>.
+    /// </summary>
+    [Collection(StandInCollection.Name)]
+    public class TestObjectRuntime
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestObjectRuntime(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        // Each test registers it's own types since the reflection registry is shared.
+
+        private class BestFitObject : UObjectBase
+        {
+            protected BestFitObject(IntPtr nativeInstance)
+                : base(nativeInstance)
+            { }
+
+            public void Release() => Unregister();
+        }
+
+        private class LifetimeObject : UObjectBase
+        {
+            protected LifetimeObject(IntPtr nativeInstance)
+                : base(nativeInstance)
+            { }
+
+            public void Release() => Unregister();
+        }
+
+        private class HandleObject : UObjectBase
+        {
+            protected HandleObject(IntPtr nativeInstance)
+                : base(nativeInstance)
+            { }
+
+            public void Release() => Unregister();
+        }
+
+        private class ManagedObject : UObjectBase
+        {
+            public ManagedObject(IntPtr nativeInstance)
+                : base(nativeInstance)
+            { }
+
+            public void Release()
+            {
+                ManagedUObjectRegistration.Unregister(this);
+                Unregister();
+            }
+        }
+
+        private class BenchmarkObject : UObjectBase
+        {
+            protected BenchmarkObject(IntPtr nativeInstance)
+                : base(nativeInstance)
+            { }
+
+            public void Release() => Unregister();
+        }
+
+        [StandInFact]
+        public void TestBestFitType()
+        {
+            var baseClass = StandInRuntime.CreateClass("BestFitBase", StandInRuntime.FindClass("Object"));
+            var middleClass = StandInRuntime.CreateClass("BestFitMiddle", baseClass);
+            var leafClass = StandInRuntime.CreateClass("BestFitLeaf", middleClass);
+
+            UObjectReflection.Instance.RegisterType(baseClass, typeof(BestFitObject), TypeImplementation.Native);
+
+            // Objects of unknown classes are wrapped with the closest known parent.
+            var native = StandInRuntime.CreateObject(leafClass);
+            var instance = UObjectBase.GetOrCreateNative<BestFitObject>(native)!;
+
+            Assert.Same(instance, UObjectBase.GetOrCreateNative<BestFitObject>(native));
+            Assert.Equal(leafClass, UObjectUtil.GetUClass(instance));
+            Assert.Equal(leafClass, instance.TypeData.NativeUClass);
+            Assert.Equal(typeof(BestFitObject), instance.TypeData.ManagedType);
+
+            // The result of the search is cached for the class.
+            Assert.Same(instance.TypeData, UObjectReflection.Instance.GetTypeData(leafClass));
+            Assert.Throws<System.Collections.Generic.KeyNotFoundException>(
+                () => UObjectReflection.Instance.GetTypeData(middleClass));
+
+            instance.Release();
+            StandInRuntime.DestroyObject(native);
+        }
+
+        [StandInFact]
+        public void TestObjectLifetime()
+        {
+            var objectClass = StandInRuntime.CreateClass("Lifetime", StandInRuntime.FindClass("Object"));
+            UObjectReflection.Instance.RegisterType(objectClass, typeof(LifetimeObject), TypeImplementation.Native);
+
+            var instance = UObjectUtil.Create<LifetimeObject>(objectClass, TypeImplementation.Native, IntPtr.Zero);
+            var native = UObjectUtil.GetNativeInstance(instance);
+
+            var serialNumber = UObjectUtil.GetSerialNumber(native, out var index);
+            Assert.NotEqual(0, serialNumber);
+            Assert.Equal(serialNumber, UObjectUtil.GetSerialNumber(native, out _));
+            Assert.True(UObjectUtil.IsAlive(native, index, serialNumber));
+
+            instance.Release();
+            StandInRuntime.DestroyObject(native);
+            Assert.False(UObjectUtil.IsAlive(native, index, serialNumber));
+
+            // A new object in the same slot does not pass for the old one, even at the same address.
+            var reused = StandInRuntime.CreateObject(objectClass);
+            var reusedSerialNumber = UObjectUtil.GetSerialNumber(reused, out var reusedIndex);
+
+            Assert.Equal(index, reusedIndex);
+            Assert.NotEqual(serialNumber, reusedSerialNumber);
+            Assert.False(UObjectUtil.IsAlive(reused, index, serialNumber));
+            Assert.True(UObjectUtil.IsAlive(reused, reusedIndex, reusedSerialNumber));
+
+            StandInRuntime.DestroyObject(reused);
+        }
+
+        [StandInFact]
+        public void TestObjectHandle()
+        {
+            var objectClass = StandInRuntime.CreateClass("Handle", StandInRuntime.FindClass("Object"));
+            UObjectReflection.Instance.RegisterType(objectClass, typeof(HandleObject), TypeImplementation.Native);
+
+            var native = StandInRuntime.CreateObject(objectClass);
+            var serialNumbers = StandInRuntime.SerialNumberCount;
+
+            var handle = new ObjectHandle(native);
+            Assert.False(handle.IsNull);
+            Assert.True(handle.IsValid);
+
+            // The serial number is allocated once and then read from the object array.
+            var other = new ObjectHandle(native);
+            Assert.Equal(handle, other);
+            Assert.Equal(serialNumbers + 1, StandInRuntime.SerialNumberCount);
+
+            // The wrapper is only created on demand.
+            var instance = handle.Get<HandleObject>()!;
+            Assert.Same(instance, UObjectBase.GetOrCreateNative<HandleObject>(native));
+
+            // Objects pending kill are dead to handles.
+            StandInRuntime.MarkPendingKill(native);
+            Assert.False(handle.IsValid);
+            Assert.Null(handle.Get<HandleObject>());
+
+            instance.Release();
+            StandInRuntime.DestroyObject(native);
+            Assert.False(handle.IsValid);
+
+            // A new object in the same slot does not pass for the old one.
+            var reused = StandInRuntime.CreateObject(objectClass);
+            var reusedHandle = new ObjectHandle(reused);
+            Assert.Equal(handle.Index, reusedHandle.Index);
+            Assert.NotEqual(handle, reusedHandle);
+            Assert.False(handle.IsValid);
+            Assert.True(reusedHandle.IsValid);
+
+            StandInRuntime.DestroyObject(reused);
+
+            var empty = new ObjectHandle(IntPtr.Zero);
+            Assert.True(empty.IsNull);
+            Assert.False(empty.IsValid);
+        }
+
+        [StandInFact]
+        public void TestManagedObjectHandle()
+        {
+            var objectClass = StandInRuntime.CreateClass("Managed", StandInRuntime.FindClass("Object"), true);
+            UObjectReflection.Instance.RegisterType(objectClass, typeof(ManagedObject), TypeImplementation.Managed);
+
+            var instance = StandInRuntime.CreateManagedObject(objectClass, x => new ManagedObject(x));
+            var native = UObjectUtil.GetNativeInstance(instance);
+
+            Assert.Same(instance, UObjectBase.GetManaged<ManagedObject>(native));
+            Assert.Same(instance, ManagedUObjectRegistration.GetUObject<ManagedObject>(native));
+
+            // Releasing frees the handle, the object is then considered dead by the runtime.
+            instance.Release();
+            Assert.Null(ManagedUObjectRegistration.GetUObject<ManagedObject>(native));
+            Assert.Throws<InvalidOperationException>(() => UObjectBase.GetManaged<ManagedObject>(native));
+
+            StandInRuntime.DestroyObject(native);
+
+            // Objects of native classes are not managed objects.
+            var nativeObject = StandInRuntime.CreateObject(StandInRuntime.FindClass("StandInObject"));
+            Assert.Throws<InvalidCastException>(() => ManagedUObjectRegistration.GetUObject<ManagedObject>(nativeObject));
+            StandInRuntime.DestroyObject(nativeObject);
+        }
+
+        [StandInFact]
+        public void BenchmarkObjects()
+        {
+            const int objects = 1000000;
+
+            var objectClass = StandInRuntime.CreateClass("Benchmark", StandInRuntime.FindClass("Object"));
+            UObjectReflection.Instance.RegisterType(objectClass, typeof(BenchmarkObject), TypeImplementation.Native);
+
+            var natives = new IntPtr[objects];
+            var wrappers = new BenchmarkObject[objects];
+            var baseCount = StandInRuntime.ObjectCount;
+
+            var watch = Stopwatch.StartNew();
+            for (int i = 0; i < objects; ++i)
+                natives[i] = StandInRuntime.CreateObject(objectClass);
+            var create = watch.Elapsed;
+
+            Assert.Equal(baseCount + objects, StandInRuntime.ObjectCount);
+
+            // Wrap from all threads at once, each object is wrapped by two threads.
+            watch.Restart();
+            Parallel.For(0, objects * 2, i =>
+            {
+                var index = i % objects;
+                var wrapper = UObjectBase.GetOrCreateNative<BenchmarkObject>(natives[index])!;
+                if (i < objects)
+                    wrappers[index] = wrapper;
+            });
+            var wrap = watch.Elapsed;
+
+            watch.Restart();
+            Parallel.For(0, objects, i =>
+            {
+                var serialNumber = UObjectUtil.GetSerialNumber(natives[i], out var index);
+                if (!UObjectUtil.IsAlive(natives[i], index, serialNumber))
+                    throw new InvalidOperationException("Live object was reported dead.");
+            });
+            var alive = watch.Elapsed;
+
+            watch.Restart();
+            for (int i = 0; i < objects; ++i)
+            {
+                Assert.Same(wrappers[i], UObjectBase.GetOrCreateNative<BenchmarkObject>(natives[i]));
+                wrappers[i].Release();
+                StandInRuntime.DestroyObject(natives[i]);
+            }
+
+            var destroy = watch.Elapsed;
+
+            Assert.Equal(baseCount, StandInRuntime.ObjectCount);
+
+            m_output.WriteLine($"{objects:N0} objects:");
+            m_output.WriteLine($"Created native objects in {create.TotalMilliseconds:F2}ms.");
+            m_output.WriteLine(
+                $"Wrapped on {Environment.ProcessorCount} threads in {wrap.TotalMilliseconds:F2}ms ({wrap.TotalMilliseconds * 1e6 / (objects * 2):F2}ns/lookup).");
+            m_output.WriteLine($"Checked liveness in {alive.TotalMilliseconds:F2}ms.");
+            m_output.WriteLine($"Released and destroyed in {destroy.TotalMilliseconds:F2}ms.");
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    [Collection(StandInCollection.Name)]
+    public class TestScheduling
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestScheduling(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        private static async Task<int> AwaitOnThreadPool(int value)
+        {
+            await Task.Run(() => Thread.Sleep(1));
+            return value + Environment.CurrentManagedThreadId;
+        }
+
+        [Fact]
+        public void TestContinuationsOnGameThread()
+        {
+            var context = new GameThreadSynchronizationContext();
+            var previous = SynchronizationContext.Current;
+
+            Task<int> task;
+            SynchronizationContext.SetSynchronizationContext(context);
+            try
+            {
+                task = AwaitOnThreadPool(0);
+            }
+            finally
+            {
+                SynchronizationContext.SetSynchronizationContext(previous);
+            }
+
+            // The continuation waits for the pump, no matter how long the awaited work is done.
+            while (context.QueueLength == 0)
+                Thread.Sleep(1);
+            Assert.False(task.IsCompleted);
+
+            var stats = context.Pump(TimeSpan.FromSeconds(1));
+            Assert.Equal(1, stats.Executed);
+            Assert.Equal(0, stats.Remaining);
+
+            Assert.True(task.IsCompleted);
+            Assert.Equal(Environment.CurrentManagedThreadId, task.Result);
+        }
+
+        [Fact]
+        public void TestPumpBudget()
+        {
+            var context = new GameThreadSynchronizationContext();
+
+            int executed = 0;
+            for (int i = 0; i < 100; ++i)
+            {
+                context.Post(_ =>
+                {
+                    Thread.Sleep(1);
+                    ++executed;
+                }, null);
+            }
+
+            // Callbacks that do not fit in the budget wait for the next pump.
+            var stats = context.Pump(TimeSpan.FromMilliseconds(10));
+            m_output.WriteLine($"Ran {stats.Executed} callbacks in the budget.");
+
+            Assert.InRange(stats.Executed, 1, 99);
+            Assert.Equal(100 - stats.Executed, stats.Remaining);
+
+            // At least one callback is always run, so the queue drains with any budget.
+            var total = stats.Executed;
+            while (total < 100)
+                total += context.Pump(TimeSpan.Zero).Executed;
+
+            Assert.Equal(100, executed);
+            Assert.Equal(0, context.QueueLength);
+
+            // Other threads can't pump the context.
+            Assert.Throws<AggregateException>(() => Task.Run(() => context.Pump(TimeSpan.Zero)).Wait());
+        }
+
+        [StandInFact]
+        public unsafe void TestTaskGraphScheduler()
+        {
+            var isWorkerThread = (delegate* unmanaged<byte>) StandInRuntime.GetFunction("StandIn_IsWorkerThread");
+
+            var tasks = Enumerable.Range(0, 1000)
+                .Select(i => TaskGraphScheduler.Factory.StartNew(() => isWorkerThread() != 0 ? i : -1))
+                .ToArray();
+
+            Assert.True(Task.WaitAll(tasks, TimeSpan.FromSeconds(30)));
+            Assert.True(tasks.Select(x => x.Result).SequenceEqual(Enumerable.Range(0, 1000)));
+            Assert.Equal(0, TaskGraphScheduler.Instance.PendingCount);
+
+            // Continuations can be scheduled on the task graph too.
+            var continuation = Task.FromResult(1)
+                .ContinueWith(x => isWorkerThread() != 0 ? x.Result + 1 : -1, TaskGraphScheduler.Instance);
+            Assert.Equal(2, continuation.Result);
+        }
+    }
+}
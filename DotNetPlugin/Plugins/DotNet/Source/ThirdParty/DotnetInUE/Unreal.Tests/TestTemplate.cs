@@ -1,13 +1,25 @@
 // Copyright (c) 2021 Keen Software House
 // Licensed under the MIT license.
 
+using System.Diagnostics;
+using System.Linq;
+using System.Reflection;
+using System.Text.RegularExpressions;
 using Unreal.Generation;
 using Xunit;
+using Xunit.Abstractions;
 
 namespace Unreal.Tests
 {
     public class TestTemplate
     {
+        private readonly ITestOutputHelper m_output;
+
+        public TestTemplate(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
         class Model
         {
             #pragma warning disable 414
@@ -19,6 +31,13 @@ namespace Unreal.Tests
             #pragma warning restore 414
         }
 
+        class MethodModel
+        {
+            public static string Static => "Static";
+
+            public string Method() => "Method";
+        }
+
         [Fact]
         public void TestReplacement()
         {
@@ -30,5 +49,85 @@ namespace Unreal.Tests
 
             Assert.Equal(expected, result);
         }
+
+        [Fact]
+        public void TestMultipleModels()
+        {
+            string template = "{Hi} {Static} {Method} {Unknown} { Hi } {{FortyTwo}}\n{\n}";
+
+            var result = TemplateWriter.WriteTemplate(template, new { Hi = "First" }, new Model(), new MethodModel());
+
+            // The first model with a member wins, anything else is left as is.
+            var expected = "First Static Method {Unknown} { Hi } {42}\n{\n}";
+
+            Assert.Equal(expected, result);
+        }
+
+        // Same template shape as the JIT entry points.
+        private const string EntryPointTemplate = @"#if defined(BUILD_JIT)
+typedef {FuncTypeDeclaration};
+
+static {Return} {FirstCall} ({Arguments});
+
+static {FuncType} {FuncStorage} = {FirstCall};
+
+static {Return} {FirstCall} ({Arguments})
+{
+    {FuncStorage} = ({FuncType})FDotNetModule::Get()->GetManagedEntryPoint(""{ModuleName}"", ""{EnclosingTypeFullName}"", ""{EntryPointName}"");
+    {ReturnIfNeeded}{FuncStorage}({ArgumentsTransfer});
+}
+#endif";
+
+        /// <summary>
+        /// The way templates used to be written, a regex of all member names and reflection to read the values.
+        /// </summary>
+        private static string WriteWithRegex(string template, object model)
+        {
+            var flags = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic;
+            var properties = model.GetType().GetProperties(flags);
+
+            var regex = new Regex(string.Join("|", properties.Select(x => @$"\{{{x.Name}\}}")));
+            return regex.Replace(template, match =>
+                properties.First(x => match.Value == $"{{{x.Name}}}").GetValue(model)?.ToString() ?? "");
+        }
+
+        [Fact]
+        public void BenchmarkWriteTemplate()
+        {
+            const int count = 20000;
+
+            object CreateModel(int i) => new
+            {
+                FuncTypeDeclaration = $"void (*func_type_{i})(void*, int32)",
+                Return = "void",
+                FirstCall = $"FirstCall{i}",
+                Arguments = "void* self, int32 value",
+                FuncType = $"func_type_{i}",
+                FuncStorage = $"func_storage_{i}",
+                ReturnIfNeeded = "",
+                ArgumentsTransfer = "self, value",
+                ModuleName = "Module",
+                EnclosingTypeFullName = "Unreal.Module.UType",
+                EntryPointName = $"EntryPoint{i}"
+            };
+
+            var models = Enumerable.Range(0, count).Select(CreateModel).ToArray();
+
+            Assert.Equal(WriteWithRegex(EntryPointTemplate, models[0]),
+                TemplateWriter.WriteTemplate(EntryPointTemplate, models[0]));
+
+            var watch = Stopwatch.StartNew();
+            foreach (var model in models)
+                WriteWithRegex(EntryPointTemplate, model);
+            var regexTime = watch.Elapsed;
+
+            watch.Restart();
+            foreach (var model in models)
+                TemplateWriter.WriteTemplate(EntryPointTemplate, model);
+            var compiledTime = watch.Elapsed;
+
+            m_output.WriteLine($"Wrote {count} entry points in {regexTime.TotalMilliseconds:F2}ms with a regex and "
+                               + $"{compiledTime.TotalMilliseconds:F2}ms with a compiled template.");
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading.Tasks;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    public class TestTickManager
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestTickManager(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        private class Tickable : IManagedTickable
+        {
+            public int Ticks;
+            public float Time;
+            public Action? OnTick;
+
+            public void Tick(float deltaTime)
+            {
+                ++Ticks;
+                Time += deltaTime;
+                OnTick?.Invoke();
+            }
+        }
+
+        [Fact]
+        public void TestRegistration()
+        {
+            var a = new Tickable();
+            var b = new Tickable();
+            var c = new Tickable();
+
+            TickManager.Register(a);
+            TickManager.Register(b);
+            TickManager.Register(c, TickGroup.PostPhysics);
+
+            // Nothing changes until the next frame.
+            TickManager.Dispatch(TickGroup.PrePhysics, 1);
+            Assert.Equal(0, a.Ticks);
+
+            var mask = TickManager.BeginFrame();
+            Assert.Equal((1u << (int) TickGroup.PrePhysics) | (1u << (int) TickGroup.PostPhysics), mask);
+
+            TickManager.Dispatch(TickGroup.PrePhysics, 0.5f);
+            Assert.Equal(1, a.Ticks);
+            Assert.Equal(1, b.Ticks);
+            Assert.Equal(0, c.Ticks);
+            Assert.Equal(0.5f, a.Time);
+
+            // Unregistering while ticking only applies next frame, the other objects keep ticking.
+            a.OnTick = () => TickManager.Unregister(a);
+            TickManager.Dispatch(TickGroup.PrePhysics, 0.5f);
+            Assert.Equal(2, a.Ticks);
+
+            TickManager.BeginFrame();
+            TickManager.Dispatch(TickGroup.PrePhysics, 0.5f);
+            Assert.Equal(2, a.Ticks);
+            Assert.Equal(3, b.Ticks);
+
+            // Registering again moves an object between groups.
+            TickManager.Register(b, TickGroup.PostPhysics);
+            Assert.Equal(0u, TickManager.BeginFrame() & (1u << (int) TickGroup.PrePhysics));
+            TickManager.Dispatch(TickGroup.PostPhysics, 1);
+            Assert.Equal(4, b.Ticks);
+            Assert.Equal(1, c.Ticks);
+
+            // Exceptions are reported and do not stop the dispatch.
+            var failures = new List<(IManagedTickable, Exception)>();
+            var handler = TickManager.ExceptionHandler;
+            TickManager.ExceptionHandler = (tickable, ex) => failures.Add((tickable, ex));
+            try
+            {
+                b.OnTick = () => throw new InvalidOperationException();
+                TickManager.Dispatch(TickGroup.PostPhysics, 1);
+            }
+            finally
+            {
+                TickManager.ExceptionHandler = handler;
+            }
+
+            Assert.Equal(2, c.Ticks);
+            Assert.Equal(1, failures.Count);
+            Assert.Same(b, failures[0].Item1);
+            Assert.True(failures[0].Item2 is InvalidOperationException);
+
+            TickManager.Unregister(b);
+            TickManager.Unregister(c);
+            Assert.Equal(0u, TickManager.BeginFrame());
+        }
+
+        [Fact]
+        public void BenchmarkDispatch()
+        {
+            const int objects = 10000;
+            const int frames = 100;
+
+            var tickables = Enumerable.Range(0, objects).Select(_ => new Tickable()).ToArray();
+
+            // Register from all threads at once.
+            Parallel.ForEach(tickables, x => TickManager.Register(x, TickGroup.DuringPhysics));
+            TickManager.BeginFrame();
+            Assert.Equal(objects, TickManager.GetCount(TickGroup.DuringPhysics));
+
+            var watch = Stopwatch.StartNew();
+            for (int i = 0; i < frames; ++i)
+                TickManager.Dispatch(TickGroup.DuringPhysics, 1 / 60.0f);
+            var time = watch.Elapsed;
+
+            Assert.True(tickables.All(x => x.Ticks == frames));
+
+            // Removing every other object keeps the rest ticking.
+            var removed = new HashSet<Tickable>(tickables.Where((_, i) => i % 2 == 0));
+            foreach (var tickable in removed)
+                TickManager.Unregister(tickable);
+
+            TickManager.BeginFrame();
+            TickManager.Dispatch(TickGroup.DuringPhysics, 1 / 60.0f);
+
+            Assert.Equal(objects / 2, TickManager.GetCount(TickGroup.DuringPhysics));
+            Assert.True(tickables.All(x => x.Ticks == (removed.Contains(x) ? frames : frames + 1)));
+
+            foreach (var tickable in tickables)
+                TickManager.Unregister(tickable);
+            TickManager.BeginFrame();
+
+            m_output.WriteLine(
+                $"Ticked {objects:N0} objects in {time.TotalMilliseconds / frames:F3}ms per frame ({time.TotalMilliseconds * 1e6 / (frames * objects):F2}ns/object).");
+        }
+    }
+}
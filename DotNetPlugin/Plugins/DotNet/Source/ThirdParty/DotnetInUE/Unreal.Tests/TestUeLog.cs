@@ -0,0 +1,137 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+using System;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using Unreal.Core;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Unreal.Tests
+{
+    /// <summary>
+    /// Tests of <see cref="UeLog"/> against the stand-in log sink.
+    /// </summary>
+    /// <remarks>
+    /// Asserts on the logs and batches the stand-in received, so it runs in the stand-in collection where nothing else
+    /// logs at the same time.
+    /// </remarks>
+    [Collection(StandInCollection.Name)]
+    public unsafe class TestUeLog
+    {
+        private readonly ITestOutputHelper m_output;
+
+        public TestUeLog(ITestOutputHelper output)
+        {
+            m_output = output;
+        }
+
+        private static void SetVerbosity(LogVerbosity verbosity)
+        {
+            ((delegate* unmanaged<byte, void>) StandInRuntime.GetFunction("StandIn_SetLogVerbosity"))((byte) verbosity);
+        }
+
+        private static int BatchCount => ((delegate* unmanaged<int>) StandInRuntime.GetFunction("StandIn_GetLogBatchCount"))();
+
+        private static int LogCount => ((delegate* unmanaged<int>) StandInRuntime.GetFunction("StandIn_GetLogCount"))();
+
+        private static (LogVerbosity Verbosity, string Message) GetLog(int index)
+        {
+            byte verbosity;
+            var message = ((delegate* unmanaged<int, byte*, char*>) StandInRuntime.GetFunction("StandIn_GetLog"))(
+                index, &verbosity);
+            return ((LogVerbosity) verbosity, new string(message));
+        }
+
+        [StandInFact]
+        public void TestFormatAndBatch()
+        {
+            var culture = CultureInfo.CurrentCulture;
+            CultureInfo.CurrentCulture = CultureInfo.InvariantCulture;
+            SetVerbosity(LogVerbosity.Log);
+
+            try
+            {
+                UeLog.Flush();
+                var batches = BatchCount;
+                var start = LogCount;
+
+                UeLog.Log(LogVerbosity.Display, "{0,4}|{1:F2}|{2,-4}|{{{3}}}", 7, 1.234, "ab", 'x');
+                UeLog.Log(LogVerbosity.Log, "{0} and {1}", true, new Version(1, 2));
+                UeLog.Log(LogVerbosity.Verbose, "Filtered {0}", 1);
+
+                var message = UeLog.Begin(LogVerbosity.Warning);
+                message.AppendLiteral("Built ");
+                message.AppendFormatted(42L, "X");
+                message.Submit();
+
+                // Messages wait for the next flush.
+                Assert.Equal(batches, BatchCount);
+                Assert.Equal(start, LogCount);
+
+                UeLog.Flush();
+                Assert.Equal(batches + 1, BatchCount);
+                Assert.Equal(start + 3, LogCount);
+
+                Assert.Equal((LogVerbosity.Display, "   7|1.23|ab  |{x}"), GetLog(start));
+                Assert.Equal((LogVerbosity.Log, "True and 1.2"), GetLog(start + 1));
+                Assert.Equal((LogVerbosity.Warning, "Built 2A"), GetLog(start + 2));
+
+                // Errors are submitted right away.
+                UeLog.Log(LogVerbosity.Error, "Failed {0}", 3);
+                Assert.Equal(batches + 2, BatchCount);
+                Assert.Equal((LogVerbosity.Error, "Failed 3"), GetLog(start + 3));
+
+                // The verbosity of the category is followed without any call.
+                SetVerbosity(LogVerbosity.Verbose);
+                Assert.True(UeLog.IsEnabled(LogVerbosity.Verbose));
+                SetVerbosity(LogVerbosity.Log);
+                Assert.False(UeLog.IsEnabled(LogVerbosity.Verbose));
+
+                // Fatal messages get through even when the category is silenced.
+                SetVerbosity(LogVerbosity.NoLogging);
+                Assert.False(UeLog.IsEnabled(LogVerbosity.Error));
+                UeLog.Log(LogVerbosity.Error, "Silenced");
+                UeLog.Log(LogVerbosity.Fatal, "Fatal {0}", 4);
+                Assert.Equal((LogVerbosity.Fatal, "Fatal 4"), GetLog(start + 4));
+                Assert.Equal(start + 5, LogCount);
+                SetVerbosity(LogVerbosity.Log);
+
+                Assert.Throws<FormatException>(() => UeLog.Log(LogVerbosity.Log, "{1}", 0));
+            }
+            finally
+            {
+                CultureInfo.CurrentCulture = culture;
+                UeLog.Flush();
+            }
+        }
+
+        [StandInFact]
+        public void TestNoAllocation()
+        {
+            SetVerbosity(LogVerbosity.Log);
+
+            static void LogLoop(int count)
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    UeLog.Log(LogVerbosity.Verbose, "Filtered {0} {1}", i, 0.5f);
+                    UeLog.Log(LogVerbosity.Log, "Frame {0}: {1:F1}ms", i, 16.6);
+                }
+            }
+
+            // Warm up, so the pools and the code are ready.
+            LogLoop(1000);
+
+            var allocated = GC.GetAllocatedBytesForCurrentThread();
+            LogLoop(10000);
+            allocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+            UeLog.Flush();
+
+            m_output.WriteLine($"Allocated {allocated} bytes for 20,000 log statements.");
+            Assert.Equal(0, allocated);
+        }
+    }
+}
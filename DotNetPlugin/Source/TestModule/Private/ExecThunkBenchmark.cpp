@@ -0,0 +1,80 @@
+// Copyright (c) 2021 Keen Software House
+// Licensed under the MIT license.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "TestNativeClass.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDotNetExecThunkBenchmark, "DotNet.Benchmark.ExecThunk",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace
+{
+	constexpr int32 Iterations = 1000000;
+
+	/** Parameter frame of Add(int32, int32) -> int32, the same for the native and the managed function. */
+	struct FAddParms
+	{
+		int32 Lhs;
+		int32 Rhs;
+		int32 ReturnValue;
+	};
+
+	/**
+	 * Call a function through the VM the way a Blueprint loop does, feeding each result into the next call so the
+	 * calls can't be skipped.
+	 * @return Time per call in nanoseconds.
+	 */
+	double TimeVMCalls(UObject* Object, UFunction* Function, int32& OutResult)
+	{
+		FAddParms Parms{0, 1, 0};
+
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Parms.Lhs = Parms.ReturnValue;
+			Object->ProcessEvent(Function, &Parms);
+		}
+
+		OutResult = Parms.ReturnValue;
+		return (FPlatformTime::Seconds() - Start) * 1e9 / Iterations;
+	}
+}
+
+bool FDotNetExecThunkBenchmark::RunTest(const FString& Parameters)
+{
+	UClass* NativeClass = UTestNativeClass::StaticClass();
+	UFunction* NativeAdd = NativeClass->FindFunctionByName(TEXT("AddNumbers"));
+
+	// The managed class is generated into another module, look it up by name.
+	UClass* ManagedClass = FindObject<UClass>(ANY_PACKAGE, TEXT("TestClass"));
+	UFunction* ManagedAdd = ManagedClass ? ManagedClass->FindFunctionByName(TEXT("Add")) : nullptr;
+
+	if (!ManagedAdd)
+	{
+		AddError(TEXT("UTestClass::Add was not found, is the managed test assembly loaded?"));
+		return false;
+	}
+
+	int32 DirectResult = 0;
+	const double DirectStart = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Iterations; ++i)
+		DirectResult = UTestNativeClass::AddNumbers(DirectResult, 1);
+	const double DirectTime = (FPlatformTime::Seconds() - DirectStart) * 1e9 / Iterations;
+
+	int32 NativeResult = 0, ManagedResult = 0;
+	const double NativeTime = TimeVMCalls(NativeClass->GetDefaultObject(), NativeAdd, NativeResult);
+	const double ManagedTime = TimeVMCalls(ManagedClass->GetDefaultObject(), ManagedAdd, ManagedResult);
+
+	TestEqual(TEXT("Native result"), NativeResult, Iterations);
+	TestEqual(TEXT("Managed result"), ManagedResult, Iterations);
+
+	AddInfo(FString::Printf(TEXT("Add x %d: direct C++ %.2fns, Blueprint -> C++ %.2fns, Blueprint -> managed %.2fns"),
+	                        Iterations, DirectTime, NativeTime, ManagedTime));
+
+	return true;
+}
+
+#endif